@@ -2,12 +2,15 @@
 
 #include <cmath>
 #include <filesystem>
+#include <limits>
 #include <spdlog/spdlog.h>
 
 #include <GoProTelem/GoProTelem.h>
 #include <GoProTelem/SampleMath.h>
 #include <GoProOverlay/utils/DataProcessingUtils.h>
+#include <GoProOverlay/utils/io/cache.h>
 #include <GoProOverlay/utils/io/csv.h>
+#include <GoProOverlay/utils/io/gpot.h>
 
 namespace gpo
 {
@@ -15,17 +18,27 @@ namespace gpo
 	 : seeker(nullptr)
 	 , telemSrc(nullptr)
 	 , videoSrc(nullptr)
-	 , vCapture_()
-	 , samples_(nullptr)
-	 , backupSamples_()
+	 , decoderPool_(nullptr)
+	 , columns_(nullptr)
+	 , backupColumns_()
 	 , dataAvail_()
 	 , sourceName_("")
 	 , originFile_("")
 	 , datumTrack_(nullptr)
+	 , trackTimesCache_()
+	 , telemMemoryLimit_(DEFAULT_TELEMETRY_MEMORY_LIMIT)
+	 , streamThread_()
+	 , streamStop_(false)
+	 , streaming_(false)
 	{
 		dataAvail_.reset();
 	}
 
+	DataSource::~DataSource()
+	{
+		stopStreamingTelemetry();
+	}
+
 	std::string
 	DataSource::getSourceName() const
 	{
@@ -44,6 +57,7 @@ namespace gpo
 		bool processNow)
 	{
 		datumTrack_ = track;
+		trackTimesCache_.clear();
 		if (processNow)
 		{
 			return reprocessDatumTrack();
@@ -61,36 +75,18 @@ namespace gpo
 	DataSource::calcVehicleAcceleration(
 		size_t smoothingWindowSize)
 	{
-		if (samples_->empty())
+		if (columns_->empty())
 		{
 			// nothing to process
 			return true;
 		}
 
-		// smooth accelerometer data
-		const std::array<size_t, 3> inFieldOffsets = {
-			offsetof(gpo::TelemetrySample, gpSamp.accl.x),
-			offsetof(gpo::TelemetrySample, gpSamp.accl.y),
-			offsetof(gpo::TelemetrySample, gpSamp.accl.z)
-		};
-		const std::array<size_t, 3> outFieldOffsets = {
-			offsetof(gpo::TelemetrySample, calcSamp.smoothAccl.x),
-			offsetof(gpo::TelemetrySample, calcSamp.smoothAccl.y),
-			offsetof(gpo::TelemetrySample, calcSamp.smoothAccl.z)
-		};
-		utils::smoothMovingAvgStructured<gpo::TelemetrySample,decltype(gpt::AcclSample::x)>(
-			samples_->data(),
-			samples_->data(),
-			inFieldOffsets,
-			outFieldOffsets,
-			samples_->size(),
-			smoothingWindowSize);
-		dataAvail_.set(DataAvailable::eDA_CALC_SMOOTH_ACCL);
-
+		// smoothing and the vehicle frame projection run fused, directly
+		// on the columns
 		cv::Vec3f latDir = {};
 		cv::Vec3f lonDir = {};
-		bool okay = utils::computeVehicleDirectionVectors(samples_,dataAvail_,latDir,lonDir);
-		okay = okay && utils::computeVehicleAcceleration(samples_,dataAvail_,latDir,lonDir);
+		bool okay = utils::computeVehicleDirectionVectors(*columns_,dataAvail_,latDir,lonDir);
+		okay = okay && utils::computeVehicleAcceleration(*columns_,dataAvail_,latDir,lonDir,smoothingWindowSize);
 
 		return okay;
 	}
@@ -98,13 +94,14 @@ namespace gpo
 	bool
 	DataSource::reprocessDatumTrack()
 	{
-		if (datumTrack_ == nullptr || samples_->empty())
+		if (datumTrack_ == nullptr || columns_->empty())
 		{
 			// nothing to process
 			return true;
 		}
 
-		bool okay = utils::computeTrackTimes(datumTrack_,samples_,dataAvail_);
+		// only redoes the samples affected by track edits since the last call
+		bool okay = utils::computeTrackTimes(datumTrack_,*columns_,dataAvail_,trackTimesCache_);
 
 		if (okay)
 		{
@@ -141,16 +138,18 @@ namespace gpo
 	double
 	DataSource::getTelemetryRate_hz() const
 	{
-		if ( ! hasTelemetry() || samples_->size() < 2)
+		if ( ! hasTelemetry() || columns_->size() < 2)
 		{
 			return 0.0;
 		}
-		return (samples_->size() - 1) / samples_->back().t_offset;
+		const auto tOffsets = columns_->channel<double>(eTC_T_OFFSET);
+		return (tOffsets.size() - 1) / tOffsets[tOffsets.size() - 1];
 	}
 
 	void
 	DataSource::resampleTelemetry(
-		double newRate_hz)
+		double newRate_hz,
+		const utils::ResamplerConfig &config)
 	{
 		if ( ! hasTelemetry())
 		{
@@ -162,56 +161,64 @@ namespace gpo
 			spdlog::error("can't resample DataSource that has a video associated with it.");
 			return;
 		}
-		else if (samples_->empty())
+		else if (columns_->empty())
 		{
 			// no samples means nothing resample!
 			return;
 		}
 
-		// copy old samples
-		TelemetrySamples oldSamps = *samples_;
+		// resample into fresh columns so that chunks shared with any
+		// duplicates/backups are left alone
+		TelemetryColumns resampled;
+		utils::resample(resampled,*columns_,dataAvail_,newRate_hz,config);
+		*columns_ = std::move(resampled);
+		trackTimesCache_.clear();
+	}
 
-		double duration_sec = oldSamps.back().t_offset;
-		size_t nSampsOut = round(newRate_hz * duration_sec);
-		samples_->resize(nSampsOut);
-		double outDt_sec = 1.0 / newRate_hz;
+	void
+	DataSource::setCompactTelemetry(
+		bool compact)
+	{
+		if (columns_ == nullptr)
+		{
+			return;
+		}
 
-		size_t takeIdx = 0;
-		double outTime_sec = 0.0;
-		for (size_t outIdx=0; outIdx<nSampsOut; outIdx++)
+		const double duration_hr = (columns_->empty() ? 0.0 :
+			columns_->channel<double>(eTC_T_OFFSET)[columns_->size() - 1] / 3600.0);
+		const size_t bytesBefore = columns_->size_bytes();
+		columns_->setCompact(compact, dataAvail_);
+		const size_t bytesAfter = columns_->size_bytes();
+		if (duration_hr > 0.0)
 		{
-			if (gpt::findLerpIndex(takeIdx,oldSamps,outTime_sec))
-			{
-				const auto &sampA = oldSamps.at(takeIdx);
-				const auto &sampB = oldSamps.at(takeIdx+1);
-				const double dt = sampB.t_offset - sampA.t_offset;
-				const double ratio = (outTime_sec - sampA.t_offset) / dt;
-				utils::lerp(samples_->at(outIdx),sampA,sampB,ratio);
-			}
-			else if (takeIdx == 0)
-			{
-				samples_->at(outIdx) = oldSamps.at(takeIdx);
-			}
-			else
-			{
-				samples_->at(outIdx) = oldSamps.back();
-			}
-			outTime_sec += outDt_sec;
+			spdlog::info(
+				"'{}' telemetry {} compact storage. {:.1f}MiB/hr -> {:.1f}MiB/hr",
+				sourceName_,
+				(compact ? "using" : "not using"),
+				bytesBefore / duration_hr / (1024.0 * 1024.0),
+				bytesAfter / duration_hr / (1024.0 * 1024.0));
 		}
 	}
 
+	bool
+	DataSource::isTelemetryCompact() const
+	{
+		return columns_ != nullptr && columns_->isCompact();
+	}
+
 	DataSourcePtr
 	DataSource::duplicate() const
 	{
 		auto dup = std::make_shared<DataSource>();
-		dup->vCapture_ = vCapture_;
-		dup->samples_ = std::make_shared<TelemetrySamples>();
-		*(dup->samples_) = *samples_;
-		dup->backupSamples_ = backupSamples_;
+		dup->decoderPool_ = decoderPool_;
+		dup->columns_ = std::make_shared<TelemetryColumns>(*columns_);
+		dup->backupColumns_ = backupColumns_;
 		dup->dataAvail_ = dataAvail_;
 		dup->sourceName_ = sourceName_;
 		dup->originFile_ = originFile_;
 		dup->datumTrack_ = datumTrack_;
+		dup->trackTimesCache_ = trackTimesCache_;
+		dup->telemMemoryLimit_ = telemMemoryLimit_;
 
 		dup->seeker = std::make_shared<TelemetrySeeker>(dup);
 		if (telemSrc)
@@ -220,42 +227,129 @@ namespace gpo
 		}
 		if (videoSrc)
 		{
-			dup->videoSrc = std::make_shared<VideoSource>(dup);
+			dup->videoSrc = std::make_shared<VideoSource>(dup,videoSrc->metadata());
 		}
 		return dup;
 	}		
 	
+	void
+	DataSource::setTelemetryMemoryLimit(
+		size_t maxBytes)
+	{
+		telemMemoryLimit_ = maxBytes;
+		trimTelemetry();
+	}
+
+	size_t
+	DataSource::getTelemetryMemoryLimit() const
+	{
+		return telemMemoryLimit_;
+	}
+
+	void
+	DataSource::trimTelemetry()
+	{
+		if (telemMemoryLimit_ > 0 && columns_)
+		{
+			columns_->trimPaged(telemMemoryLimit_);
+		}
+	}
+
+	void
+	DataSource::streamTelemetryInBackground()
+	{
+		stopStreamingTelemetry();
+		if ( ! columns_)
+		{
+			return;
+		}
+
+		// the thread works off its own references to the chunks, so it
+		// never touches 'columns_' while it's being modified
+		auto chunks = columns_->unloadedChunks();
+		if (chunks.empty())
+		{
+			return;
+		}
+		size_t budget = std::numeric_limits<size_t>::max();
+		if (telemMemoryLimit_ > 0)
+		{
+			const size_t resident = columns_->pagedResidentBytes();
+			budget = (telemMemoryLimit_ > resident ? telemMemoryLimit_ - resident : 0);
+		}
+
+		streamStop_ = false;
+		streaming_ = true;
+		streamThread_ = std::thread([this, chunks = std::move(chunks), budget, name = sourceName_]() mutable {
+			size_t nStreamed = 0;
+			for (auto &chunk : chunks)
+			{
+				if (streamStop_ || chunk->size() > budget)
+				{
+					break;
+				}
+				chunk->prefetch();
+				budget -= chunk->size();
+				nStreamed++;
+				// let go so that writes to the chunk don't have to copy it
+				chunk.reset();
+			}
+			spdlog::debug("streamed {} of {} telemetry chunks for '{}'",
+				nStreamed,
+				chunks.size(),
+				name);
+			streaming_ = false;
+		});
+	}
+
+	void
+	DataSource::stopStreamingTelemetry()
+	{
+		streamStop_ = true;
+		if (streamThread_.joinable())
+		{
+			streamThread_.join();
+		}
+	}
+
+	bool
+	DataSource::isStreamingTelemetry() const
+	{
+		return streaming_;
+	}
+
 	bool
 	DataSource::backupTelemetry()
 	{
-		if (samples_ == nullptr)
+		if (columns_ == nullptr)
 		{
 			return false;
 		}
-		backupSamples_ = *(samples_);
+		backupColumns_ = *columns_;
 		return true;
 	}
 
 	void
 	DataSource::deleteTelemetryBackup()
 	{
-		backupSamples_.clear();
+		backupColumns_.clear();
 	}
 
 	bool
 	DataSource::hasBackup() const
 	{
-		return backupSamples_.size() > 0;
+		return backupColumns_.size() > 0;
 	}
 
 	bool
 	DataSource::restoreTelemetry()
 	{
-		if (samples_ == nullptr)
+		if (columns_ == nullptr)
 		{
 			return false;
 		}
-		*samples_ = backupSamples_;
+		*columns_ = backupColumns_;
+		trackTimesCache_.clear();
 		return true;
 	}
 
@@ -270,6 +364,33 @@ namespace gpo
 		return makeTrackFromTelemetry(telemSrc);
 	}
 
+	void
+	DataSource::storeSamples(
+		const TelemetrySamples &samples)
+	{
+		columns_->setDataAvailable(dataAvail_);
+		columns_->assign(samples);
+		trackTimesCache_.clear();
+	}
+
+	void
+	DataSource::pageTelemetryAround(
+		size_t idx)
+	{
+		if (telemMemoryLimit_ == 0 || ! columns_)
+		{
+			return;
+		}
+
+		// load the seeked chunk first so that it's the most recently used.
+		// what's resident only grows when something had to be loaded, so
+		// there's nothing to trim otherwise.
+		if (columns_->prefetch(idx, idx + 1) > 0)
+		{
+			trimTelemetry();
+		}
+	}
+
 	DataSourcePtr
 	DataSource::loadDataFromFile(
 		const std::filesystem::path &sourceFile)
@@ -300,6 +421,11 @@ namespace gpo
 		{
 			dSrc = gpo::DataSource::loadTelemetryFromCSV(sourceFile);
 		}
+		else if (fileExt == utils::io::GPOT_FILE_EXTENSION ||
+			fileExt == utils::io::GPOZ_FILE_EXTENSION)
+		{
+			dSrc = gpo::DataSource::loadTelemetryFromBinary(sourceFile);
+		}
 		else
 		{
 			spdlog::warn("{} - unsupported source file extension '{}'",
@@ -312,8 +438,31 @@ namespace gpo
 
 	DataSourcePtr
 	DataSource::loadDataFromVideo(
-		const std::filesystem::path &videoFile)
+		const std::filesystem::path &videoFile,
+		bool useCache)
 	{
+		if (useCache)
+		{
+			auto newSrc = std::make_shared<DataSource>();
+			newSrc->columns_ = std::make_shared<TelemetryColumns>();
+			VideoMetadata vMeta;
+			// telemetry is paged in from the cache rather than loaded up front
+			if (utils::io::readCache(videoFile,*newSrc->columns_,newSrc->dataAvail_,&vMeta))
+			{
+				spdlog::debug("loaded '{}' from cache", videoFile.c_str());
+				newSrc->originFile_ = videoFile;
+				newSrc->sourceName_ = videoFile.filename();
+				// decoders get opened lazily on first frame read
+				newSrc->decoderPool_ = VideoDecoderPool::getPool(videoFile);
+
+				newSrc->seeker = std::make_shared<TelemetrySeeker>(newSrc);
+				newSrc->telemSrc = std::make_shared<TelemetrySource>(newSrc);
+				newSrc->videoSrc = std::make_shared<VideoSource>(newSrc,vMeta);
+
+				return newSrc;
+			}
+		}
+
 		gpt::MP4_Source mp4;
 		mp4.open(videoFile);
 		auto videoTelem = gpt::getCombinedTimedSamples(mp4);
@@ -321,25 +470,28 @@ namespace gpo
 		{
 			return nullptr;
 		}
-		cv::VideoCapture vCap(videoFile);
-		if ( ! vCap.isOpened())
+		auto decoderPool = VideoDecoderPool::getPool(videoFile);
+		auto decoder = decoderPool->acquire(0);
+		if ( ! decoder)
 		{
 			return nullptr;
 		}
+		const auto vMeta = VideoSource::probeMetadata(decoder->vCap);
+		decoderPool->release(decoder);
 
 		auto newSrc = std::make_shared<DataSource>();
 		newSrc->originFile_ = videoFile;
 		newSrc->sourceName_ = videoFile.filename();
-		newSrc->vCapture_ = vCap;
-		newSrc->samples_ = std::make_shared<TelemetrySamples>();
-		newSrc->samples_->resize(videoTelem.size());
+		newSrc->decoderPool_ = decoderPool;
+		TelemetrySamples samples(videoTelem.size());
 		for (size_t i=0; i<videoTelem.size(); i++)
 		{
-			auto &outSamp = newSrc->samples_->at(i);
+			auto &outSamp = samples.at(i);
 			const auto &gpSamp = videoTelem.at(i);
 			outSamp.t_offset = gpSamp.t_offset;
 			outSamp.gpSamp = gpSamp.sample;
 		}
+		newSrc->columns_ = std::make_shared<TelemetryColumns>(samples);
 
 		// populate GoPro data availability
 		gpt::MP4_SensorInfo sensorInfo;
@@ -372,7 +524,16 @@ namespace gpo
 
 		newSrc->seeker = std::make_shared<TelemetrySeeker>(newSrc);
 		newSrc->telemSrc = std::make_shared<TelemetrySource>(newSrc);
-		newSrc->videoSrc = std::make_shared<VideoSource>(newSrc);
+		newSrc->videoSrc = std::make_shared<VideoSource>(newSrc,vMeta);
+
+		if (useCache)
+		{
+			utils::io::writeCache(
+				videoFile,
+				*newSrc->columns_,
+				newSrc->dataAvail_,
+				&vMeta);
+		}
 
 		return newSrc;
 	}
@@ -391,17 +552,26 @@ namespace gpo
 		auto newSrc = std::make_shared<DataSource>();
 		newSrc->originFile_ = logFile;
 		newSrc->sourceName_ = logFile.filename();
-		newSrc->samples_ = std::make_shared<TelemetrySamples>();
-		newSrc->samples_->resize(ecuTelem.size());
 		newSrc->dataAvail_ = dataAvail;
 		newSrc->dataAvail_.reset(eDA_ECU_TIME);// don't want to track this here
+		std::vector<double> tOffsets(ecuTelem.size());
+		std::vector<float> engineSpeeds(ecuTelem.size());
+		std::vector<float> tpss(ecuTelem.size());
+		std::vector<float> boosts(ecuTelem.size());
 		for (size_t i=0; i<ecuTelem.size(); i++)
 		{
-			auto &sampOut = newSrc->samples_->at(i);
 			const auto &ecuSamp = ecuTelem.at(i);
-			sampOut.t_offset = ecuSamp.t_offset;
-			sampOut.ecuSamp = ecuSamp.sample;
+			tOffsets[i] = ecuSamp.t_offset;
+			engineSpeeds[i] = ecuSamp.sample.engineSpeed_rpm;
+			tpss[i] = ecuSamp.sample.tps;
+			boosts[i] = ecuSamp.sample.boost_psi;
 		}
+		newSrc->columns_ = std::make_shared<TelemetryColumns>();
+		newSrc->columns_->resize(ecuTelem.size());
+		newSrc->columns_->assignChannel(eTC_T_OFFSET, tOffsets);
+		newSrc->columns_->assignChannel(eTC_ECU_ENGINE_SPEED, engineSpeeds);
+		newSrc->columns_->assignChannel(eTC_ECU_TPS, tpss);
+		newSrc->columns_->assignChannel(eTC_ECU_BOOST, boosts);
 
 		newSrc->seeker = std::make_shared<TelemetrySeeker>(newSrc);
 		newSrc->telemSrc = std::make_shared<TelemetrySource>(newSrc);
@@ -416,11 +586,12 @@ namespace gpo
 		auto newSrc = std::make_shared<DataSource>();
 		newSrc->originFile_ = csvFile;
 		newSrc->sourceName_ = csvFile.filename();
-		newSrc->samples_ = std::make_shared<TelemetrySamples>();
+		auto samples = std::make_shared<TelemetrySamples>();
 		utils::io::readTelemetryFromSoloStormCSV(
 			csvFile,
-			newSrc->samples_,
+			samples,
 			newSrc->dataAvail_);
+		newSrc->columns_ = std::make_shared<TelemetryColumns>(*samples);
 
 		newSrc->seeker = std::make_shared<TelemetrySeeker>(newSrc);
 		newSrc->telemSrc = std::make_shared<TelemetrySource>(newSrc);
@@ -435,11 +606,34 @@ namespace gpo
 		auto newSrc = std::make_shared<DataSource>();
 		newSrc->originFile_ = csvFile;
 		newSrc->sourceName_ = csvFile.filename();
-		newSrc->samples_ = std::make_shared<TelemetrySamples>();
+		auto samples = std::make_shared<TelemetrySamples>();
 		utils::io::readTelemetryFromCSV(
 			csvFile,
-			newSrc->samples_,
+			samples,
 			newSrc->dataAvail_);
+		newSrc->columns_ = std::make_shared<TelemetryColumns>(*samples);
+
+		newSrc->seeker = std::make_shared<TelemetrySeeker>(newSrc);
+		newSrc->telemSrc = std::make_shared<TelemetrySource>(newSrc);
+
+		return newSrc;
+	}
+
+	DataSourcePtr
+	DataSource::loadTelemetryFromBinary(
+		const std::filesystem::path &binFile)
+	{
+		auto newSrc = std::make_shared<DataSource>();
+		newSrc->originFile_ = binFile;
+		newSrc->sourceName_ = binFile.filename();
+		newSrc->columns_ = std::make_shared<TelemetryColumns>();
+		if ( ! utils::io::readTelemetryFromBinary(
+			binFile,
+			*newSrc->columns_,
+			newSrc->dataAvail_))
+		{
+			return nullptr;
+		}
 
 		newSrc->seeker = std::make_shared<TelemetrySeeker>(newSrc);
 		newSrc->telemSrc = std::make_shared<TelemetrySource>(newSrc);
@@ -452,9 +646,7 @@ namespace gpo
 		const gpo::TelemetrySamples &tSamps)
 	{
 		auto newSrc = std::make_shared<DataSource>();
-		newSrc->samples_ = std::make_shared<TelemetrySamples>();
-		newSrc->samples_->resize(tSamps.size());
-		newSrc->samples_->assign(tSamps.begin(),tSamps.end());
+		newSrc->columns_ = std::make_shared<TelemetryColumns>(tSamps);
 
 		newSrc->seeker = std::make_shared<TelemetrySeeker>(newSrc);
 		newSrc->telemSrc = std::make_shared<TelemetrySource>(newSrc);
@@ -471,12 +663,42 @@ namespace gpo
 		{
 			return false;
 		}
+		auto samples = std::make_shared<TelemetrySamples>();
+		columns_->toSamples(*samples);
 		return utils::io::writeTelemetryToCSV(
-			samples_,
+			samples,
 			csvFilepath,
 			dataAvail_);
 	}
 
+	bool
+	DataSource::writeTelemetryToBinary(
+		const std::filesystem::path &binFilepath) const
+	{
+		if ( ! hasTelemetry())
+		{
+			return false;
+		}
+		return utils::io::writeTelemetryToBinary(
+			*columns_,
+			dataAvail_,
+			binFilepath);
+	}
+
+	bool
+	DataSource::writeTelemetryToArchive(
+		const std::filesystem::path &archiveFilepath) const
+	{
+		if ( ! hasTelemetry())
+		{
+			return false;
+		}
+		return utils::io::writeTelemetryToArchive(
+			*columns_,
+			dataAvail_,
+			archiveFilepath);
+	}
+
 	size_t
 	DataSource::mergeTelemetryIn(
 		const DataSourcePtr srcData,
@@ -492,14 +714,6 @@ namespace gpo
 			growVector);
 	}
 
-	#define TAKE_DATA_IF_AVAIL(bitToTake, dataPath)    \
-			if (dataToTake.test(bitToTake))  \
-			{                                          \
-				dstSamp.dataPath = srcSamp.dataPath; \
-				dataAvail_.set(bitToTake); \
-				dataToTake.reset(bitToTake); \
-			}
-
 	size_t
 	DataSource::mergeTelemetryIn(
 		const DataSourcePtr srcData,
@@ -515,7 +729,7 @@ namespace gpo
 			return 0;
 		}
 
-		const auto &srcSamps = srcData->samples_;
+		const auto &srcSamps = srcData->columns_;
 		if (srcStartIdx >= srcSamps->size())
 		{
 			spdlog::error(
@@ -525,7 +739,7 @@ namespace gpo
 			return 0;
 		}
 
-		const auto &dstSamps = samples_;
+		const auto &dstSamps = columns_;
 		if (dstStartIdx >= dstSamps->size())
 		{
 			spdlog::error(
@@ -561,7 +775,7 @@ namespace gpo
 			if (growVector)
 			{
 				size_t growthNeeded = nSampsToMerge - nSampsWeCouldTakeWithoutGrowth;
-				samples_->resize(samples_->size() + growthNeeded);
+				columns_->resize(columns_->size() + growthNeeded);
 			}
 			else
 			{
@@ -582,53 +796,33 @@ namespace gpo
 			growVector,
 			nSampsToMerge);
 
-		size_t mergedSamples = 0;
-		for (size_t i=0; i<nSampsToMerge; i++, mergedSamples++)
+		// merge in each channel whose data we were asked to take
+		DataAvailableBitSet dataTaken;
+		for (const auto &desc : getChannelDescriptors())
 		{
-			auto &dstSamp = dstSamps->at(dstStartIdx + i);
-			const auto &srcSamp = srcSamps->at(srcStartIdx + i);
-
-			// merge in GoPro samples
-			TAKE_DATA_IF_AVAIL(eDA_GOPRO_ACCL, gpSamp.accl)
-			TAKE_DATA_IF_AVAIL(eDA_GOPRO_GRAV, gpSamp.gyro)
-			TAKE_DATA_IF_AVAIL(eDA_GOPRO_GYRO, gpSamp.grav)
-			TAKE_DATA_IF_AVAIL(eDA_GOPRO_CORI, gpSamp.cori)
-			TAKE_DATA_IF_AVAIL(eDA_GOPRO_GPS_LATLON, gpSamp.gps.coord)
-			TAKE_DATA_IF_AVAIL(eDA_GOPRO_GPS_ALTITUDE, gpSamp.gps.altitude)
-			TAKE_DATA_IF_AVAIL(eDA_GOPRO_GPS_SPEED2D, gpSamp.gps.speed2D)
-			TAKE_DATA_IF_AVAIL(eDA_GOPRO_GPS_SPEED3D, gpSamp.gps.speed3D)
-
-			// merge in ECU samples
-			TAKE_DATA_IF_AVAIL(eDA_ECU_ENGINE_SPEED, ecuSamp.engineSpeed_rpm)
-			TAKE_DATA_IF_AVAIL(eDA_ECU_TPS, ecuSamp.tps)
-			TAKE_DATA_IF_AVAIL(eDA_ECU_BOOST, ecuSamp.boost_psi)
-
-			// merge in Track samples
-			TAKE_DATA_IF_AVAIL(eDA_CALC_ON_TRACK_LATLON, calcSamp.onTrackLL)
-			TAKE_DATA_IF_AVAIL(eDA_CALC_LAP, calcSamp.lap)
-			TAKE_DATA_IF_AVAIL(eDA_CALC_LAP_TIME_OFFSET, calcSamp.lapTimeOffset)
-			TAKE_DATA_IF_AVAIL(eDA_CALC_SECTOR, calcSamp.sector)
-			TAKE_DATA_IF_AVAIL(eDA_CALC_SECTOR_TIME_OFFSET, calcSamp.sectorTimeOffset)
+			if (desc.availBit < 0 || ! dataToTake.test(desc.availBit))
+			{
+				continue;
+			}
+			dstSamps->copyChannel(
+				desc.channel,
+				*srcSamps,
+				srcStartIdx,
+				dstStartIdx,
+				nSampsToMerge);
+			dataTaken.set(desc.availBit);
 		}
+		dataAvail_ |= dataTaken;
+		columns_->setDataAvailable(dataAvail_);
+		trackTimesCache_.clear();
+		dataToTake &= ~dataTaken;
+		const size_t mergedSamples = nSampsToMerge;
 
 		// make sure everything was merged (future proofing logic in case fields are added)
 		if (dataToTake.any())
 		{
 			spdlog::warn(
-				"unmerged GoPro samples remain. seems like {}() implementation is incomplete.",
-				__func__);
-		}
-		if (dataToTake.any())
-		{
-			spdlog::warn(
-				"unmerged ECU samples remain. seems like {}() implementation is incomplete.",
-				__func__);
-		}
-		if (dataToTake.any())
-		{
-			spdlog::warn(
-				"unmerged Track samples remain. seems like {}() implementation is incomplete.",
-				__func__);
+				"unmerged samples remain. seems like the channel descriptor table is incomplete.");
 		}
 
 		return mergedSamples;
@@ -638,6 +832,7 @@ namespace gpo
 	DataSourceManager::clear()
 	{
 		sources_.clear();
+		hasDecodeConfig_ = false;
 	}
 
 	bool
@@ -734,6 +929,62 @@ namespace gpo
 		return nullptr;
 	}
 
+	void
+	DataSourceManager::setDecodeConfig(
+		const VideoDecodeConfig &config)
+	{
+		decodeConfig_ = config;
+		hasDecodeConfig_ = true;
+		for (const auto &source : sources_)
+		{
+			if (source->hasVideo())
+			{
+				source->videoSrc->setDecodeConfig(config);
+			}
+		}
+	}
+
+	void
+	DataSourceManager::clearDecodeConfig()
+	{
+		hasDecodeConfig_ = false;
+	}
+
+	bool
+	DataSourceManager::hasDecodeConfig() const
+	{
+		return hasDecodeConfig_;
+	}
+
+	const VideoDecodeConfig &
+	DataSourceManager::getDecodeConfig() const
+	{
+		return decodeConfig_;
+	}
+
+	YAML::Node
+	DataSourceManager::getDecodeReport() const
+	{
+		YAML::Node node;
+		for (const auto &source : sources_)
+		{
+			if ( ! source->hasVideo())
+			{
+				continue;
+			}
+
+			const auto stats = source->videoSrc->getDecodeStats();
+			YAML::Node ySource;
+			ySource["name"] = source->sourceName_;
+			ySource["decodeConfig"] = source->videoSrc->getDecodeConfig();
+			ySource["framesDecoded"] = stats.framesDecoded;
+			ySource["decodeFps"] = stats.decodeFps();
+			ySource["videoFps"] = source->videoSrc->fps();
+			node.push_back(ySource);
+		}
+		return node;
+	}
+
 	// YAML encode/decode
 	YAML::Node
 	DataSourceManager::encode() const
@@ -750,6 +1001,11 @@ namespace gpo
 			ySources.push_back(ySource);
 		}
 
+		if (hasDecodeConfig_)
+		{
+			node["decodeConfig"] = decodeConfig_;
+		}
+
 		return node;
 	}
 
@@ -760,6 +1016,12 @@ namespace gpo
 		bool okay = true;
 
 		sources_.clear();
+		hasDecodeConfig_ = false;
+		if (node["decodeConfig"])// optional
+		{
+			decodeConfig_ = node["decodeConfig"].as<VideoDecodeConfig>();
+			hasDecodeConfig_ = true;
+		}
 		if (node["sources"])// not all files will have sources
 		{
 			const YAML::Node &ySources = node["sources"];
@@ -785,6 +1047,12 @@ namespace gpo
 		if (dataSrc)
 		{
 			dataSrc->sourceName_ = name;
+			if (hasDecodeConfig_)
+			{
+				dataSrc->videoSrc->setDecodeConfig(decodeConfig_);
+			}
+			// no-op unless telemetry was paged in from the sidecar cache
+			dataSrc->streamTelemetryInBackground();
 			sources_.push_back(dataSrc);
 		}
 		return dataSrc != nullptr;
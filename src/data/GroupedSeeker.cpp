@@ -1,13 +1,19 @@
 #include "GoProOverlay/data/GroupedSeeker.h"
 
+#include <cmath>
 #include <limits>
 #include <spdlog/spdlog.h>
 
+#include "GoProOverlay/utils/TimeWarping.h"
+
 namespace gpo
 {
 	GroupedSeeker::GroupedSeeker()
 	 : ModifiableObject("GroupedSeeker",false,true)
 	 , seekers_()
+	 , warpSchedules_()
+	 , masterClock_hz_(0.0)
+	 , clockState_()
 	{
 	}
 
@@ -15,6 +21,8 @@ namespace gpo
 	GroupedSeeker::clear()
 	{
 		seekers_.clear();
+		warpSchedules_.clear();
+		clockState_ = SeekState();
 		clearNeedsApply();
 		clearNeedsSave();
 	}
@@ -23,7 +31,12 @@ namespace gpo
 	GroupedSeeker::addSeeker(
 		TelemetrySeekerPtr seeker)
 	{
+		if (seeker->clockRate() != masterClock_hz_)
+		{
+			seeker->setClockRate(masterClock_hz_);
+		}
 		seekers_.push_back(seeker);
+		clockState_ = SeekState();
 		markObjectModified(false,true);
 	}
 
@@ -43,7 +56,12 @@ namespace gpo
 
 		if (isNewSeeker)
 		{
+			if (seeker->clockRate() != masterClock_hz_)
+			{
+				seeker->setClockRate(masterClock_hz_);
+			}
 			seekers_.push_back(seeker);
+			clockState_ = SeekState();
 			markObjectModified(false,true);
 		}
 		return isNewSeeker;
@@ -67,6 +85,8 @@ namespace gpo
 		size_t idx)
 	{
 		seekers_.erase(std::next(seekers_.begin(), idx));
+		clearWarpSchedules();
+		clockState_ = SeekState();
 		markObjectModified(false,true);
 	}
 
@@ -89,15 +109,49 @@ namespace gpo
 			}
 		}
 
+		if (removed)
+		{
+			clearWarpSchedules();
+			clockState_ = SeekState();
+		}
 		markObjectModified(false,removed);
 
 		return removed;
 	}
 
+	void
+	GroupedSeeker::setMasterClock(
+		double rate_hz)
+	{
+		masterClock_hz_ = std::max(rate_hz, 0.0);
+		for (auto &seeker : seekers_)
+		{
+			if (seeker->clockRate() != masterClock_hz_)
+			{
+				seeker->setClockRate(masterClock_hz_);
+			}
+		}
+		// the clock picks up from wherever the seekers are on its first step
+		clockState_ = SeekState();
+	}
+
+	double
+	GroupedSeeker::masterClockRate() const
+	{
+		return masterClock_hz_;
+	}
+
 	void
 	GroupedSeeker::prevAll(
 			bool onlyIfAllHavePrev)
 	{
+		if (masterClock_hz_ > 0.0)
+		{
+			stepClock(-1);
+			markObjectModified(false,false);
+			return;
+		}
+
 		if (onlyIfAllHavePrev)
 		{
 			for (auto &seeker : seekers_)
@@ -113,6 +167,7 @@ namespace gpo
 		{
 			seeker->prev();
 		}
+		followWarpSchedules();
 		markObjectModified(false,false);
 	}
 
@@ -121,6 +176,16 @@ namespace gpo
 			bool onlyIfAllHaveNext,
 			bool sendModificationEvent)
 	{
+		if (masterClock_hz_ > 0.0)
+		{
+			stepClock(1);
+			if (sendModificationEvent)
+			{
+				markObjectModified(false,false);
+			}
+			return;
+		}
+
 		if (onlyIfAllHaveNext)
 		{
 			for (auto &seeker : seekers_)
@@ -136,6 +201,7 @@ namespace gpo
 		{
 			seeker->next();
 		}
+		followWarpSchedules();
 		if (sendModificationEvent)
 		{
 			markObjectModified(false,false);
@@ -150,6 +216,7 @@ namespace gpo
 		{
 			case gpo::RenderAlignmentType_E::eRAT_Custom:
 			{
+				clearWarpSchedules();
 				const auto &customAlign = renderAlignInfo.alignInfo.custom;
 				for (auto seeker : seekers_)
 				{
@@ -165,6 +232,14 @@ namespace gpo
 			case gpo::RenderAlignmentType_E::eRAT_Lap:
 			{
 				const auto &lapAlign = renderAlignInfo.alignInfo.lap;
+				if (lapAlign->warp)
+				{
+					warpAllToLap(lapAlign->lap);
+				}
+				else
+				{
+					clearWarpSchedules();
+				}
 				if (lapAlign->side == gpo::ElementSide_E::eES_Entry)
 				{
 					seekAllToLapEntry(lapAlign->lap);
@@ -175,7 +250,22 @@ namespace gpo
 				}
 				break;
 			}
+			case gpo::RenderAlignmentType_E::eRAT_Sector:
+			{
+				clearWarpSchedules();
+				const auto &sectorAlign = renderAlignInfo.alignInfo.sector;
+				if (sectorAlign->side == gpo::ElementSide_E::eES_Entry)
+				{
+					seekAllToSectorEntry(sectorAlign->lap,sectorAlign->sector);
+				}
+				else
+				{
+					seekAllToSectorExit(sectorAlign->lap,sectorAlign->sector);
+				}
+				break;
+			}
 			case gpo::RenderAlignmentType_E::eRAT_None:
+				clearWarpSchedules();
 				seekAllToIdx(0);
 				break;
 			default:
@@ -210,10 +300,18 @@ namespace gpo
 			amount = limits.first;
 		}
 
+		if (masterClock_hz_ > 0.0)
+		{
+			stepClock(forward ? (int64_t)amount : -(int64_t)amount);
+			markObjectModified(false,false);
+			return;
+		}
+
 		for (auto &seeker : seekers_)
 		{
 			seeker->seekRelative(amount,forward);
 		}
+		followWarpSchedules();
 		markObjectModified(false,false);
 	}
 
@@ -231,10 +329,18 @@ namespace gpo
 			offset_secs = limits.first;
 		}
 
+		if (masterClock_hz_ > 0.0)
+		{
+			stepClock(std::llround(offset_secs * masterClock_hz_));
+			markObjectModified(false,false);
+			return;
+		}
+
 		for (auto &seeker : seekers_)
 		{
 			seeker->seekRelativeTime(offset_secs);
 		}
+		followWarpSchedules();
 		markObjectModified(false,false);
 	}
 
@@ -291,7 +397,7 @@ namespace gpo
 		}
 		for (const auto &seeker : seekers_)
 		{
-			if (lap >= (seeker->lapCount() + 1))
+			if ( ! seeker->hasLap(lap))
 			{
 				spdlog::warn(
 					"'{}' doesn't have lap {}. aborting {}()",
@@ -306,6 +412,7 @@ namespace gpo
 		{
 			seeker->seekToLapEntry(lap);
 		}
+		followWarpSchedules();
 		markObjectModified(false,false);
 		return true;
 	}
@@ -321,7 +428,7 @@ namespace gpo
 		}
 		for (const auto &seeker : seekers_)
 		{
-			if (lap >= (seeker->lapCount() + 1))
+			if ( ! seeker->hasLap(lap))
 			{
 				spdlog::warn(
 					"'{}' doesn't have lap {}. aborting {}()",
@@ -336,31 +443,231 @@ namespace gpo
 		{
 			seeker->seekToLapExit(lap);
 		}
+		followWarpSchedules();
 		markObjectModified(false,false);
 		return true;
 	}
 
-	std::pair<size_t, size_t>
-	GroupedSeeker::relativeSeekLimits() const
+	bool
+	GroupedSeeker::seekAllToSectorEntry(
+		unsigned int lap,
+		unsigned int sector)
 	{
-		if (seekers_.empty())
+		for (const auto &seeker : seekers_)
 		{
-			return {0,0};
+			if ( ! seeker->hasSector(lap,sector))
+			{
+				spdlog::warn(
+					"'{}' doesn't have sector {} in lap {}. aborting {}()",
+					seeker->getDataSourceName(),
+					sector,
+					lap,
+					__func__);
+				return false;
+			}
 		}
 
-		std::pair<size_t, size_t> limits;
-		limits.first = std::numeric_limits<decltype(limits.first)>::max();
-		limits.second = std::numeric_limits<decltype(limits.second)>::max();
 		for (auto &seeker : seekers_)
 		{
-			if (seeker->size() == 0)
+			seeker->seekToSectorEntry(lap,sector);
+		}
+		followWarpSchedules();
+		markObjectModified(false,false);
+		return true;
+	}
+
+	bool
+	GroupedSeeker::seekAllToSectorExit(
+		unsigned int lap,
+		unsigned int sector)
+	{
+		for (const auto &seeker : seekers_)
+		{
+			if ( ! seeker->hasSector(lap,sector))
+			{
+				spdlog::warn(
+					"'{}' doesn't have sector {} in lap {}. aborting {}()",
+					seeker->getDataSourceName(),
+					sector,
+					lap,
+					__func__);
+				return false;
+			}
+		}
+
+		for (auto &seeker : seekers_)
+		{
+			seeker->seekToSectorExit(lap,sector);
+		}
+		followWarpSchedules();
+		markObjectModified(false,false);
+		return true;
+	}
+
+	bool
+	GroupedSeeker::warpAllToLap(
+		unsigned int lap,
+		double bandRadius_sec)
+	{
+		clearWarpSchedules();
+		if (lap == 0 || seekers_.empty())
+		{
+			return false;
+		}
+
+		auto leader = seekers_.front();
+		if ( ! leader->hasLap(lap))
+		{
+			spdlog::warn("'{}' doesn't have lap {} to warp to", leader->getDataSourceName(), lap);
+			return false;
+		}
+		const auto leaderLap = leader->getLapEntryExit(lap);
+		const auto leaderTelem = leader->getTelemetrySource();
+
+		bool allWarped = true;
+		for (size_t ss=1; ss<seekers_.size(); ss++)
+		{
+			auto follower = seekers_[ss];
+			if (follower == leader)
+			{
+				continue;
+			}
+			else if ( ! follower->hasLap(lap))
+			{
+				spdlog::warn("'{}' doesn't have lap {} to warp to", follower->getDataSourceName(), lap);
+				allWarped = false;
+				continue;
+			}
+
+			auto followerIdxs = std::make_shared<std::vector<size_t>>();
+			const bool warped = utils::warpTelemetry(
+				*leaderTelem,
+				leaderLap,
+				*follower->getTelemetrySource(),
+				follower->getLapEntryExit(lap),
+				bandRadius_sec,
+				*followerIdxs);
+			if ( ! warped)
+			{
+				allWarped = false;
+				continue;
+			}
+
+			WarpSchedule schedule;
+			schedule.leader = leader;
+			schedule.follower = follower;
+			schedule.leaderStartIdx = leaderLap.first;
+			schedule.followerIdxs = std::move(followerIdxs);
+			warpSchedules_.push_back(std::move(schedule));
+		}
+
+		followWarpSchedules();
+		return allWarped;
+	}
+
+	void
+	GroupedSeeker::clearWarpSchedules()
+	{
+		warpSchedules_.clear();
+	}
+
+	SeekState
+	GroupedSeeker::currentState() const
+	{
+		if (masterClock_hz_ > 0.0 && clockInSync())
+		{
+			// keeps the ticks of sources that are between samples
+			return clockState_;
+		}
+
+		std::vector<SeekState::Entry> entries;
+		entries.reserve(seekers_.size());
+		for (const auto &seeker : seekers_)
+		{
+			SeekState::Entry entry = {seeker.get(), seeker->seekedIdx()};
+			if (masterClock_hz_ > 0.0)
 			{
-				return {0,0};// corner case where a seeker doesn't have any samples
+				entry.clockTick = seeker->clockTickOf(entry.idx);
 			}
-			limits.first = std::min(limits.first, seeker->seekedIdx());
-			limits.second = std::min(limits.second, (seeker->size() - seeker->seekedIdx() - 1));
+			entries.push_back(entry);
 		}
-		return limits;
+		return SeekState(std::move(entries));
+	}
+
+	SeekState
+	GroupedSeeker::stateAt(
+		const SeekState &start,
+		size_t frame) const
+	{
+		return timeline().stateAt(start, frame);
+	}
+
+	SeekTimeline
+	GroupedSeeker::timeline() const
+	{
+		return timeline(masterClock_hz_);
+	}
+
+	SeekTimeline
+	GroupedSeeker::timeline(
+		double clockRate_hz) const
+	{
+		std::vector<SeekTimeline::Track> tracks;
+		tracks.reserve(seekers_.size());
+		for (const auto &seeker : seekers_)
+		{
+			ClockSchedulePtr clock;
+			if (clockRate_hz > 0.0)
+			{
+				clock = seeker->clockSchedule();
+				if ( ! clock || clock->rate_hz != clockRate_hz)
+				{
+					clock = seeker->makeClockSchedule(clockRate_hz);
+				}
+			}
+			tracks.push_back({seeker.get(), seeker->size(), std::move(clock)});
+		}
+
+		std::vector<SeekTimeline::Warp> warps;
+		warps.reserve(warpSchedules_.size());
+		for (const auto &schedule : warpSchedules_)
+		{
+			warps.push_back({
+				schedule.leader.get(),
+				schedule.follower.get(),
+				schedule.leaderStartIdx,
+				schedule.followerIdxs});
+		}
+		return SeekTimeline(std::move(tracks), std::move(warps), clockRate_hz);
+	}
+
+	void
+	GroupedSeeker::followWarpSchedules()
+	{
+		for (const auto &schedule : warpSchedules_)
+		{
+			const size_t leaderIdx = schedule.leader->seekedIdx();
+			if (leaderIdx < schedule.leaderStartIdx)
+			{
+				continue;
+			}
+			const size_t offset = leaderIdx - schedule.leaderStartIdx;
+			if (offset < schedule.followerIdxs->size())
+			{
+				schedule.follower->seekToIdx((*schedule.followerIdxs)[offset]);
+			}
+		}
+	}
+
+	std::pair<size_t, size_t>
+	GroupedSeeker::relativeSeekLimits() const
+	{
+		if (seekers_.empty())
+		{
+			return {0,0};
+		}
+
+		return timeline().stepLimits(currentState());
 	}
 
 	std::pair<double, double>
@@ -371,10 +678,16 @@ namespace gpo
 			return {0.0,0.0};
 		}
 
+		auto limits = relativeSeekLimits();
+		if (masterClock_hz_ > 0.0)
+		{
+			// everyone moves by the same amount of time
+			return {-(limits.first / masterClock_hz_), limits.second / masterClock_hz_};
+		}
+
 		std::pair<double,double> timeLimits;
 		timeLimits.first = std::numeric_limits<decltype(timeLimits.first)>::max();
 		timeLimits.second = std::numeric_limits<decltype(timeLimits.second)>::min();
-		auto limits = relativeSeekLimits();
 		for (auto &seeker : seekers_)
 		{
 			const auto seekedIdx = seeker->seekedIdx();
@@ -387,6 +700,47 @@ namespace gpo
 		return timeLimits;
 	}
 
+	void
+	GroupedSeeker::seekAllTo(
+		const SeekState &state)
+	{
+		for (auto &seeker : seekers_)
+		{
+			const size_t idx = state.seekedIdx(seeker.get());
+			if (idx != seeker->seekedIdx())
+			{
+				seeker->seekToIdx(idx);
+			}
+		}
+	}
+
+	bool
+	GroupedSeeker::clockInSync() const
+	{
+		if (clockState_.entries().size() != seekers_.size())
+		{
+			return false;
+		}
+		for (const auto &seeker : seekers_)
+		{
+			const auto *entry = clockState_.find(seeker.get());
+			if (entry == nullptr || entry->idx != seeker->seekedIdx())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void
+	GroupedSeeker::stepClock(
+		int64_t steps)
+	{
+		// picks up from the seekers if they were moved some other way
+		clockState_ = timeline().step(currentState(), steps);
+		seekAllTo(clockState_);
+	}
+
 	bool
 	GroupedSeeker::subclassApplyModifications(
         bool /* unnecessaryIsOkay */)
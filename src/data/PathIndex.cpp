@@ -0,0 +1,164 @@
+#include "GoProOverlay/data/PathIndex.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace gpo
+{
+
+	static
+	double
+	distSqr(
+		const cv::Vec2d &a,
+		const cv::Vec2d &b)
+	{
+		const double dx = b[0] - a[0];
+		const double dy = b[1] - a[1];
+		return (dx*dx) + (dy*dy);
+	}
+
+	PathIndex::PathIndex(
+		const std::vector<cv::Vec2d> &path)
+	 : path_(path)
+	 , order_(path.size())
+	 , nodes_(path.size())
+	{
+		for (size_t i=0; i<order_.size(); i++)
+		{
+			order_[i] = i;
+		}
+		build(0, order_.size());
+	}
+
+	std::tuple<bool, cv::Vec2d, size_t>
+	PathIndex::findClosest(
+		const cv::Vec2d &p,
+		size_t startIdx,
+		size_t endIdx) const
+	{
+		endIdx = std::min(endIdx, path_.size());
+		Query q = {p, startIdx, endIdx, std::numeric_limits<double>::infinity(), endIdx};
+		if (startIdx >= endIdx)
+		{
+			return std::tuple(false, cv::Vec2d(), startIdx);
+		}
+		else if ((endIdx - startIdx) <= LINEAR_SCAN_THRESHOLD)
+		{
+			for (size_t i=startIdx; i<endIdx; i++)
+			{
+				const double d = distSqr(p, path_[i]);
+				if (d < q.bestDistSqr)
+				{
+					q.bestDistSqr = d;
+					q.bestIdx = i;
+				}
+			}
+		}
+		else
+		{
+			search(q, 0, order_.size());
+		}
+		return std::tuple(true, path_[q.bestIdx], q.bestIdx);
+	}
+
+	bool
+	PathIndex::isBuiltFrom(
+		const std::vector<cv::Vec2d> &path) const
+	{
+		return &path_ == &path;
+	}
+
+	void
+	PathIndex::build(
+		size_t lo,
+		size_t hi)
+	{
+		if (lo >= hi)
+		{
+			return;
+		}
+
+		// split on whichever axis the points are most spread out along
+		Node node;
+		node.min = path_[order_[lo]];
+		node.max = node.min;
+		node.minIdx = order_[lo];
+		node.maxIdx = order_[lo];
+		for (size_t i=lo+1; i<hi; i++)
+		{
+			const auto &pt = path_[order_[i]];
+			for (size_t aa=0; aa<2; aa++)
+			{
+				node.min[aa] = std::min(node.min[aa], pt[aa]);
+				node.max[aa] = std::max(node.max[aa], pt[aa]);
+			}
+			node.minIdx = std::min(node.minIdx, order_[i]);
+			node.maxIdx = std::max(node.maxIdx, order_[i]);
+		}
+		const uint8_t axis = ((node.max[0] - node.min[0]) >= (node.max[1] - node.min[1]) ? 0 : 1);
+		node.axis = axis;
+
+		const size_t mid = (lo + hi) / 2;
+		std::nth_element(
+			order_.begin() + lo,
+			order_.begin() + mid,
+			order_.begin() + hi,
+			[this, axis](uint32_t a, uint32_t b){
+				return path_[a][axis] < path_[b][axis];
+			});
+		nodes_[mid] = node;
+
+		build(lo, mid);
+		build(mid + 1, hi);
+	}
+
+	void
+	PathIndex::search(
+		Query &q,
+		size_t lo,
+		size_t hi) const
+	{
+		if (lo >= hi)
+		{
+			return;
+		}
+
+		const size_t mid = (lo + hi) / 2;
+		const auto &node = nodes_[mid];
+		if (node.maxIdx < q.startIdx || node.minIdx >= q.endIdx)
+		{
+			// nothing beneath this node is within the window
+			return;
+		}
+
+		// skip the subtree if its bounding box can't hold a better (or tied) point
+		double boxDistSqr = 0.0;
+		for (size_t aa=0; aa<2; aa++)
+		{
+			const double d = std::max({node.min[aa] - q.p[aa], 0.0, q.p[aa] - node.max[aa]});
+			boxDistSqr += d * d;
+		}
+		if (boxDistSqr > q.bestDistSqr)
+		{
+			return;
+		}
+
+		const size_t idx = order_[mid];
+		const auto &pt = path_[idx];
+		if (q.startIdx <= idx && idx < q.endIdx)
+		{
+			const double d = distSqr(q.p, pt);
+			if (d < q.bestDistSqr || (d == q.bestDistSqr && idx < q.bestIdx))
+			{
+				q.bestDistSqr = d;
+				q.bestIdx = idx;
+			}
+		}
+
+		// descend towards 'p' first so the far side is more likely pruned
+		const bool nearIsLow = q.p[node.axis] < pt[node.axis];
+		search(q, (nearIsLow ? lo : mid + 1), (nearIsLow ? mid : hi));
+		search(q, (nearIsLow ? mid + 1 : lo), (nearIsLow ? hi : mid));
+	}
+
+}
@@ -162,6 +162,19 @@ namespace gpo
 		}
 	}
 
+	void
+	RenderProject::configureVideoDecoders()
+	{
+		if (dsm_.hasDecodeConfig())
+		{
+			dsm_.setDecodeConfig(dsm_.getDecodeConfig());
+		}
+		else
+		{
+			engine_->configureVideoDecoders();
+		}
+	}
+
 	void
 	RenderProject::setEngine(
 		RenderEnginePtr engine)
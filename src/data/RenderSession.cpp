@@ -0,0 +1,58 @@
+#include "GoProOverlay/data/RenderSession.h"
+
+namespace gpo
+{
+
+	RenderSession::RenderSession(
+		const DataSourceManager &dsm)
+	 : pinned_()
+	 , pinnedChunkIdxs_(dsm.sourceCount(), -1)
+	 , chunkPins_(dsm.sourceCount())
+	{
+		pinned_.reserve(dsm.sourceCount());
+		for (size_t ss=0; ss<dsm.sourceCount(); ss++)
+		{
+			pinned_.push_back(dsm.getSource(ss));
+		}
+	}
+
+	size_t
+	RenderSession::sourceCount() const
+	{
+		return pinned_.size();
+	}
+
+	const DataSourcePtr &
+	RenderSession::getSource(
+		size_t idx) const
+	{
+		return pinned_.at(idx);
+	}
+
+	bool
+	RenderSession::pageAround(
+		const SeekState &state)
+	{
+		bool moved = false;
+		for (size_t ss=0; ss<pinned_.size(); ss++)
+		{
+			const auto &dSrc = pinned_[ss];
+			const auto *entry = state.find(dSrc->seeker.get());
+			if (entry == nullptr || ! dSrc->columns_)
+			{
+				continue;
+			}
+
+			const size_t chunkIdx = entry->idx >> TELEM_CHUNK_SHIFT;
+			if (chunkIdx == pinnedChunkIdxs_[ss])
+			{
+				continue;
+			}
+			pinnedChunkIdxs_[ss] = chunkIdx;
+			chunkPins_[ss] = dSrc->columns_->pin(entry->idx, entry->idx + 1);
+			moved = true;
+		}
+		return moved;
+	}
+
+}
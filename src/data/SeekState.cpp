@@ -0,0 +1,57 @@
+#include "GoProOverlay/data/SeekState.h"
+
+#include <stdexcept>
+
+#include "GoProOverlay/data/TelemetrySeeker.h"
+
+namespace gpo
+{
+	SeekState::SeekState(
+		std::vector<Entry> entries)
+	 : entries_(std::move(entries))
+	{
+	}
+
+	size_t
+	SeekState::seekedIdx(
+		const TelemetrySeeker *seeker) const
+	{
+		if (const auto *entry = find(seeker))
+		{
+			return entry->idx;
+		}
+		else if ( ! entries_.empty())
+		{
+			throw std::out_of_range("seeker isn't part of the state");
+		}
+		return seeker->seekedIdx();
+	}
+
+	const SeekState::Entry *
+	SeekState::find(
+		const TelemetrySeeker *seeker) const
+	{
+		// only a handful of sources are ever rendered together, so a scan
+		// beats anything fancier
+		for (const auto &entry : entries_)
+		{
+			if (entry.seeker == seeker)
+			{
+				return &entry;
+			}
+		}
+		return nullptr;
+	}
+
+	const std::vector<SeekState::Entry> &
+	SeekState::entries() const
+	{
+		return entries_;
+	}
+
+	bool
+	SeekState::empty() const
+	{
+		return entries_.empty();
+	}
+}
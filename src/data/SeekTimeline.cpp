@@ -0,0 +1,242 @@
+#include "GoProOverlay/data/SeekTimeline.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace gpo
+{
+	SeekTimeline::SeekTimeline(
+		std::vector<Track> tracks,
+		std::vector<Warp> warps,
+		double clockRate_hz)
+	 : tracks_(std::move(tracks))
+	 , warps_(std::move(warps))
+	 , clockRate_hz_(std::max(clockRate_hz, 0.0))
+	{
+	}
+
+	double
+	SeekTimeline::clockRate() const
+	{
+		return clockRate_hz_;
+	}
+
+	SeekState
+	SeekTimeline::stateOf(
+		const SeekState &state) const
+	{
+		std::vector<SeekState::Entry> entries;
+		entries.reserve(tracks_.size());
+		for (const auto &track : tracks_)
+		{
+			SeekState::Entry entry = {track.seeker, state.seekedIdx(track.seeker)};
+			if (clockRate_hz_ > 0.0)
+			{
+				entry.clockTick = tickOf(track, entry.idx);
+			}
+			entries.push_back(entry);
+		}
+		return SeekState(std::move(entries));
+	}
+
+	SeekState
+	SeekTimeline::stateAt(
+		const SeekState &start,
+		size_t frame) const
+	{
+		return step(start, frame);
+	}
+
+	SeekState
+	SeekTimeline::step(
+		const SeekState &start,
+		int64_t steps) const
+	{
+		// everyone stops moving once any track runs out of samples
+		std::vector<SeekState::Entry> entries;
+		entries.reserve(tracks_.size());
+		for (const auto &track : tracks_)
+		{
+			entries.push_back(entryOf(start, track));
+			const auto limits = stepLimits(track, entries.back());
+			steps = std::clamp(steps, -(int64_t)limits.first, (int64_t)limits.second);
+		}
+		for (size_t tt=0; tt<tracks_.size(); tt++)
+		{
+			entries[tt] = stepEntry(tracks_[tt], entries[tt], steps);
+		}
+		const SeekState stepped(entries);
+
+		for (const auto &warp : warps_)
+		{
+			const Track *leaderTrack = findTrack(warp.leader);
+			const Track *followerTrack = findTrack(warp.follower);
+			if (leaderTrack == nullptr || followerTrack == nullptr || warp.followerIdxs->empty())
+			{
+				continue;
+			}
+
+			const auto &followerIdxs = *warp.followerIdxs;
+			const auto leaderStart = entryOf(start, *leaderTrack);
+			const auto leader = entryOf(stepped, *leaderTrack);
+			const size_t scheduleEndIdx = warp.leaderStartIdx + followerIdxs.size();
+			SeekState::Entry follower = entryOf(stepped, *followerTrack);
+			if (warp.leaderStartIdx <= leader.idx && leader.idx < scheduleEndIdx)
+			{
+				follower.idx = followerIdxs[leader.idx - warp.leaderStartIdx];
+				if (clockRate_hz_ > 0.0)
+				{
+					follower.clockTick = tickOf(*followerTrack, follower.idx);
+				}
+			}
+			else if (leader.idx >= scheduleEndIdx && leaderStart.idx < scheduleEndIdx)
+			{
+				// stepped on from wherever the schedule left off
+				SeekState::Entry scheduleEnd = {warp.follower, followerIdxs.back()};
+				int64_t stepsSinceEnd = leader.idx - (scheduleEndIdx - 1);
+				if (clockRate_hz_ > 0.0)
+				{
+					scheduleEnd.clockTick = tickOf(*followerTrack, scheduleEnd.idx);
+					stepsSinceEnd = leader.clockTick - tickOf(*leaderTrack, scheduleEndIdx - 1);
+				}
+				follower = stepEntry(*followerTrack, scheduleEnd, stepsSinceEnd);
+			}
+
+			for (auto &entry : entries)
+			{
+				if (entry.seeker == warp.follower)
+				{
+					entry = follower;
+				}
+			}
+		}
+		return SeekState(std::move(entries));
+	}
+
+	std::pair<size_t, size_t>
+	SeekTimeline::stepLimits(
+		const SeekState &state) const
+	{
+		if (tracks_.empty())
+		{
+			return {0,0};
+		}
+
+		std::pair<size_t, size_t> limits;
+		limits.first = std::numeric_limits<decltype(limits.first)>::max();
+		limits.second = std::numeric_limits<decltype(limits.second)>::max();
+		for (const auto &track : tracks_)
+		{
+			const auto trackLimits = stepLimits(track, entryOf(state, track));
+			limits.first = std::min(limits.first, trackLimits.first);
+			limits.second = std::min(limits.second, trackLimits.second);
+		}
+		return limits;
+	}
+
+	SeekState::Entry
+	SeekTimeline::entryOf(
+		const SeekState &state,
+		const Track &track) const
+	{
+		SeekState::Entry entry = {track.seeker, 0};
+		if (const auto *found = state.find(track.seeker))
+		{
+			entry = *found;
+		}
+		else
+		{
+			entry.idx = state.seekedIdx(track.seeker);
+		}
+
+		if (clockRate_hz_ <= 0.0)
+		{
+			entry.clockTick = -1;
+		}
+		else if (entry.clockTick == size_t(-1))
+		{
+			entry.clockTick = tickOf(track, entry.idx);
+		}
+		return entry;
+	}
+
+	std::pair<size_t, size_t>
+	SeekTimeline::stepLimits(
+		const Track &track,
+		const SeekState::Entry &entry) const
+	{
+		if (clockRate_hz_ > 0.0)
+		{
+			const size_t nTicks = track.clock ? track.clock->idxAtTick.size() : 0;
+			if (nTicks == 0)
+			{
+				return {0,0};
+			}
+			const size_t tick = std::min(entry.clockTick, nTicks - 1);
+			return {tick, nTicks - tick - 1};
+		}
+
+		if (track.nSamps == 0)
+		{
+			return {0,0};
+		}
+		const size_t idx = std::min(entry.idx, track.nSamps - 1);
+		return {idx, track.nSamps - idx - 1};
+	}
+
+	SeekState::Entry
+	SeekTimeline::stepEntry(
+		const Track &track,
+		const SeekState::Entry &entry,
+		int64_t steps) const
+	{
+		const auto limits = stepLimits(track, entry);
+		steps = std::clamp(steps, -(int64_t)limits.first, (int64_t)limits.second);
+		if (steps == 0)
+		{
+			// don't snap a sample that's between ticks onto one
+			return entry;
+		}
+
+		SeekState::Entry stepped = entry;
+		if (clockRate_hz_ > 0.0)
+		{
+			// stepLimits() only lets us move if the track has a schedule
+			const auto &idxAtTick = track.clock->idxAtTick;
+			stepped.clockTick = entry.clockTick + steps;
+			stepped.idx = idxAtTick[std::min(stepped.clockTick, idxAtTick.size() - 1)];
+		}
+		else
+		{
+			stepped.idx = entry.idx + steps;
+		}
+		return stepped;
+	}
+
+	const SeekTimeline::Track *
+	SeekTimeline::findTrack(
+		const TelemetrySeeker *seeker) const
+	{
+		for (const auto &track : tracks_)
+		{
+			if (track.seeker == seeker)
+			{
+				return &track;
+			}
+		}
+		return nullptr;
+	}
+
+	size_t
+	SeekTimeline::tickOf(
+		const Track &track,
+		size_t idx)
+	{
+		if ( ! track.clock || track.clock->tickOfIdx.empty())
+		{
+			return 0;
+		}
+		const auto &tickOfIdx = track.clock->tickOfIdx;
+		return tickOfIdx[std::min(idx, tickOfIdx.size() - 1)];
+	}
+}
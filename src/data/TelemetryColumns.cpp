@@ -0,0 +1,1150 @@
+#include "GoProOverlay/data/TelemetryColumns.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <spdlog/spdlog.h>
+#include <type_traits>
+#include <utility>
+
+namespace gpo
+{
+	const std::array<ChannelDescriptor, eTC_COUNT> &
+	getChannelDescriptors()
+	{
+		return CHANNEL_DESCRIPTORS;
+	}
+
+	const ChannelDescriptor &
+	getChannelDescriptor(
+		TelemetryChannel_E channel)
+	{
+		return CHANNEL_DESCRIPTORS.at(channel);
+	}
+
+	size_t
+	getEncodedSize(
+		const ChannelDescriptor &desc,
+		ChannelEncoding_E encoding)
+	{
+		switch (encoding)
+		{
+		case eCE_NATIVE:
+			return desc.typeSize;
+		case eCE_FLOAT32:
+			return sizeof(float);
+		case eCE_FIXED16:
+			return sizeof(int16_t);
+		case eCE_ABSENT:
+			break;
+		}
+		return 0;
+	}
+
+	static
+	double
+	readNative(
+		const ChannelDescriptor &desc,
+		const uint8_t *src)
+	{
+		switch (desc.type)
+		{
+		case eCT_FLOAT:
+		{
+			float v;
+			std::memcpy(&v, src, sizeof(v));
+			return v;
+		}
+		case eCT_DOUBLE:
+		{
+			double v;
+			std::memcpy(&v, src, sizeof(v));
+			return v;
+		}
+		case eCT_INT:
+		{
+			int v;
+			std::memcpy(&v, src, sizeof(v));
+			return v;
+		}
+		}
+		return 0.0;
+	}
+
+	static
+	void
+	writeNative(
+		const ChannelDescriptor &desc,
+		uint8_t *dst,
+		double value)
+	{
+		switch (desc.type)
+		{
+		case eCT_FLOAT:
+		{
+			const float v = static_cast<float>(value);
+			std::memcpy(dst, &v, sizeof(v));
+			break;
+		}
+		case eCT_DOUBLE:
+			std::memcpy(dst, &value, sizeof(value));
+			break;
+		case eCT_INT:
+		{
+			const int v = static_cast<int>(std::lround(value));
+			std::memcpy(dst, &v, sizeof(v));
+			break;
+		}
+		}
+	}
+
+	static
+	double
+	decodeValue(
+		const ChannelDescriptor &desc,
+		ChannelEncoding_E encoding,
+		const uint8_t *bytes,
+		size_t idx)
+	{
+		switch (encoding)
+		{
+		case eCE_NATIVE:
+			return readNative(desc, bytes + idx * desc.typeSize);
+		case eCE_FLOAT32:
+			return reinterpret_cast<const float *>(bytes)[idx];
+		case eCE_FIXED16:
+			return reinterpret_cast<const int16_t *>(bytes)[idx] * desc.compactScale;
+		case eCE_ABSENT:
+			break;
+		}
+		return 0.0;
+	}
+
+	static
+	void
+	encodeValue(
+		const ChannelDescriptor &desc,
+		ChannelEncoding_E encoding,
+		uint8_t *bytes,
+		size_t idx,
+		double value)
+	{
+		switch (encoding)
+		{
+		case eCE_NATIVE:
+			writeNative(desc, bytes + idx * desc.typeSize, value);
+			break;
+		case eCE_FLOAT32:
+			reinterpret_cast<float *>(bytes)[idx] = static_cast<float>(value);
+			break;
+		case eCE_FIXED16:
+		{
+			// clamp so out of range values saturate rather than wrap
+			const double raw = std::round(value / desc.compactScale);
+			reinterpret_cast<int16_t *>(bytes)[idx] = static_cast<int16_t>(
+				std::clamp(raw, (double)INT16_MIN, (double)INT16_MAX));
+			break;
+		}
+		case eCE_ABSENT:
+			break;
+		}
+	}
+
+	TelemetryChunk::TelemetryChunk(
+		size_t nBytes,
+		uint8_t fill)
+	 : owned_(nBytes, fill)
+	 , external_(nullptr)
+	 , externalSize_(0)
+	 , backing_(nullptr)
+	 , loader_()
+	 , paged_(nullptr)
+	 , lazySize_(0)
+	 , isPaged_(false)
+	 , loaded_(true)
+	 , loadMutex_()
+	 , lastUse_(0)
+	{
+	}
+
+	TelemetryChunk::TelemetryChunk(
+		const uint8_t *begin,
+		const uint8_t *end)
+	 : owned_(begin, end)
+	 , external_(nullptr)
+	 , externalSize_(0)
+	 , backing_(nullptr)
+	 , loader_()
+	 , paged_(nullptr)
+	 , lazySize_(0)
+	 , isPaged_(false)
+	 , loaded_(true)
+	 , loadMutex_()
+	 , lastUse_(0)
+	{
+	}
+
+	TelemetryChunk::TelemetryChunk(
+		const uint8_t *external,
+		size_t nBytes,
+		std::shared_ptr<const void> backing)
+	 : owned_()
+	 , external_(external)
+	 , externalSize_(nBytes)
+	 , backing_(backing)
+	 , loader_()
+	 , paged_(nullptr)
+	 , lazySize_(0)
+	 , isPaged_(false)
+	 , loaded_(true)
+	 , loadMutex_()
+	 , lastUse_(0)
+	{
+	}
+
+	TelemetryChunk::TelemetryChunk(
+		size_t nBytes,
+		TelemetryChunkLoader loader)
+	 : owned_()
+	 , external_(nullptr)
+	 , externalSize_(0)
+	 , backing_(nullptr)
+	 , loader_(loader)
+	 , paged_(nullptr)
+	 , lazySize_(nBytes)
+	 , isPaged_(true)
+	 , loaded_(false)
+	 , loadMutex_()
+	 , lastUse_(0)
+	{
+	}
+
+	TelemetryChunk::TelemetryChunk(
+		const TelemetryChunk &other)
+	 : owned_()
+	 , external_(nullptr)
+	 , externalSize_(0)
+	 , backing_(nullptr)
+	 , loader_()
+	 , paged_(nullptr)
+	 , lazySize_(0)
+	 , isPaged_(false)
+	 , loaded_(true)
+	 , loadMutex_()
+	 , lastUse_(0)
+	{
+		TelemetryChunkPin pin;
+		const uint8_t *bytes = other.data(pin);
+		owned_.assign(bytes, bytes + other.size());
+	}
+
+	// global clock used to stamp chunks for LRU eviction
+	static std::atomic<uint64_t> CHUNK_USE_CLOCK(0);
+
+	const uint8_t *
+	TelemetryChunk::data(
+		TelemetryChunkPin &pin) const
+	{
+		if (external_)
+		{
+			pin = backing_;
+			return external_;
+		}
+		else if (isPaged_.load(std::memory_order_acquire))
+		{
+			auto bytes = load();
+			if (bytes)
+			{
+				pin = bytes;
+				return bytes->data();
+			}
+		}
+		pin.reset();
+		return owned_.data();
+	}
+
+	uint8_t *
+	TelemetryChunk::mutableData()
+	{
+		if (external_)
+		{
+			// take a private copy before the first write
+			owned_.assign(external_, external_ + externalSize_);
+			external_ = nullptr;
+			externalSize_ = 0;
+			backing_.reset();
+		}
+		else if (isPaged_.load(std::memory_order_acquire))
+		{
+			// values diverge from the loader's source from here on
+			auto bytes = load();
+			std::scoped_lock lock(loadMutex_);
+			if (bytes)
+			{
+				owned_.assign(bytes->begin(), bytes->end());
+			}
+			loader_ = nullptr;
+			paged_.reset();
+			loaded_.store(true, std::memory_order_release);
+			isPaged_.store(false, std::memory_order_release);
+		}
+		return owned_.data();
+	}
+
+	size_t
+	TelemetryChunk::size() const
+	{
+		if (external_)
+		{
+			return externalSize_;
+		}
+		return (isPaged_.load(std::memory_order_acquire) ? lazySize_ : owned_.size());
+	}
+
+	void
+	TelemetryChunk::resize(
+		size_t nBytes,
+		uint8_t fill)
+	{
+		mutableData();
+		owned_.resize(nBytes, fill);
+	}
+
+	bool
+	TelemetryChunk::isExternal() const
+	{
+		return external_ != nullptr;
+	}
+
+	bool
+	TelemetryChunk::isLoaded() const
+	{
+		return loaded_.load(std::memory_order_acquire);
+	}
+
+	bool
+	TelemetryChunk::isPaged() const
+	{
+		return isPaged_.load(std::memory_order_acquire);
+	}
+
+	void
+	TelemetryChunk::prefetch() const
+	{
+		if ( ! loaded_.load(std::memory_order_acquire))
+		{
+			load();
+		}
+	}
+
+	bool
+	TelemetryChunk::evict()
+	{
+		if ( ! isPaged_.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		// pins are only handed out under the lock, so one can't be taken
+		// while we check that nobody else holds the values
+		std::scoped_lock lock(loadMutex_);
+		if ( ! paged_ || paged_.use_count() > 1)
+		{
+			return false;
+		}
+		paged_.reset();
+		loaded_.store(false, std::memory_order_release);
+		return true;
+	}
+
+	uint64_t
+	TelemetryChunk::lastUse() const
+	{
+		return lastUse_.load(std::memory_order_relaxed);
+	}
+
+	void
+	TelemetryChunk::touch() const
+	{
+		lastUse_.store(CHUNK_USE_CLOCK++, std::memory_order_relaxed);
+	}
+
+	bool
+	TelemetryChunk::operator==(
+		const TelemetryChunk &other) const
+	{
+		const uint8_t *bytes = nullptr;
+		const uint8_t *otherBytes = nullptr;
+		TelemetryChunkPin pin;
+		TelemetryChunkPin otherPin;
+		if ( ! residentData(bytes, pin) || ! other.residentData(otherBytes, otherPin))
+		{
+			return false;
+		}
+		return size() == other.size() && std::memcmp(bytes, otherBytes, size()) == 0;
+	}
+
+	std::shared_ptr<const TelemetryChunk::PagedBytes>
+	TelemetryChunk::load() const
+	{
+		std::scoped_lock lock(loadMutex_);
+		if ( ! loader_)
+		{
+			// values were taken over by mutableData()
+			return nullptr;
+		}
+		else if (paged_)
+		{
+			// already resident, or another thread beat us to it
+			return paged_;
+		}
+
+		auto bytes = std::make_shared<PagedBytes>(lazySize_);
+		if ( ! loader_(bytes->data(), lazySize_))
+		{
+			spdlog::error("failed to load telemetry chunk. values will read as zero.");
+			std::fill(bytes->begin(), bytes->end(), 0);
+		}
+		paged_ = std::move(bytes);
+		touch();
+		loaded_.store(true, std::memory_order_release);
+		return paged_;
+	}
+
+	bool
+	TelemetryChunk::residentData(
+		const uint8_t *&bytes,
+		TelemetryChunkPin &pin) const
+	{
+		if (isPaged_.load(std::memory_order_acquire))
+		{
+			std::scoped_lock lock(loadMutex_);
+			if (paged_)
+			{
+				pin = paged_;
+				bytes = paged_->data();
+				return true;
+			}
+			else if (loader_)
+			{
+				return false;
+			}
+		}
+		bytes = data(pin);
+		return true;
+	}
+
+	/**
+	 * @return
+	 * number of samples held by a chunk within a container of 'nSamples'
+	 */
+	static
+	size_t
+	samplesInChunk(
+		size_t nSamples,
+		size_t chunkIdx)
+	{
+		return std::min(TELEM_CHUNK_SIZE, nSamples - chunkIdx * TELEM_CHUNK_SIZE);
+	}
+
+	static
+	size_t
+	chunkCountFor(
+		size_t nSamples)
+	{
+		return (nSamples + TELEM_CHUNK_SIZE - 1) >> TELEM_CHUNK_SHIFT;
+	}
+
+	TelemetryColumns::TelemetryColumns()
+	 : size_(0)
+	 , compact_(false)
+	 , avail_()
+	 , columns_()
+	{
+		for (auto &column : columns_)
+		{
+			column.encoding = eCE_NATIVE;
+		}
+	}
+
+	TelemetryColumns::TelemetryColumns(
+		const TelemetrySamples &samples)
+	 : TelemetryColumns()
+	{
+		assign(samples);
+	}
+
+	void
+	TelemetryColumns::assign(
+		const TelemetrySamples &samples)
+	{
+		const size_t nChunks = chunkCountFor(samples.size());
+		const auto *sampBytes = reinterpret_cast<const uint8_t *>(samples.data());
+		for (const auto &desc : CHANNEL_DESCRIPTORS)
+		{
+			auto &column = columns_[desc.channel];
+			const auto encoding = targetEncoding(desc);
+			const size_t elemSize = getEncodedSize(desc, encoding);
+			std::vector<TelemetryChunkPtr> newChunks;
+			if (encoding != eCE_ABSENT)
+			{
+				newChunks.resize(nChunks);
+			}
+
+			TelemetryChunk encoded;
+			for (size_t c=0; c<newChunks.size(); c++)
+			{
+				const size_t nInChunk = samplesInChunk(samples.size(), c);
+				const uint8_t *src = sampBytes + c * TELEM_CHUNK_SIZE * sizeof(TelemetrySample) + desc.sampleOffset;
+				encoded.resize(nInChunk * elemSize);
+				for (size_t i=0; i<nInChunk; i++)
+				{
+					if (encoding == eCE_NATIVE)
+					{
+						std::memcpy(encoded.mutableData() + i * elemSize, src, elemSize);
+					}
+					else
+					{
+						encodeValue(desc, encoding, encoded.mutableData(), i, readNative(desc, src));
+					}
+					src += sizeof(TelemetrySample);
+				}
+
+				// hold onto the existing chunk if nothing changed so that it
+				// remains shared with any duplicates/backups
+				const bool canReuse =
+					column.encoding == encoding &&
+					c < column.chunks.size() &&
+					*column.chunks[c] == encoded;
+				newChunks[c] = (canReuse ? column.chunks[c] : std::make_shared<TelemetryChunk>(encoded));
+			}
+			column.encoding = encoding;
+			column.chunks = std::move(newChunks);
+		}
+		size_ = samples.size();
+	}
+
+	void
+	TelemetryColumns::toSamples(
+		TelemetrySamples &samplesOut) const
+	{
+		samplesOut.resize(size_);
+		auto *sampBytes = reinterpret_cast<uint8_t *>(samplesOut.data());
+		for (const auto &desc : CHANNEL_DESCRIPTORS)
+		{
+			const auto &column = columns_[desc.channel];
+			if (column.encoding == eCE_ABSENT)
+			{
+				uint8_t *dst = sampBytes + desc.sampleOffset;
+				for (size_t i=0; i<size_; i++)
+				{
+					writeNative(desc, dst, 0.0);
+					dst += sizeof(TelemetrySample);
+				}
+				continue;
+			}
+
+			for (size_t c=0; c<column.chunks.size(); c++)
+			{
+				const size_t nInChunk = samplesInChunk(size_, c);
+				TelemetryChunkPin pin;
+				const uint8_t *src = column.chunks[c]->data(pin);
+				uint8_t *dst = sampBytes + c * TELEM_CHUNK_SIZE * sizeof(TelemetrySample) + desc.sampleOffset;
+				for (size_t i=0; i<nInChunk; i++)
+				{
+					if (column.encoding == eCE_NATIVE)
+					{
+						std::memcpy(dst, src + i * desc.typeSize, desc.typeSize);
+					}
+					else
+					{
+						writeNative(desc, dst, decodeValue(desc, column.encoding, src, i));
+					}
+					dst += sizeof(TelemetrySample);
+				}
+			}
+		}
+	}
+
+	TelemetrySample
+	TelemetryColumns::sampleAt(
+		size_t idx) const
+	{
+		if (idx >= size_)
+		{
+			throw std::out_of_range(
+				"sample index " + std::to_string(idx) + " is out of range (size = " + std::to_string(size_) + ")");
+		}
+
+		TelemetrySample samp;
+		std::memset(&samp, 0, sizeof(samp));
+		auto *sampBytes = reinterpret_cast<uint8_t *>(&samp);
+		for (const auto &desc : CHANNEL_DESCRIPTORS)
+		{
+			writeNative(desc, sampBytes + desc.sampleOffset, getValue(desc.channel, idx));
+		}
+		return samp;
+	}
+
+	void
+	TelemetryColumns::setSample(
+		size_t idx,
+		const TelemetrySample &samp)
+	{
+		if (idx >= size_)
+		{
+			throw std::out_of_range(
+				"sample index " + std::to_string(idx) + " is out of range (size = " + std::to_string(size_) + ")");
+		}
+
+		const auto *sampBytes = reinterpret_cast<const uint8_t *>(&samp);
+		for (const auto &desc : CHANNEL_DESCRIPTORS)
+		{
+			if (columns_[desc.channel].encoding == eCE_ABSENT && targetEncoding(desc) == eCE_ABSENT)
+			{
+				// dropped from compact storage, so there's nothing to keep
+				continue;
+			}
+			setValue(desc.channel, idx, readNative(desc, sampBytes + desc.sampleOffset));
+		}
+	}
+
+	void
+	TelemetryColumns::copyChannel(
+		TelemetryChannel_E channel,
+		const TelemetryColumns &src,
+		size_t srcStartIdx,
+		size_t dstStartIdx,
+		size_t nSamples)
+	{
+		const auto &desc = getChannelDescriptor(channel);
+		const auto &srcColumn = src.columns_[channel];
+		auto &dstColumn = columns_[channel];
+		allocateChannel(channel);
+
+		if (srcColumn.encoding != dstColumn.encoding)
+		{
+			for (size_t i=0; i<nSamples; i++)
+			{
+				setValue(channel, dstStartIdx + i, src.getValue(channel, srcStartIdx + i));
+			}
+			return;
+		}
+
+		// same encoding, so we can copy (or share) bytes directly
+		const size_t elemSize = getEncodedSize(desc, dstColumn.encoding);
+		size_t srcIdx = srcStartIdx;
+		size_t dstIdx = dstStartIdx;
+		size_t remaining = nSamples;
+		while (remaining > 0)
+		{
+			const size_t srcChunkIdx = srcIdx >> TELEM_CHUNK_SHIFT;
+			const size_t dstChunkIdx = dstIdx >> TELEM_CHUNK_SHIFT;
+			const size_t srcLocal = srcIdx & TELEM_CHUNK_MASK;
+			const size_t dstLocal = dstIdx & TELEM_CHUNK_MASK;
+			const size_t len = std::min({
+				remaining,
+				TELEM_CHUNK_SIZE - srcLocal,
+				TELEM_CHUNK_SIZE - dstLocal});
+
+			const auto &srcChunk = srcColumn.chunks[srcChunkIdx];
+			const bool wholeChunk =
+				srcLocal == 0 && dstLocal == 0 &&
+				srcChunk->size() == len * elemSize &&
+				samplesInChunk(size_, dstChunkIdx) == len;
+			if (wholeChunk)
+			{
+				dstColumn.chunks[dstChunkIdx] = srcChunk;
+			}
+			else
+			{
+				TelemetryChunkPin pin;
+				std::memcpy(
+					mutableChunk(channel, dstChunkIdx).mutableData() + dstLocal * elemSize,
+					srcChunk->data(pin) + srcLocal * elemSize,
+					len * elemSize);
+			}
+
+			srcIdx += len;
+			dstIdx += len;
+			remaining -= len;
+		}
+	}
+
+	void
+	TelemetryColumns::resetLayout(
+		size_t nSamples,
+		bool compact,
+		const DataAvailableBitSet &avail)
+	{
+		for (auto &column : columns_)
+		{
+			column.encoding = eCE_ABSENT;
+			column.chunks.clear();
+		}
+		size_ = nSamples;
+		compact_ = compact;
+		avail_ = avail;
+	}
+
+	void
+	TelemetryColumns::setChannelChunks(
+		TelemetryChannel_E channel,
+		ChannelEncoding_E encoding,
+		std::vector<TelemetryChunkPtr> chunks)
+	{
+		const auto &desc = getChannelDescriptor(channel);
+		const size_t elemSize = getEncodedSize(desc, encoding);
+		const size_t expectedChunks = (encoding == eCE_ABSENT ? 0 : chunkCountFor(size_));
+		bool okay = chunks.size() == expectedChunks;
+		for (size_t c=0; okay && c<chunks.size(); c++)
+		{
+			okay = chunks[c] && chunks[c]->size() == samplesInChunk(size_, c) * elemSize;
+		}
+		if ( ! okay)
+		{
+			throw std::runtime_error(
+				std::string("chunk layout doesn't match container for channel '") + desc.name + "'");
+		}
+
+		auto &column = columns_[channel];
+		column.encoding = encoding;
+		column.chunks = std::move(chunks);
+	}
+
+	const TelemetryChunkPtr &
+	TelemetryColumns::getChunk(
+		TelemetryChannel_E channel,
+		size_t chunkIdx) const
+	{
+		const auto &chunk = columns_[channel].chunks[chunkIdx];
+		if (chunk->isPaged())
+		{
+			chunk->touch();
+		}
+		return chunk;
+	}
+
+	void
+	TelemetryColumns::setCompact(
+		bool compact,
+		const DataAvailableBitSet &avail)
+	{
+		compact_ = compact;
+		avail_ = avail;
+		for (const auto &desc : CHANNEL_DESCRIPTORS)
+		{
+			setEncoding(desc.channel, targetEncoding(desc));
+		}
+	}
+
+	bool
+	TelemetryColumns::isCompact() const
+	{
+		return compact_;
+	}
+
+	void
+	TelemetryColumns::setDataAvailable(
+		const DataAvailableBitSet &avail)
+	{
+		avail_ = avail;
+		for (const auto &desc : CHANNEL_DESCRIPTORS)
+		{
+			// loaders leave channels that weren't in the file absent, even
+			// when the container isn't compact
+			if (desc.availBit < 0 || avail_.test(desc.availBit))
+			{
+				allocateChannel(desc.channel);
+			}
+		}
+	}
+
+	ChannelEncoding_E
+	TelemetryColumns::getEncoding(
+		TelemetryChannel_E channel) const
+	{
+		return columns_[channel].encoding;
+	}
+
+	void
+	TelemetryColumns::resize(
+		size_t nSamples)
+	{
+		const size_t nChunks = chunkCountFor(nSamples);
+		for (const auto &desc : CHANNEL_DESCRIPTORS)
+		{
+			auto &column = columns_[desc.channel];
+			if (column.encoding == eCE_ABSENT)
+			{
+				continue;
+			}
+
+			const size_t elemSize = getEncodedSize(desc, column.encoding);
+			const size_t prevChunks = column.chunks.size();
+			column.chunks.resize(nChunks);
+			// the old last chunk may need to grow/shrink. clone it if shared.
+			if (prevChunks > 0 && prevChunks <= nChunks)
+			{
+				const size_t lastIdx = prevChunks - 1;
+				if (column.chunks[lastIdx]->size() != samplesInChunk(nSamples, lastIdx) * elemSize)
+				{
+					if (column.chunks[lastIdx].use_count() > 1)
+					{
+						column.chunks[lastIdx] = std::make_shared<TelemetryChunk>(*column.chunks[lastIdx]);
+					}
+					column.chunks[lastIdx]->resize(samplesInChunk(nSamples, lastIdx) * elemSize, 0);
+				}
+			}
+			else if (nChunks > 0 && nChunks < prevChunks)
+			{
+				const size_t lastIdx = nChunks - 1;
+				const size_t lastSize = samplesInChunk(nSamples, lastIdx) * elemSize;
+				if (column.chunks[lastIdx]->size() != lastSize)
+				{
+					TelemetryChunkPin pin;
+					const uint8_t *bytes = column.chunks[lastIdx]->data(pin);
+					column.chunks[lastIdx] = std::make_shared<TelemetryChunk>(bytes, bytes + lastSize);
+				}
+			}
+			for (size_t c=prevChunks; c<nChunks; c++)
+			{
+				column.chunks[c] = std::make_shared<TelemetryChunk>(samplesInChunk(nSamples, c) * elemSize, 0);
+			}
+		}
+		size_ = nSamples;
+	}
+
+	void
+	TelemetryColumns::clear()
+	{
+		for (auto &column : columns_)
+		{
+			column.chunks.clear();
+		}
+		size_ = 0;
+	}
+
+	size_t
+	TelemetryColumns::size() const
+	{
+		return size_;
+	}
+
+	bool
+	TelemetryColumns::empty() const
+	{
+		return size_ == 0;
+	}
+
+	size_t
+	TelemetryColumns::size_bytes() const
+	{
+		size_t bytes = 0;
+		for (const auto &column : columns_)
+		{
+			for (const auto &chunk : column.chunks)
+			{
+				bytes += chunk->size();
+			}
+		}
+		return bytes;
+	}
+
+	size_t
+	TelemetryColumns::sharedChunkCount() const
+	{
+		size_t count = 0;
+		for (const auto &column : columns_)
+		{
+			for (const auto &chunk : column.chunks)
+			{
+				count += (chunk.use_count() > 1 ? 1 : 0);
+			}
+		}
+		return count;
+	}
+
+	size_t
+	TelemetryColumns::pagedResidentBytes() const
+	{
+		size_t bytes = 0;
+		for (const auto &column : columns_)
+		{
+			for (const auto &chunk : column.chunks)
+			{
+				bytes += (chunk->isPaged() && chunk->isLoaded() ? chunk->size() : 0);
+			}
+		}
+		return bytes;
+	}
+
+	size_t
+	TelemetryColumns::trimPaged(
+		size_t maxBytes)
+	{
+		std::vector<TelemetryChunk *> resident;
+		size_t residentBytes = 0;
+		for (const auto &column : columns_)
+		{
+			for (const auto &chunk : column.chunks)
+			{
+				if (chunk->isPaged() && chunk->isLoaded())
+				{
+					resident.push_back(chunk.get());
+					residentBytes += chunk->size();
+				}
+			}
+		}
+		if (residentBytes <= maxBytes)
+		{
+			return 0;
+		}
+
+		std::sort(resident.begin(), resident.end(), [](const auto *a, const auto *b){
+			return a->lastUse() < b->lastUse();
+		});
+		size_t evictedBytes = 0;
+		for (auto *chunk : resident)
+		{
+			if (residentBytes - evictedBytes <= maxBytes)
+			{
+				break;
+			}
+			// pinned chunks stay put until their readers are done
+			evictedBytes += (chunk->evict() ? chunk->size() : 0);
+		}
+		return evictedBytes;
+	}
+
+	size_t
+	TelemetryColumns::prefetch(
+		size_t begin,
+		size_t end) const
+	{
+		std::vector<const TelemetryChunk *> toLoad;
+		for (const auto *chunk : pagedChunks(begin, end))
+		{
+			if (chunk->isLoaded())
+			{
+				chunk->touch();
+			}
+			else
+			{
+				toLoad.push_back(chunk);
+			}
+		}
+
+		size_t loadedBytes = 0;
+		#pragma omp parallel for reduction(+:loadedBytes)
+		for (size_t i=0; i<toLoad.size(); i++)
+		{
+			toLoad[i]->prefetch();
+			loadedBytes += toLoad[i]->size();
+		}
+		return loadedBytes;
+	}
+
+	std::vector<TelemetryChunkPin>
+	TelemetryColumns::pin(
+		size_t begin,
+		size_t end) const
+	{
+		const auto chunks = pagedChunks(begin, end);
+		std::vector<TelemetryChunkPin> pins(chunks.size());
+		#pragma omp parallel for
+		for (size_t i=0; i<chunks.size(); i++)
+		{
+			chunks[i]->data(pins[i]);
+			chunks[i]->touch();
+		}
+		return pins;
+	}
+
+	std::vector<TelemetryChunkPtr>
+	TelemetryColumns::unloadedChunks() const
+	{
+		std::vector<TelemetryChunkPtr> chunks;
+		const size_t nChunks = chunkCountFor(size_);
+		for (size_t c=0; c<nChunks; c++)
+		{
+			for (const auto &column : columns_)
+			{
+				if (c < column.chunks.size() && ! column.chunks[c]->isLoaded())
+				{
+					chunks.push_back(column.chunks[c]);
+				}
+			}
+		}
+		return chunks;
+	}
+
+	size_t
+	TelemetryColumns::unloadedChunkCount() const
+	{
+		size_t count = 0;
+		for (const auto &column : columns_)
+		{
+			for (const auto &chunk : column.chunks)
+			{
+				count += (chunk->isLoaded() ? 0 : 1);
+			}
+		}
+		return count;
+	}
+
+	ChannelEncoding_E
+	TelemetryColumns::targetEncoding(
+		const ChannelDescriptor &desc) const
+	{
+		if (compact_ && desc.availBit >= 0 && ! avail_.test(desc.availBit))
+		{
+			return eCE_ABSENT;
+		}
+		return storedEncoding(desc);
+	}
+
+	ChannelEncoding_E
+	TelemetryColumns::storedEncoding(
+		const ChannelDescriptor &desc) const
+	{
+		if ( ! compact_)
+		{
+			return eCE_NATIVE;
+		}
+		else if (getEncodedSize(desc, desc.compactEncoding) >= desc.typeSize)
+		{
+			// quantizing wouldn't save anything (ie. float -> float32)
+			return eCE_NATIVE;
+		}
+		return desc.compactEncoding;
+	}
+
+	void
+	TelemetryColumns::allocateChannel(
+		TelemetryChannel_E channel)
+	{
+		if (columns_[channel].encoding == eCE_ABSENT)
+		{
+			setEncoding(channel, storedEncoding(getChannelDescriptor(channel)));
+		}
+	}
+
+	void
+	TelemetryColumns::setEncoding(
+		TelemetryChannel_E channel,
+		ChannelEncoding_E encoding)
+	{
+		auto &column = columns_[channel];
+		if (column.encoding == encoding)
+		{
+			return;
+		}
+
+		const auto &desc = getChannelDescriptor(channel);
+		const size_t elemSize = getEncodedSize(desc, encoding);
+		std::vector<TelemetryChunkPtr> newChunks;
+		if (encoding != eCE_ABSENT)
+		{
+			newChunks.resize(chunkCountFor(size_));
+		}
+		for (size_t c=0; c<newChunks.size(); c++)
+		{
+			const size_t nInChunk = samplesInChunk(size_, c);
+			auto newChunk = std::make_shared<TelemetryChunk>(nInChunk * elemSize, 0);
+			if (column.encoding != eCE_ABSENT)
+			{
+				TelemetryChunkPin pin;
+				const uint8_t *src = column.chunks[c]->data(pin);
+				for (size_t i=0; i<nInChunk; i++)
+				{
+					encodeValue(
+						desc,
+						encoding,
+						newChunk->mutableData(),
+						i,
+						decodeValue(desc, column.encoding, src, i));
+				}
+			}
+			newChunks[c] = newChunk;
+		}
+		column.encoding = encoding;
+		column.chunks = std::move(newChunks);
+	}
+
+	std::vector<const TelemetryChunk *>
+	TelemetryColumns::pagedChunks(
+		size_t begin,
+		size_t end) const
+	{
+		std::vector<const TelemetryChunk *> chunks;
+		end = std::min(end, size_);
+		if (begin >= end)
+		{
+			return chunks;
+		}
+
+		const size_t firstChunk = begin >> TELEM_CHUNK_SHIFT;
+		const size_t lastChunk = (end - 1) >> TELEM_CHUNK_SHIFT;
+		for (size_t c=firstChunk; c<=lastChunk; c++)
+		{
+			for (const auto &column : columns_)
+			{
+				if (c < column.chunks.size() && column.chunks[c]->isPaged())
+				{
+					chunks.push_back(column.chunks[c].get());
+				}
+			}
+		}
+		return chunks;
+	}
+
+	TelemetryChunk &
+	TelemetryColumns::mutableChunk(
+		TelemetryChannel_E channel,
+		size_t chunkIdx)
+	{
+		auto &chunk = columns_[channel].chunks[chunkIdx];
+		if (chunk.use_count() > 1)
+		{
+			// copy-on-write
+			chunk = std::make_shared<TelemetryChunk>(*chunk);
+		}
+		return *chunk;
+	}
+
+	double
+	TelemetryColumns::getValue(
+		TelemetryChannel_E channel,
+		size_t idx) const
+	{
+		const auto &column = columns_[channel];
+		if (column.encoding == eCE_ABSENT)
+		{
+			return 0.0;
+		}
+		TelemetryChunkPin pin;
+		return decodeValue(
+			getChannelDescriptor(channel),
+			column.encoding,
+			column.chunks[idx >> TELEM_CHUNK_SHIFT]->data(pin),
+			idx & TELEM_CHUNK_MASK);
+	}
+
+	void
+	TelemetryColumns::setValue(
+		TelemetryChannel_E channel,
+		size_t idx,
+		double value)
+	{
+		// channel is about to hold real data, so it needs storage
+		allocateChannel(channel);
+		encodeValue(
+			getChannelDescriptor(channel),
+			columns_[channel].encoding,
+			mutableChunk(channel, idx >> TELEM_CHUNK_SHIFT).mutableData(),
+			idx & TELEM_CHUNK_MASK,
+			value);
+	}
+}
@@ -1,8 +1,12 @@
 #include "GoProOverlay/data/TelemetrySeeker.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <stdexcept>
 
 #include "GoProOverlay/data/DataSource.h"
+#include "GoProOverlay/data/TimeIndex.hpp"
 
 namespace gpo
 {
@@ -12,7 +16,12 @@ namespace gpo
 	 , seekedIdx_(0)
 	 , alignmentIdx_(0)
 	 , rate_hz_(0.0)
-	 , lapIndicesMap_()
+	 , pagedChunkIdx_(-1)
+	 , lapIndices_()
+	 , sectorIndices_()
+	 , sectorsPerLap_(0)
+	 , clockRate_hz_(0.0)
+	 , clockSchedule_()
 	{
 	}
 
@@ -22,6 +31,12 @@ namespace gpo
 		return dataSrc_.lock()->getSourceName();
 	}
 
+	TelemetrySourcePtr
+	TelemetrySeeker::getTelemetrySource() const
+	{
+		return dataSrc_.lock()->telemSrc;
+	}
+
 	void
 	TelemetrySeeker::prev()
 	{
@@ -29,6 +44,7 @@ namespace gpo
 		{
 			seekedIdx_--;
 		}
+		pageAroundSeek();
 	}
 
 	void
@@ -38,6 +54,7 @@ namespace gpo
 		{
 			seekedIdx_++;
 		}
+		pageAroundSeek();
 	}
 
 	bool
@@ -61,6 +78,7 @@ namespace gpo
 			throw std::out_of_range("idx " + std::to_string(idx) + " is > size of " + std::to_string(size()));
 		}
 		seekedIdx_ = idx;
+		pageAroundSeek();
 	}
 
 	void
@@ -103,6 +121,7 @@ namespace gpo
 				seekedIdx_ -= amount;
 			}
 		}
+		pageAroundSeek();
 	}
 
 	void
@@ -113,21 +132,30 @@ namespace gpo
 		auto quantize = [](double value, double quanta){
 			return std::round(value / quanta) * quanta;
 		};
-		auto currTimeOffset = quantize(getTimeAt(seekedIdx_),quanta_secs);
+		auto dSrc = dataSrc_.lock();
+		const auto tOffsets = dSrc->columns_->channel<double>(eTC_T_OFFSET);
+		const auto nSamps = tOffsets.size();
+		auto index = makeTimeIndex(nSamps, [&](size_t idx){
+			return quantize(tOffsets[idx],quanta_secs);
+		});
+
+		auto currTimeOffset = quantize(tOffsets[seekedIdx_],quanta_secs);
 		const auto targetTimeOffset = quantize(currTimeOffset + offset_secs,quanta_secs);
-		const auto maxTimeOffset = getTimeAt(size() - 1);
+		const auto maxTimeOffset = tOffsets[nSamps - 1];
 		if (offset_secs > 0.0)
 		{
 			if (targetTimeOffset < maxTimeOffset)
 			{
-				while (currTimeOffset < targetTimeOffset)
-				{
-					currTimeOffset = quantize(getTimeAt(++seekedIdx_),quanta_secs);
-				}
+				// first sample at or after the target, which is one past the
+				// last sample that's strictly before it. never step backwards
+				// if the offset quantized away to nothing.
+				const auto justBefore = std::nextafter(targetTimeOffset, -std::numeric_limits<double>::infinity());
+				const auto firstAfter = std::min(index.floorIndex(justBefore) + 1, nSamps - 1);
+				seekedIdx_ = std::max(firstAfter, seekedIdx_);
 			}
 			else
 			{
-				seekedIdx_ = size() - 1;
+				seekedIdx_ = nSamps - 1;
 			}
 		}
 		else
@@ -138,26 +166,44 @@ namespace gpo
 			}
 			else
 			{
-				while (currTimeOffset > targetTimeOffset)
-				{
-					currTimeOffset = quantize(getTimeAt(--seekedIdx_),quanta_secs);
-				}
+				seekedIdx_ = std::min(index.floorIndex(targetTimeOffset), seekedIdx_);
 			}
 		}
+		pageAroundSeek();
 	}
 
 	void
 	TelemetrySeeker::seekToLapEntry(
 		unsigned int lap)
 	{
-		seekedIdx_ = lapIndicesMap_.at(lap).entryIdx;
+		seekedIdx_ = lapIndices(lap).entryIdx;
+		pageAroundSeek();
 	}
 	
 	void
 	TelemetrySeeker::seekToLapExit(
 		unsigned int lap)
 	{
-		seekedIdx_ = lapIndicesMap_.at(lap).exitIdx;
+		seekedIdx_ = lapIndices(lap).exitIdx;
+		pageAroundSeek();
+	}
+
+	void
+	TelemetrySeeker::seekToSectorEntry(
+		unsigned int lap,
+		unsigned int sector)
+	{
+		seekedIdx_ = sectorIndices(lap,sector).entryIdx;
+		pageAroundSeek();
+	}
+
+	void
+	TelemetrySeeker::seekToSectorExit(
+		unsigned int lap,
+		unsigned int sector)
+	{
+		seekedIdx_ = sectorIndices(lap,sector).exitIdx;
+		pageAroundSeek();
 	}
 	
 	size_t
@@ -169,13 +215,43 @@ namespace gpo
 	size_t
 	TelemetrySeeker::size() const
 	{
-		return dataSrc_.lock()->samples_->size();
+		return dataSrc_.lock()->columns_->size();
 	}
 
 	unsigned int
 	TelemetrySeeker::lapCount() const
 	{
-		return static_cast<unsigned int>(lapIndicesMap_.size());
+		// the table is sized by the highest lap number, which can include
+		// gaps for laps that never showed up in the data
+		return static_cast<unsigned int>(std::count_if(
+			lapIndices_.begin(),
+			lapIndices_.end(),
+			[](const LapIndices &li){ return li.valid(); }));
+	}
+
+	unsigned int
+	TelemetrySeeker::sectorCount() const
+	{
+		return sectorsPerLap_;
+	}
+
+	bool
+	TelemetrySeeker::hasLap(
+		unsigned int lap) const
+	{
+		return lap != 0 && lap <= lapIndices_.size() && lapIndices_[lap - 1].valid();
+	}
+
+	bool
+	TelemetrySeeker::hasSector(
+		unsigned int lap,
+		unsigned int sector) const
+	{
+		if (lap == 0 || lap > lapIndices_.size() || sector == 0 || sector > sectorsPerLap_)
+		{
+			return false;
+		}
+		return sectorIndices_[(lap - 1) * sectorsPerLap_ + (sector - 1)].valid();
 	}
 
 	double
@@ -188,22 +264,35 @@ namespace gpo
 	TelemetrySeeker::getTimeAt(
 		size_t idx) const
 	{
-		return dataSrc_.lock()->telemSrc->at(idx).t_offset;
+		return dataSrc_.lock()->columns_->channel<double>(eTC_T_OFFSET)[idx];
 	}
 
 	std::pair<size_t, size_t>
 	TelemetrySeeker::getLapEntryExit(
 		unsigned int lap) const
 	{
-		auto &li = lapIndicesMap_.at(lap);
+		auto &li = lapIndices(lap);
 		return {li.entryIdx,li.exitIdx};
 	}
 
+	std::pair<size_t, size_t>
+	TelemetrySeeker::getSectorEntryExit(
+		unsigned int lap,
+		unsigned int sector) const
+	{
+		auto &si = sectorIndices(lap,sector);
+		return {si.entryIdx,si.exitIdx};
+	}
+
 	// forces seeker to analyze samples and find lap/sector seek points again
 	void
 	TelemetrySeeker::analyze()
 	{
-		lapIndicesMap_.clear();
+		// telemetry may have been replaced, so page on the next move
+		pagedChunkIdx_ = -1;
+		lapIndices_.clear();
+		sectorIndices_.clear();
+		sectorsPerLap_ = 0;
 
 		rate_hz_ = 0.0;
 		if (size() >= 2)
@@ -212,37 +301,254 @@ namespace gpo
 			rate_hz_ = static_cast<double>(cycles) / getTimeAt(cycles);
 		}
 
+		// the first time a lap is seen wins (ie. autocross runs that each
+		// start back at lap 1)
+		auto addLap = [this](int lap, const LapIndices &li){
+			if (lap > (int)lapIndices_.size())
+			{
+				lapIndices_.resize(lap);
+			}
+			if ( ! lapIndices_[lap - 1].valid())
+			{
+				lapIndices_[lap - 1] = li;
+			}
+		};
+
+		// sectors are collected as they're found and laid out into the
+		// dense table once the most sectors per lap is known
+		struct FoundSector
+		{
+			unsigned int lap;
+			unsigned int sector;
+			LapIndices si;
+		};
+		std::vector<FoundSector> foundSectors;
+
 		LapIndices li;
 		int prevSampLap = -1;
 		int lapWereIn = -1;
+		LapIndices si;
+		int prevSampSector = -1;
+		int sectorWereIn = -1;
+		int sectorsLap = -1;
 		auto dataSrcPtr = dataSrc_.lock();
-		for (size_t i=0; i<size(); i++)
+		const auto laps = dataSrcPtr->columns_->channel<int>(eTC_CALC_LAP);
+		const auto sectors = dataSrcPtr->columns_->channel<int>(eTC_CALC_SECTOR);
+		for (size_t i=0; i<laps.size(); i++)
 		{
-			const auto &trackData = dataSrcPtr->samples_->at(i).calcSamp;
-			if (prevSampLap == -1 && trackData.lap > 0)
+			const int lap = laps[i];
+			if (prevSampLap == -1 && lap > 0)
 			{
 				// entered a lap
-				lapWereIn = trackData.lap;
+				lapWereIn = lap;
 				li.entryIdx = i;
 				li.exitIdx = -1;
 			}
-			else if (lapWereIn != -1 && prevSampLap != trackData.lap)
+			else if (lapWereIn != -1 && prevSampLap != lap)
 			{
 				// exited a lap
 				li.exitIdx = i - 1;
-				lapIndicesMap_.insert({lapWereIn,li});
+				addLap(lapWereIn,li);
 
-				lapWereIn = trackData.lap;
+				lapWereIn = lap;
 				li.entryIdx = i;// circuit case where finishGate == startGate
 			}
-			prevSampLap = trackData.lap;
+			prevSampLap = lap;
+
+			// sectors are numbered within the lap they were entered in.
+			// anything driven outside of a lap can't be looked up, so it's
+			// not tracked.
+			const int sector = sectors[i];
+			if (sector != prevSampSector)
+			{
+				if (sectorWereIn > 0 && sectorsLap > 0)
+				{
+					// exited a sector
+					si.exitIdx = i - 1;
+					foundSectors.push_back({(unsigned int)sectorsLap,(unsigned int)sectorWereIn,si});
+				}
+
+				// entered a sector (or left them all if it's not positive)
+				sectorWereIn = sector;
+				sectorsLap = lap;
+				si.entryIdx = i;
+				si.exitIdx = -1;
+			}
+			prevSampSector = sector;
 		}
 
 		// corner case where we never left a lap (could have pitted in early or something)
 		if (lapWereIn != -1)
 		{
 			li.exitIdx = size() - 1;
-				lapIndicesMap_.insert({lapWereIn,li});
+			addLap(lapWereIn,li);
+		}
+		if (sectorWereIn > 0 && sectorsLap > 0)
+		{
+			si.exitIdx = size() - 1;
+			foundSectors.push_back({(unsigned int)sectorsLap,(unsigned int)sectorWereIn,si});
+		}
+
+		for (const auto &fs : foundSectors)
+		{
+			sectorsPerLap_ = std::max(sectorsPerLap_, fs.sector);
+		}
+		sectorIndices_.resize(lapIndices_.size() * sectorsPerLap_);
+		for (const auto &fs : foundSectors)
+		{
+			if (fs.lap > lapIndices_.size())
+			{
+				// sector outlived the lap's bookkeeping (shouldn't happen)
+				continue;
+			}
+			auto &entry = sectorIndices_[(fs.lap - 1) * sectorsPerLap_ + (fs.sector - 1)];
+			if ( ! entry.valid())
+			{
+				entry = fs.si;
+			}
+		}
+
+		clockSchedule_ = makeClockSchedule(clockRate_hz_);
+	}
+
+	void
+	TelemetrySeeker::setClockRate(
+		double rate_hz)
+	{
+		clockRate_hz_ = std::max(rate_hz, 0.0);
+		clockSchedule_ = makeClockSchedule(clockRate_hz_);
+	}
+
+	double
+	TelemetrySeeker::clockRate() const
+	{
+		return clockRate_hz_;
+	}
+
+	size_t
+	TelemetrySeeker::clockTickCount() const
+	{
+		return clockSchedule_ ? clockSchedule_->idxAtTick.size() : 0;
+	}
+
+	size_t
+	TelemetrySeeker::clockTickOf(
+		size_t idx) const
+	{
+		if ( ! clockSchedule_ || clockSchedule_->tickOfIdx.empty())
+		{
+			return 0;
+		}
+		const auto &tickOfIdx = clockSchedule_->tickOfIdx;
+		return tickOfIdx[std::min(idx, tickOfIdx.size() - 1)];
+	}
+
+	size_t
+	TelemetrySeeker::idxAtClockTick(
+		size_t tick) const
+	{
+		if ( ! clockSchedule_ || clockSchedule_->idxAtTick.empty())
+		{
+			return 0;
+		}
+		const auto &idxAtTick = clockSchedule_->idxAtTick;
+		return idxAtTick[std::min(tick, idxAtTick.size() - 1)];
+	}
+
+	ClockSchedulePtr
+	TelemetrySeeker::clockSchedule() const
+	{
+		return clockSchedule_;
+	}
+
+	ClockSchedulePtr
+	TelemetrySeeker::makeClockSchedule(
+		double rate_hz) const
+	{
+		auto dSrc = dataSrc_.lock();
+		if ( ! (rate_hz > 0.0) || ! dSrc || dSrc->columns_->empty())
+		{
+			return nullptr;
+		}
+
+		auto schedule = std::make_shared<ClockSchedule>();
+		schedule->rate_hz = rate_hz;
+		const auto tOffsets = dSrc->columns_->channel<double>(eTC_T_OFFSET);
+		const size_t nSamps = tOffsets.size();
+		const double t0 = tOffsets[0];
+		const double span = tOffsets[nSamps - 1] - t0;
+		// the clock can't run past the last sample. the small bias keeps
+		// rounding error from losing the last tick when it lands right on it.
+		const size_t nTicks = static_cast<size_t>(std::floor(span * rate_hz + 1e-6)) + 1;
+		schedule->idxAtTick.resize(nTicks);
+		schedule->tickOfIdx.resize(nSamps);
+
+		// ticks and samples both only move forward, so one merge-like pass
+		// finds every tick's nearest sample
+		size_t idx = 0;
+		for (size_t tick=0; tick<nTicks; tick++)
+		{
+			const double t = t0 + tick / rate_hz;
+			while ((idx + 1) < nSamps && tOffsets[idx + 1] <= t)
+			{
+				idx++;
+			}
+			size_t nearest = idx;
+			if ((idx + 1) < nSamps && (tOffsets[idx + 1] - t) < (t - tOffsets[idx]))
+			{
+				nearest = idx + 1;
+			}
+			schedule->idxAtTick[tick] = nearest;
+		}
+
+		// stored so that looking up a sample's tick doesn't need to read
+		// telemetry that may have been paged out
+		for (size_t i=0; i<nSamps; i++)
+		{
+			const double ticks = std::round((tOffsets[i] - t0) * rate_hz);
+			schedule->tickOfIdx[i] = std::min(static_cast<size_t>(std::max(ticks, 0.0)), nTicks - 1);
+		}
+		return schedule;
+	}
+
+	void
+	TelemetrySeeker::pageAroundSeek()
+	{
+		// paging only matters when we move into a different chunk, so most
+		// steps don't even need to look at the source
+		const size_t chunkIdx = seekedIdx_ >> TELEM_CHUNK_SHIFT;
+		if (chunkIdx == pagedChunkIdx_)
+		{
+			return;
+		}
+		pagedChunkIdx_ = chunkIdx;
+		if (auto dSrc = dataSrc_.lock())
+		{
+			dSrc->pageTelemetryAround(seekedIdx_);
+		}
+	}
+
+	const TelemetrySeeker::LapIndices &
+	TelemetrySeeker::lapIndices(
+		unsigned int lap) const
+	{
+		if (lap == 0 || lap > lapIndices_.size() || ! lapIndices_[lap - 1].valid())
+		{
+			throw std::out_of_range("lap " + std::to_string(lap) + " was not found");
+		}
+		return lapIndices_[lap - 1];
+	}
+
+	const TelemetrySeeker::LapIndices &
+	TelemetrySeeker::sectorIndices(
+		unsigned int lap,
+		unsigned int sector) const
+	{
+		if ( ! hasSector(lap,sector))
+		{
+			throw std::out_of_range(
+				"sector " + std::to_string(sector) + " of lap " + std::to_string(lap) + " was not found");
 		}
+		return sectorIndices_[(lap - 1) * sectorsPerLap_ + (sector - 1)];
 	}
 }
\ No newline at end of file
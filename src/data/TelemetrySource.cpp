@@ -1,5 +1,6 @@
 #include "GoProOverlay/data/TelemetrySource.h"
 #include "GoProOverlay/data/DataSource.h"
+#include "GoProOverlay/data/TimeIndex.hpp"
 
 #include <stdexcept>
 
@@ -22,18 +23,17 @@ namespace gpo
 		return "SOURCE_UNKNOWN";
 	}
 
-	const TelemetrySample &
+	TelemetrySample
 	TelemetrySource::at(
 		size_t idx) const
 	{
-		return dataSrc_.lock()->samples_->at(idx);
+		return dataSrc_.lock()->columns_->sampleAt(idx);
 	}
 
-	TelemetrySample &
-	TelemetrySource::at(
-		size_t idx)
+	const TelemetryColumns &
+	TelemetrySource::columns() const
 	{
-		return dataSrc_.lock()->samples_->at(idx);
+		return *dataSrc_.lock()->columns_;
 	}
 
 	size_t
@@ -51,13 +51,13 @@ namespace gpo
 	size_t
 	TelemetrySource::size() const
 	{
-		return dataSrc_.lock()->samples_->size();
+		return dataSrc_.lock()->columns_->size();
 	}
 
 	size_t
 	TelemetrySource::size_bytes() const
 	{
-		return size() * sizeof(TelemetrySample);
+		return dataSrc_.lock()->columns_->size_bytes();
 	}
 
 	double
@@ -66,9 +66,63 @@ namespace gpo
 		return dataSrc_.lock()->getTelemetryRate_hz();
 	}
 
+	size_t
+	TelemetrySource::findIndexAtTime(
+		double t_offset) const
+	{
+		const auto tOffsets = channel<double>(eTC_T_OFFSET);
+		auto index = makeTimeIndex(tOffsets.size(), [&tOffsets](size_t idx){
+			return tOffsets[idx];
+		});
+		return index.floorIndex(t_offset);
+	}
+
+	bool
+	TelemetrySource::findLerpIndex(
+		size_t &idx,
+		double t_offset) const
+	{
+		const auto tOffsets = channel<double>(eTC_T_OFFSET);
+		auto index = makeTimeIndex(tOffsets.size(), [&tOffsets](size_t i){
+			return tOffsets[i];
+		});
+		return index.findLerpIndex(idx, t_offset);
+	}
+
+	size_t
+	TelemetrySource::findIndexAtDistance(
+		double distance_m) const
+	{
+		// distances never decrease, so the time index works on them too
+		const auto distances = channel<double>(eTC_CALC_TRACK_DISTANCE);
+		auto index = makeTimeIndex(distances.size(), [&distances](size_t idx){
+			return distances[idx];
+		});
+		return index.floorIndex(distance_m);
+	}
+
+	bool
+	TelemetrySource::findLerpIndexAtDistance(
+		size_t &idx,
+		double distance_m) const
+	{
+		const auto distances = channel<double>(eTC_CALC_TRACK_DISTANCE);
+		auto index = makeTimeIndex(distances.size(), [&distances](size_t i){
+			return distances[i];
+		});
+		return index.findLerpIndex(idx, distance_m);
+	}
+
 	const DataAvailableBitSet &
 	TelemetrySource::dataAvailable() const
 	{
 		return dataSrc_.lock()->dataAvailable();
 	}
+
+	TelemetryAccessor
+	TelemetrySource::accessor() const
+	{
+		auto dataSrcPtr = dataSrc_.lock();
+		return TelemetryAccessor(dataSrcPtr->columns_.get(), dataSrcPtr->seeker.get());
+	}
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include "GoProOverlay/data/TrackDataObjects.h"
 
+#include <algorithm>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <opencv2/core/matx.hpp>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
@@ -308,6 +310,32 @@ namespace gpo
 		return true;
 	}
 
+	bool
+	TrackEdits::empty() const
+	{
+		return ! pathChanged && firstPathIdx > lastPathIdx;
+	}
+
+	void
+	TrackEdits::addPathRange(
+		size_t pathIdxA,
+		size_t pathIdxB)
+	{
+		firstPathIdx = std::min({firstPathIdx, pathIdxA, pathIdxB});
+		lastPathIdx = std::max({lastPathIdx, pathIdxA, pathIdxB});
+	}
+
+	void
+	TrackEdits::merge(
+		const TrackEdits &other)
+	{
+		pathChanged = pathChanged || other.pathChanged;
+		if (other.firstPathIdx <= other.lastPathIdx)
+		{
+			addPathRange(other.firstPathIdx, other.lastPathIdx);
+		}
+	}
+
 	Track::Track()
 	 : Track(std::vector<cv::Vec2d>())
 	{
@@ -320,6 +348,10 @@ namespace gpo
 	 , finish_(this, "finishGate", path.size() - 1, GateType_E::eGT_Finish)
 	 , sectors_()
 	 , path_(path)
+	 , pathIndex_()
+	 , editRevision_(0)
+	 , pendingEdits_()
+	 , lastAppliedEdits_()
 	{
 	}
 
@@ -328,8 +360,9 @@ namespace gpo
 	Track::setStart(
 		size_t pathIdx)
 	{
+		const size_t prevPathIdx = start_.getEntryIdx();
 		start_.setPathIdx(pathIdx);
-		markObjectModified();
+		markPathObjectsModified(prevPathIdx,pathIdx);
 	}
 
 	const TrackGate &
@@ -342,8 +375,9 @@ namespace gpo
 	Track::setFinish(
 		size_t pathIdx)
 	{
+		const size_t prevPathIdx = finish_.getEntryIdx();
 		finish_.setPathIdx(pathIdx);
-		markObjectModified();
+		markPathObjectsModified(prevPathIdx,pathIdx);
 	}
 
 	const TrackGate &
@@ -467,7 +501,7 @@ namespace gpo
 			sectors_.insert(
 				std::next(sectors_.begin(),res.second),
 				std::make_shared<TrackSector>(this,name,entryIdx,exitIdx));
-			markObjectModified();
+			markPathObjectsModified(entryIdx,exitIdx);
 		}
 		return res;
 	}
@@ -476,8 +510,11 @@ namespace gpo
 	Track::removeSector(
 		const size_t idx)
 	{
-		sectors_.erase(std::next(sectors_.begin(), idx));
-		markObjectModified();
+		const auto sectorItr = std::next(sectors_.begin(), idx);
+		const size_t entryIdx = (*sectorItr)->getEntryIdx();
+		const size_t exitIdx = (*sectorItr)->getExitIdx();
+		sectors_.erase(sectorItr);
+		markPathObjectsModified(entryIdx,exitIdx);
 	}
 
 	void
@@ -486,7 +523,8 @@ namespace gpo
 		const std::string &name)
 	{
 		sectors_.at(idx)->setName(name);
-		markObjectModified();
+		// renaming doesn't change anything derived from the track
+		ModifiableObject::markObjectModified();
 	}
 
 
@@ -598,45 +636,37 @@ namespace gpo
 		return findClosestPointWithIdx(p,0,{0,path_.size()});
 	}
 
-	// return the squared distance between two points.
-	// take square root if you want the distance.
-	double
-	distSquared(
-		const cv::Vec2d &p1,
-		const cv::Vec2d &p2)
-	{
-		const double dx = p2[0] - p1[0];
-		const double dy = p2[1] - p1[1];
-		return (dx*dx) + (dy*dy);
-	}
-
 	std::tuple<bool,cv::Vec2d, size_t>
 	Track::findClosestPointWithIdx(
 		const cv::Vec2d &p,
 		const size_t initialIdx,
 		const std::pair<size_t,size_t> &window) const
 	{
-		double closestDistSqr = -1;
-		cv::Vec2d closestPoint;
-		size_t closestIdx = initialIdx;
 		size_t startIdx = initialIdx - window.first;
 		if (window.first > initialIdx)
 		{
 			startIdx = 0;
 		}
-		const size_t endIdx = std::min(initialIdx + window.second,path_.size());
-		for (size_t i=startIdx; i<endIdx; i++)
+		// careful not to overflow if the window is huge
+		size_t endIdx = path_.size();
+		if (window.second < (path_.size() - std::min(initialIdx, path_.size())))
 		{
-			const auto &point = path_[i];
-			double distSqr = distSquared(p,point);
-			if (closestDistSqr < 0 || distSqr < closestDistSqr)
-			{
-				closestDistSqr = distSqr;
-				closestPoint = point;
-				closestIdx = i;
-			}
+			endIdx = initialIdx + window.second;
+		}
+
+		auto index = std::atomic_load(&pathIndex_);
+		if ( ! index || ! index->isBuiltFrom(path_))
+		{
+			// no index yet, or it was copied along with the track
+			index = std::make_shared<const PathIndex>(path_);
+			std::atomic_store(&pathIndex_, index);
+		}
+		auto res = index->findClosest(p,startIdx,endIdx);
+		if ( ! std::get<0>(res))
+		{
+			std::get<2>(res) = initialIdx;
 		}
-		return std::tuple(closestDistSqr!=-1,closestPoint,closestIdx);
+		return res;
 	}
 
 	bool
@@ -716,6 +746,8 @@ namespace gpo
 		}
 
 		const YAML::Node &yPath = node["path"];
+		std::atomic_store(&pathIndex_, std::shared_ptr<const PathIndex>());
+		pendingEdits_.pathChanged = true;
 		path_.resize(yPath.size());
 		for (size_t pp=0; okay && pp<path_.size(); pp++)
 		{
@@ -726,6 +758,40 @@ namespace gpo
 		return okay;
 	}
 
+	size_t
+	Track::getEditRevision() const
+	{
+		return editRevision_;
+	}
+
+	bool
+	Track::getEditsSince(
+		size_t revision,
+		TrackEdits &edits) const
+	{
+		edits = pendingEdits_;
+		if (revision == editRevision_)
+		{
+			return true;
+		}
+		else if ((revision + 1) == editRevision_)
+		{
+			edits.merge(lastAppliedEdits_);
+			return true;
+		}
+		return false;
+	}
+
+	void
+	Track::markObjectModified(
+		bool needsApply,
+		bool needsSave)
+	{
+		std::atomic_store(&pathIndex_, std::shared_ptr<const PathIndex>());
+		pendingEdits_.pathChanged = true;
+		ModifiableObject::markObjectModified(needsApply,needsSave);
+	}
+
 	//--------------------------------------------------------------
 	// Track protected methods
 	//--------------------------------------------------------------
@@ -733,10 +799,26 @@ namespace gpo
 	Track::subclassApplyModifications(
         bool /* unnecessaryIsOkay */)
 	{
-		// apply means nothing to use right now
+		// the track is always up to date, but observers may want to know
+		// what changed since they last processed it
+		lastAppliedEdits_ = pendingEdits_;
+		pendingEdits_ = TrackEdits();
+		editRevision_++;
 		return true;
 	}
 
+	//--------------------------------------------------------------
+	// Track private methods
+	//--------------------------------------------------------------
+	void
+	Track::markPathObjectsModified(
+		size_t pathIdxA,
+		size_t pathIdxB)
+	{
+		pendingEdits_.addPathRange(pathIdxA,pathIdxB);
+		ModifiableObject::markObjectModified();
+	}
+
 	bool
 	Track::subclassSaveModifications(
         bool /* unnecessaryIsOkay */)
@@ -764,12 +846,14 @@ namespace gpo
 	makeTrackFromTelemetry(
 		TelemetrySourcePtr tSrc)
 	{
+		const auto lats = tSrc->channel<double>(eTC_GOPRO_GPS_LAT);
+		const auto lons = tSrc->channel<double>(eTC_GOPRO_GPS_LON);
 		std::vector<cv::Vec2d> path;
 		path.resize(tSrc->size());
 		for (size_t i=0; i<path.size(); i++)
 		{
-			path[i][0] = tSrc->at(i).gpSamp.gps.coord.lat;
-			path[i][1] = tSrc->at(i).gpSamp.gps.coord.lon;
+			path[i][0] = lats[i];
+			path[i][1] = lons[i];
 		}
 		return std::make_shared<Track>(path);
 	}
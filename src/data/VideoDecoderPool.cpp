@@ -0,0 +1,281 @@
+#include "GoProOverlay/data/VideoDecoderPool.h"
+
+#include <chrono>
+#include <limits>
+#include <map>
+#include <spdlog/spdlog.h>
+#include <thread>
+
+namespace gpo
+{
+	VideoDecodeConfig
+	VideoDecodeConfig::makeDefault(
+		size_t simultaneousSources)
+	{
+		const size_t nCores = std::max(std::thread::hardware_concurrency(), 1U);
+		VideoDecodeConfig config;
+		config.threads = std::max(nCores / std::max(simultaneousSources, (size_t)1), (size_t)1);
+		return config;
+	}
+
+	VideoDecoderPool::VideoDecoderPool(
+		const std::filesystem::path &videoFile,
+		size_t maxDecoders)
+	 : videoFile_(videoFile)
+	 , maxDecoders_(std::max(maxDecoders, (size_t)1))
+	 , config_({0})
+	 , configGen_(0)
+	 , stats_({0, 0.0})
+	 , mutex_()
+	 , idleCond_()
+	 , idle_()
+	 , nLeased_(0)
+	{
+	}
+
+	VideoDecoderPoolPtr
+	VideoDecoderPool::getPool(
+		const std::filesystem::path &videoFile)
+	{
+		static std::mutex registryMutex;
+		static std::map<std::filesystem::path, std::weak_ptr<VideoDecoderPool>> registry;
+
+		std::scoped_lock lock(registryMutex);
+		const auto key = std::filesystem::absolute(videoFile).lexically_normal();
+		auto pool = registry[key].lock();
+		if ( ! pool)
+		{
+			pool = std::make_shared<VideoDecoderPool>(videoFile);
+			registry[key] = pool;
+		}
+
+		// prune pools that are no longer referenced
+		for (auto itr = registry.begin(); itr != registry.end();)
+		{
+			itr = (itr->second.expired() ? registry.erase(itr) : std::next(itr));
+		}
+		return pool;
+	}
+
+	const std::filesystem::path &
+	VideoDecoderPool::getFile() const
+	{
+		return videoFile_;
+	}
+
+	void
+	VideoDecoderPool::setMaxDecoders(
+		size_t maxDecoders)
+	{
+		std::scoped_lock lock(mutex_);
+		maxDecoders_ = std::max(maxDecoders, (size_t)1);
+		// close surplus idle decoders
+		while ( ! idle_.empty() && (idle_.size() + nLeased_) > maxDecoders_)
+		{
+			idle_.pop_back();
+		}
+		idleCond_.notify_all();
+	}
+
+	size_t
+	VideoDecoderPool::getMaxDecoders() const
+	{
+		std::scoped_lock lock(mutex_);
+		return maxDecoders_;
+	}
+
+	void
+	VideoDecoderPool::setDecodeConfig(
+		const VideoDecodeConfig &config)
+	{
+		std::scoped_lock lock(mutex_);
+		config_ = config;
+		configGen_++;
+		idle_.clear();
+		idleCond_.notify_all();
+	}
+
+	VideoDecodeConfig
+	VideoDecoderPool::getDecodeConfig() const
+	{
+		std::scoped_lock lock(mutex_);
+		return config_;
+	}
+
+	VideoDecodeStats
+	VideoDecoderPool::getDecodeStats() const
+	{
+		std::scoped_lock lock(mutex_);
+		return stats_;
+	}
+
+	void
+	VideoDecoderPool::resetDecodeStats()
+	{
+		std::scoped_lock lock(mutex_);
+		stats_ = {0, 0.0};
+	}
+
+	size_t
+	VideoDecoderPool::decoderCount() const
+	{
+		std::scoped_lock lock(mutex_);
+		return idle_.size() + nLeased_;
+	}
+
+	VideoDecoderPool::DecoderPtr
+	VideoDecoderPool::acquire(
+		size_t frameIdx)
+	{
+		std::unique_lock lock(mutex_);
+		while (true)
+		{
+			// find the idle decoder closest to the requested frame, and the
+			// closest one that can reach it by reading forward
+			auto nearestItr = idle_.end();
+			size_t nearestDist = std::numeric_limits<size_t>::max();
+			auto forwardItr = idle_.end();
+			size_t forwardDist = std::numeric_limits<size_t>::max();
+			for (auto itr = idle_.begin(); itr != idle_.end(); itr++)
+			{
+				const size_t next = (*itr)->nextFrameIdx;
+				const size_t dist = (next > frameIdx ? next - frameIdx : frameIdx - next);
+				if (dist < nearestDist)
+				{
+					nearestItr = itr;
+					nearestDist = dist;
+				}
+				if (next <= frameIdx && dist < forwardDist)
+				{
+					forwardItr = itr;
+					forwardDist = dist;
+				}
+			}
+
+			// a decoder just short of the frame is cheaper to read forward
+			// than a freshly opened one, which would have to seek anyway
+			const bool canOpenNew = (idle_.size() + nLeased_) < maxDecoders_;
+			auto bestItr = idle_.end();
+			if (forwardDist < REUSE_FRAME_DISTANCE)
+			{
+				bestItr = forwardItr;
+			}
+			else if ( ! canOpenNew)
+			{
+				bestItr = nearestItr;
+			}
+
+			if (bestItr != idle_.end())
+			{
+				auto decoder = *bestItr;
+				idle_.erase(bestItr);
+				nLeased_++;
+				return decoder;
+			}
+			else if (canOpenNew)
+			{
+				// reserve the slot and open outside the lock since it's slow
+				nLeased_++;
+				const auto config = config_;
+				auto decoder = std::make_shared<Decoder>();
+				decoder->nextFrameIdx = 0;
+				decoder->configGen = configGen_;
+				lock.unlock();
+				if ( ! openDecoder(*decoder, config))
+				{
+					spdlog::error("failed to open decoder for '{}'", videoFile_.c_str());
+					lock.lock();
+					nLeased_--;
+					idleCond_.notify_one();
+					return nullptr;
+				}
+				return decoder;
+			}
+
+			// everything is leased and we're at the limit
+			idleCond_.wait(lock);
+		}
+	}
+
+	void
+	VideoDecoderPool::release(
+		DecoderPtr decoder)
+	{
+		if ( ! decoder)
+		{
+			return;
+		}
+
+		std::scoped_lock lock(mutex_);
+		nLeased_--;
+		// drop decoders opened with a stale config
+		if (decoder->configGen == configGen_ && (idle_.size() + nLeased_) < maxDecoders_)
+		{
+			idle_.push_back(decoder);
+		}
+		idleCond_.notify_one();
+	}
+
+	bool
+	VideoDecoderPool::readFrame(
+		cv::UMat &outImg,
+		size_t frameIdx)
+	{
+		auto decoder = acquire(frameIdx);
+		if ( ! decoder)
+		{
+			return false;
+		}
+
+		// seeking can be costly, so avoid it if reading consecutive frames.
+		// short gaps are skipped over without decoding to BGR. the decode
+		// stats leave out the seek, since it decodes an unknown number of
+		// frames from the nearest keyframe, but count every frame grabbed.
+		const bool readForward =
+			decoder->nextFrameIdx <= frameIdx &&
+			frameIdx - decoder->nextFrameIdx < REUSE_FRAME_DISTANCE;
+		if ( ! readForward)
+		{
+			decoder->vCap.set(cv::CAP_PROP_POS_FRAMES, frameIdx);
+		}
+
+		const auto startTime = std::chrono::steady_clock::now();
+		bool okay = true;
+		size_t framesDecoded = 0;
+		for (size_t i=decoder->nextFrameIdx; readForward && okay && i<frameIdx; i++)
+		{
+			okay = decoder->vCap.grab();
+			framesDecoded += (okay ? 1 : 0);
+		}
+		okay = okay && decoder->vCap.read(outImg);
+		framesDecoded += (okay ? 1 : 0);
+		// force a seek on next use if the read failed
+		decoder->nextFrameIdx = (okay ? frameIdx + 1 : std::numeric_limits<size_t>::max());
+		const std::chrono::duration<double> decodeTime = std::chrono::steady_clock::now() - startTime;
+
+		{
+			std::scoped_lock lock(mutex_);
+			stats_.framesDecoded += framesDecoded;
+			stats_.decodeTime_sec += decodeTime.count();
+		}
+		release(decoder);
+		return okay;
+	}
+
+	bool
+	VideoDecoderPool::openDecoder(
+		Decoder &decoder,
+		const VideoDecodeConfig &config)
+	{
+		std::vector<int> params;
+		if (config.threads > 0)
+		{
+			params.push_back(cv::CAP_PROP_N_THREADS);
+			params.push_back(config.threads);
+		}
+		// settings go through the open params rather than the backend's
+		// process-wide environment options, so concurrent opens can't race
+		return decoder.vCap.open(videoFile_, cv::CAP_ANY, params);
+	}
+
+}
@@ -4,14 +4,11 @@
 namespace gpo
 {
 	VideoSource::VideoSource(
-		DataSourcePtr dSrc)
+		DataSourcePtr dSrc,
+		const VideoMetadata &meta)
 	 : dataSrc_(dSrc)
-	 , frameSize_()
-	 , prevFrameIdxRead_(-1)
+	 , meta_(meta)
 	{
-		auto dataSrcPtr = dataSrc_.lock();
-		frameSize_.width = dataSrcPtr->vCapture_.get(cv::CAP_PROP_FRAME_WIDTH);
-		frameSize_.height = dataSrcPtr->vCapture_.get(cv::CAP_PROP_FRAME_HEIGHT);
 	}
 
 	std::string
@@ -25,28 +22,34 @@ namespace gpo
 		return "SOURCE_UNKNOWN";
 	}
 
+	std::string
+	VideoSource::getOriginFile() const
+	{
+		return dataSrc_.lock()->getOrigin();
+	}
+
 	int
 	VideoSource::frameWidth() const
 	{
-		return frameSize_.width;
+		return meta_.frameWidth;
 	}
 
 	int
 	VideoSource::frameHeight() const
 	{
-		return frameSize_.height;
+		return meta_.frameHeight;
 	}
 
 	cv::Size
 	VideoSource::frameSize() const
 	{
-		return frameSize_;
+		return cv::Size(meta_.frameWidth, meta_.frameHeight);
 	}
 
 	double
-	VideoSource::fps()
+	VideoSource::fps() const
 	{
-		return dataSrc_.lock()->vCapture_.get(cv::CAP_PROP_FPS);
+		return meta_.fps;
 	}
 
 	bool
@@ -54,14 +57,7 @@ namespace gpo
 		cv::UMat &outImg,
 		size_t idx)
 	{
-		auto dataSrcPtr = dataSrc_.lock();
-		// seeking can be constly, so avoid it if reading consecutive frames
-		if (idx != (prevFrameIdxRead_ + 1))
-		{
-			dataSrcPtr->vCapture_.set(cv::CAP_PROP_POS_FRAMES, idx);
-		}
-		prevFrameIdxRead_ = idx;
-		return dataSrcPtr->vCapture_.read(outImg);
+		return dataSrc_.lock()->decoderPool_->readFrame(outImg,idx);
 	}
 
 	size_t
@@ -77,8 +73,58 @@ namespace gpo
 	}
 
 	size_t
-	VideoSource::frameCount()
+	VideoSource::frameCount() const
+	{
+		return meta_.frameCount;
+	}
+
+	const VideoMetadata &
+	VideoSource::metadata() const
+	{
+		return meta_;
+	}
+
+	void
+	VideoSource::setDecodeConfig(
+		const VideoDecodeConfig &config)
+	{
+		dataSrc_.lock()->decoderPool_->setDecodeConfig(config);
+	}
+
+	VideoDecodeConfig
+	VideoSource::getDecodeConfig() const
+	{
+		return dataSrc_.lock()->decoderPool_->getDecodeConfig();
+	}
+
+	VideoDecodeStats
+	VideoSource::getDecodeStats() const
+	{
+		return dataSrc_.lock()->decoderPool_->getDecodeStats();
+	}
+
+	VideoAccessor
+	VideoSource::accessor()
+	{
+		auto dataSrcPtr = dataSrc_.lock();
+		return VideoAccessor(dataSrcPtr->decoderPool_.get(), dataSrcPtr->seeker.get(), meta_.fps);
+	}
+
+	void
+	VideoSource::resetDecodeStats()
+	{
+		dataSrc_.lock()->decoderPool_->resetDecodeStats();
+	}
+
+	VideoMetadata
+	VideoSource::probeMetadata(
+		cv::VideoCapture &vCap)
 	{
-		return dataSrc_.lock()->vCapture_.get(cv::CAP_PROP_FRAME_COUNT);
+		VideoMetadata meta;
+		meta.fps = vCap.get(cv::CAP_PROP_FPS);
+		meta.frameCount = vCap.get(cv::CAP_PROP_FRAME_COUNT);
+		meta.frameWidth = vCap.get(cv::CAP_PROP_FRAME_WIDTH);
+		meta.frameHeight = vCap.get(cv::CAP_PROP_FRAME_HEIGHT);
+		return meta;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <GoProOverlay/utils/io/gpot.h>
+#include <spdlog/spdlog.h>
+
+#include "cmds/Command.hpp"
+
+namespace gpo
+{
+    class TelemetryConvertCmd : public Command
+    {
+        struct Args
+        {
+            static constexpr std::string_view IN_FILE = "in-file";
+            static constexpr std::string_view OUT_FILE = "out-file";
+        };
+
+    public:
+        TelemetryConvertCmd()
+         : Command("telemetry-convert")
+        {
+            parser().add_description(
+                "converts telemetry between CSV, binary (.gpot), and archive (.gpoz) formats");
+
+            parser().add_argument(Args::IN_FILE)
+                .help("telemetry file to convert (.csv, .gpot, or .gpoz)");
+            parser().add_argument(Args::OUT_FILE)
+                .help("file to write the converted telemetry to (.csv, .gpot, or .gpoz)");
+        }
+
+        int
+        exec() final
+        {
+            const auto inFile = parser().get<std::string>(Args::IN_FILE);
+            const auto outFile = parser().get<std::string>(Args::OUT_FILE);
+            if ( ! utils::io::convertTelemetryFile(inFile, outFile))
+            {
+                spdlog::error("failed to convert '{}' to '{}'", inFile, outFile);
+                return -1;
+            }
+
+            spdlog::info("converted '{}' to '{}'", inFile, outFile);
+            return 0;
+        }
+    };
+}
@@ -8,6 +8,7 @@
 #include "cmds/Command.hpp"
 #include "cmds/ListOpenCL_DevicesCmd.hpp"
 #include "cmds/SingleOverlayCmd.hpp"
+#include "cmds/TelemetryConvertCmd.hpp"
 #include "cmds/TelemetryMergeCmd.hpp"
 #include "cmds/TopBottomOverlayCmd.hpp"
 #include "cmds/TrackEditorCmd.hpp"
@@ -35,6 +36,7 @@ namespace gpo
             addSubCmd(std::make_shared<gpo::TrackEditorCmd>());
             addSubCmd(std::make_shared<gpo::AlignmentPlotCmd>());
             addSubCmd(std::make_shared<gpo::TelemetryMergeCmd>());
+            addSubCmd(std::make_shared<gpo::TelemetryConvertCmd>());
             addSubCmd(std::make_shared<gpo::SingleOverlayCmd>());
             addSubCmd(std::make_shared<gpo::TopBottomOverlayCmd>());
             addSubCmd(std::make_shared<gpo::ListOpenCL_DevicesCmd>());
@@ -1,7 +1,9 @@
 #include "AlignmentPlot.h"
 #include "ui_AlignmentPlot.h"
 
+#include <algorithm>
 #include <GoProOverlay/graphics/QTelemetryPlot.h>
+#include <GoProOverlay/utils/SignalAlignment.h>
 #include <QSpinBox>
 #include <spdlog/spdlog.h>
 
@@ -43,6 +45,9 @@ AlignmentPlot::AlignmentPlot(QWidget *parent) :
         auto yComp = GET_COMBOBOX_Y_COMP(ui->bData_ComboBox,index);
         ui->plot->setY_Component2(yComp,true);
     });
+    connect(ui->autoAlign_Button, &QPushButton::clicked, this, [this]{
+        autoAlign();
+    });
 
     // plot signal handler
     connect(ui->plot, &QCustomPlot::mousePress, this,
@@ -230,6 +235,77 @@ AlignmentPlot::setSourceB(
     }
 }
 
+bool
+AlignmentPlot::autoAlign()
+{
+    if (srcA_ == nullptr || srcB_ == nullptr)
+    {
+        return false;
+    }
+
+    const auto yCompA = GET_COMBOBOX_Y_COMP(ui->aData_ComboBox,ui->aData_ComboBox->currentIndex());
+    const auto yCompB = GET_COMBOBOX_Y_COMP(ui->bData_ComboBox,ui->bData_ComboBox->currentIndex());
+    const auto channelA = QTelemetryPlot::getY_ComponentChannel(yCompA);
+    const auto channelB = QTelemetryPlot::getY_ComponentChannel(yCompB);
+    if (channelA == gpo::eTC_COUNT || channelB == gpo::eTC_COUNT)
+    {
+        ui->autoAlign_Label->setText("select data to align");
+        return false;
+    }
+
+    utils::SignalAlignment result;
+    const bool found = utils::findTelemetryAlignment(
+        *srcA_,
+        channelA,
+        (ui->aDeriv_CheckBox->isChecked() ? utils::eAP_Derivative : utils::eAP_Value),
+        *srcB_,
+        channelB,
+        (ui->bDeriv_CheckBox->isChecked() ? utils::eAP_Derivative : utils::eAP_Value),
+        result);
+    if ( ! found)
+    {
+        ui->autoAlign_Label->setText("no alignment found");
+        return false;
+    }
+    spdlog::info("auto aligned '{}' to '{}'; lag = {}; confidence = {}",
+        srcB_->getDataSourceName(),
+        srcA_->getDataSourceName(),
+        result.lag,
+        result.confidence);
+
+    // a[i] lines up with b[i + lag], so keep A where it is if we can. both
+    // alignments must move together to keep the lag, so clamp A to the range
+    // where B stays within its source too.
+    const int64_t minAlignA = std::max((int64_t)0,-result.lag);
+    const int64_t maxAlignA = std::min(
+        (int64_t)(srcA_->size()) - 1,
+        (int64_t)(srcB_->size()) - 1 - result.lag);
+    if (minAlignA > maxAlignA)
+    {
+        spdlog::warn("lag of {} doesn't fit within the sources' samples",result.lag);
+        ui->autoAlign_Label->setText("no alignment found");
+        return false;
+    }
+    const int64_t alignA = std::clamp(
+        (int64_t)(srcA_->seeker()->getAlignmentIdx()),
+        minAlignA,
+        maxAlignA);
+    const int64_t alignB = alignA + result.lag;
+
+    // dragging the plots doesn't update the spinboxes, so they may already
+    // hold these values and not signal. set the seekers directly as well.
+    srcA_->seeker()->setAlignmentIdx(alignA);
+    srcB_->seeker()->setAlignmentIdx(alignB);
+    ui->aAlignment_SpinBox->setValue(alignA);
+    ui->bAlignment_SpinBox->setValue(alignB);
+    ui->plot->replot(QCustomPlot::RefreshPriority::rpQueuedReplot);
+
+    char text[64];
+    sprintf(text,"lag: %lld; confidence: %.2f",(long long)(result.lag),result.confidence);
+    ui->autoAlign_Label->setText(text);
+    return true;
+}
+
 void
 AlignmentPlot::populateComboBox(
     QComboBox *combobox,
@@ -29,6 +29,16 @@ public:
     setSourceB(
         gpo::TelemetrySourcePtr tSrc);
 
+    /**
+     * Aligns source B to source A by cross-correlating the data selected
+     * in each combobox. The result is applied to the sources' seekers.
+     *
+     * @return
+     * true if an alignment was found and applied. false otherwise.
+     */
+    bool
+    autoAlign();
+
 private:
     void
     populateComboBox(
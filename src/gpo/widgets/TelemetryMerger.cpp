@@ -348,10 +348,14 @@ TelemetryMerger::setupMerge()
     // highlight the row we're merging next
     ui->sources_TableView->selectRow(state_.currSrcIdx);
 
-    // sample rates need to match, so resample current source to match
+    // sample rates need to match, so resample current source to match. ECU
+    // logs are often much slower than the video, so interpolate them with a
+    // band-limited kernel rather than joining the samples with straight lines
     auto currSrc = sources_.at(state_.currSrcIdx);
     currSrc->backupTelemetry();
-    currSrc->resampleTelemetry(state_.mergedSrc->getTelemetryRate_hz());
+    currSrc->resampleTelemetry(
+        state_.mergedSrc->getTelemetryRate_hz(),
+        utils::ResamplerConfig::makeWindowedSinc());
 
     alignPlot_.setSourceA(state_.mergedSrc->telemSrc);
     alignPlot_.setSourceB(currSrc->telemSrc);
@@ -38,6 +38,7 @@ ProjectWindow::ProjectWindow(QWidget *parent) :
     reWizSingle_(new RenderEngineWizardSingleVideo(this,&proj_)),
     reWizTopBot_(new RenderEngineWizard_TopBottom(this,&proj_)),
     projectObserver_(),
+    rThread_(nullptr),
     progressDialog_(new ProgressDialog(this)),
     renderEntityPropertiesTab_(new RenderEntityPropertiesTab(this))
 {
@@ -158,6 +159,10 @@ ProjectWindow::ProjectWindow(QWidget *parent) :
         ui->resetAlignment_PushButton->setEnabled(true);
         ui->applyAlignment_PushButton->setEnabled(true);
     });
+    connect(ui->warpLapCheckBox, &QCheckBox::toggled, this, [this]{
+        ui->resetAlignment_PushButton->setEnabled(true);
+        ui->applyAlignment_PushButton->setEnabled(true);
+    });
     connect(ui->previewAlignment_PushButton, &QPushButton::clicked, this, [this]{
         seekEngineToAlignment(getAlignmentInfoFromUI(),false);
         if ( ! ui->customAlignmentCheckBox->isChecked())
@@ -238,6 +243,15 @@ ProjectWindow::ProjectWindow(QWidget *parent) :
                     exportFilename,
                     engine->getHighestFPS());
         connect(rThread_, &RenderThread::progressChanged, progressDialog_, &ProgressDialog::progressChanged);
+        connect(rThread_, &RenderThread::telemetryPaged, this, [this]{
+            // the render thread only pins what it's using, so the trimming
+            // happens here, where the preview pages the sources too
+            const auto &dsm = proj_.dataSourceManager();
+            for (size_t ss=0; ss<dsm.sourceCount(); ss++)
+            {
+                dsm.getSource(ss)->trimTelemetry();
+            }
+        });
         connect(rThread_, &RenderThread::finished, this, [this]{
             spdlog::info("render finished!");
             ui->exportButton->setVisible(true);
@@ -767,6 +781,7 @@ ProjectWindow::getAlignmentInfoFromUI()
         {
             lapAlignment.side = gpo::ElementSide_E::eES_Exit;
         }
+        lapAlignment.warp = ui->warpLapCheckBox->isChecked();
 
         rai.initFrom(lapAlignment);
     }
@@ -791,6 +806,7 @@ ProjectWindow::resetAlignmentFromProject()
     if (rai.type == gpo::RenderAlignmentType_E::eRAT_Lap)
     {
         ui->lapSpinBox->setValue(rai.alignInfo.lap->lap);
+        ui->warpLapCheckBox->setChecked(rai.alignInfo.lap->warp);
         switch (rai.alignInfo.lap->side)
         {
             case gpo::ElementSide_E::eES_Entry:
@@ -837,6 +853,12 @@ ProjectWindow::seekEngineToAlignment(
 void
 ProjectWindow::render()
 {
+    if (rThread_ && rThread_->isRunning())
+    {
+        // the export is rendering with the same engine
+        return;
+    }
+
     auto engine = proj_.getEngine();
     if (engine)
     {
@@ -919,13 +941,15 @@ ProjectWindow::plotTelemetry(
     const size_t N_SAMPS = telem->size();
     QVector<double> accl_keys(N_SAMPS);
     QVector<double> acclX_values(N_SAMPS),acclY_values(N_SAMPS),acclZ_values(N_SAMPS);
+    const auto acclX = telem->channel<float>(gpo::eTC_GOPRO_ACCL_X);
+    const auto acclY = telem->channel<float>(gpo::eTC_GOPRO_ACCL_Y);
+    const auto acclZ = telem->channel<float>(gpo::eTC_GOPRO_ACCL_Z);
     for (size_t i=0; i<N_SAMPS; i++)
     {
-        auto &acclSamp = telem->at(i).gpSamp.accl;
         accl_keys[i] = i;
-        acclX_values[i] = acclSamp.x;
-        acclY_values[i] = acclSamp.y;
-        acclZ_values[i] = acclSamp.z;
+        acclX_values[i] = acclX[i];
+        acclY_values[i] = acclY[i];
+        acclZ_values[i] = acclZ[i];
     }
     acclPlot->plotLayout()->insertRow(0);
     acclPlot->plotLayout()->addElement(0,0,new QCPTextElement(acclPlot,"Acceleration"));
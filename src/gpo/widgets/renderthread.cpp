@@ -1,8 +1,10 @@
 #include "renderthread.h"
 
 #include <array>
+#include <cmath>
 #include <tracy/Tracy.hpp>
 #include <filesystem>
+#include "GoProOverlay/data/RenderSession.h"
 #include "GoProOverlay/graphics/RenderEngine.h"
 #include <spdlog/spdlog.h>
 
@@ -25,16 +27,16 @@ RenderThread::RenderThread(
  , exportFilename_(exportFilename)
  , vWriter_()
  , renderFPS_(fps)
+ , session_()
+ , timeline_()
+ , startState_()
+ , sourceNames_()
+ , startTimesBySource_()
  , pool_(N_RESOURCES)
  , renderThread_()
  , writerThread_()
  , stopRenderThread_(false)
  , stopWriterThread_(false)
-{
-}
-
-void
-RenderThread::run()
 {
     if (project_ == nullptr)
     {
@@ -43,28 +45,57 @@ RenderThread::run()
 
     auto engine = project_->getEngine();
     auto gSeeker = engine->getSeeker();
+    session_ = std::make_unique<gpo::RenderSession>(project_->dataSourceManager());
 
     // seek to render alignment point first
     gSeeker->seekToAlignmentInfo(project_->getAlignmentInfo());
+
+    // step every source by output frame time, so sources recorded at other
+    // rates than the export (ie. ECU logs) don't need to be resampled first.
+    // the export's clock only lives in this snapshot, so the preview keeps
+    // stepping however it was.
+    timeline_ = gSeeker->timeline(renderFPS_);
     // start render a little bit before the alignment point (lead-in)
-    gSeeker->seekAllRelativeTime(project_->getLeadInSeconds() * -1.0);// -1 to go backwards in time
+    const int64_t leadInFrames = std::llround(project_->getLeadInSeconds() * renderFPS_);
+    startState_ = timeline_.step(timeline_.stateOf(gSeeker->currentState()), -leadInFrames);
+
     // disable bounding boxes prior to render
     for (size_t ee=0; ee<engine->entityCount(); ee++)
     {
         engine->getEntity(ee)->renderObject()->setBoundingBoxVisible(false);
     }
 
-    const auto seekerCount = gSeeker->seekerCount();
-    std::unordered_map<std::string, double> startTimesBySource;
     spdlog::info("--- Start times by source");
-    for (size_t ss=0; ss<seekerCount; ss++)
+    for (const auto &entry : startState_.entries())
     {
-        auto seeker = gSeeker->getSeeker(ss);
-        auto sourceName = seeker->getDataSourceName();
-        auto startTime_sec = seeker->getTimeAt(seeker->seekedIdx());
-        startTimesBySource.insert({sourceName,startTime_sec});
+        auto sourceName = entry.seeker->getDataSourceName();
+        auto startTime_sec = entry.seeker->getTimeAt(entry.idx);
+        sourceNames_.push_back(sourceName);
+        startTimesBySource_.insert({sourceName,startTime_sec});
         spdlog::info("  {0}: {1:0.6f}s",sourceName.c_str(),startTime_sec);
     }
+}
+
+void
+RenderThread::run()
+{
+    if (project_ == nullptr)
+    {
+        return;
+    }
+
+    auto engine = project_->getEngine();
+
+    // pick decoder settings and start measuring decode rates from scratch
+    project_->configureVideoDecoders();
+    for (size_t ss=0; ss<session_->sourceCount(); ss++)
+    {
+        const auto &dSrc = session_->getSource(ss);
+        if (dSrc->hasVideo())
+        {
+            dSrc->videoSrc->resetDecodeStats();
+        }
+    }
 
     // create temporary directory and open export video file
     const std::filesystem::path tmpDir = exportDir_ / RENDER_TMP_DIR;
@@ -86,7 +117,7 @@ RenderThread::run()
     // startup our render/writer threads
     stopRenderThread_ = false;
     stopWriterThread_ = false;
-    renderThread_ = std::thread(&RenderThread::renderThreadMain, this, engine, gSeeker);
+    renderThread_ = std::thread(&RenderThread::renderThreadMain, this, engine);
     writerThread_ = std::thread(&RenderThread::writerThreadMain, this);
 
     // wait for render thread to finish
@@ -105,14 +136,17 @@ RenderThread::run()
 
     vWriter_.release();
 
+    // report decoder settings & throughput so we can tell if they bottlenecked the render
+    spdlog::info("--- Video decode report\n{}", YAML::Dump(project_->dataSourceManager().getDecodeReport()));
+
     // export final video with audio
     const std::filesystem::path finalExportFile = exportDir_ / exportFilename_.toStdString();
     switch (project_->getAudioExportApproach())
     {
         case gpo::AudioExportApproach_E::eAEA_SingleSource:
             exportAudioSingleSource(
-                gSeeker,
-                startTimesBySource,
+                sourceNames_,
+                startTimesBySource_,
                 tmpDir,
                 ffmpegLogFile,
                 rawRenderFilePath,
@@ -120,8 +154,8 @@ RenderThread::run()
             break;
         case gpo::AudioExportApproach_E::eAEA_MultiSourceSplit:
             exportAudioMultiSourceLR(
-                gSeeker,
-                startTimesBySource,
+                sourceNames_,
+                startTimesBySource_,
                 tmpDir,
                 ffmpegLogFile,
                 rawRenderFilePath,
@@ -141,11 +175,11 @@ RenderThread::stopRender()
 
 void
 RenderThread::renderThreadMain(
-    gpo::RenderEnginePtr engine,
-    gpo::GroupedSeekerPtr gSeeker)
+    gpo::RenderEnginePtr engine)
 {
-    // get new limits after lead-in seeking
-    auto seekLimits = gSeeker->relativeSeekLimits();
+    // frames are stepped through the timeline that was snapshotted up front,
+    // so the seekers are never read (or moved) from this thread
+    auto seekLimits = timeline_.stepLimits(startState_);
     qulonglong progress = 0;
     qulonglong total = seekLimits.second;
     while ( ! stopRenderThread_ && progress < total)
@@ -157,9 +191,13 @@ RenderThread::renderThreadMain(
             {
                 FrameMark;// marks beginning of frame in tracy profiler
                 ZoneScopedN("render frame");
-                engine->renderInto(res->frame);
+                const auto state = timeline_.stateAt(startState_, progress);
+                if (session_->pageAround(state))
+                {
+                    emit telemetryPaged();
+                }
+                engine->renderInto(res->frame, state);
             }
-            gSeeker->nextAll(true,false);
             emit progressChanged(progress++,total);
             pool_.produce(res);
         }
@@ -186,7 +224,7 @@ RenderThread::writerThreadMain()
 
 bool
 RenderThread::exportAudioSingleSource(
-    gpo::GroupedSeekerPtr gSeeker,
+    const std::vector<std::string> &sourceNames,
     const std::unordered_map<std::string, double> &startTimesBySource,
     const std::filesystem::path &tmpDir,
     const std::filesystem::path &ffmpegLogFile,
@@ -197,14 +235,14 @@ RenderThread::exportAudioSingleSource(
     std::array<char, 10000> ffmpegCmd;
     spdlog::info("exporting single-source audio...");
 
-    const auto seekerCount = gSeeker->seekerCount();
+    const auto seekerCount = sourceNames.size();
     if (seekerCount <= 0)
     {
         spdlog::error("not enough sources to get audio");
         return false;
     }
 
-    auto sourceForAudio = gSeeker->getSeeker(seekerCount - 1)->getDataSourceName();
+    auto sourceForAudio = sourceNames.at(seekerCount - 1);
     auto sourceStartTime_sec = startTimesBySource.at(sourceForAudio);
     spdlog::debug("dumping audio from source '{}'", sourceForAudio.c_str());
     auto dataSource = project_->dataSourceManager().getSourceByName(sourceForAudio);
@@ -247,7 +285,7 @@ RenderThread::exportAudioSingleSource(
 
 bool
 RenderThread::exportAudioMultiSourceLR(
-    gpo::GroupedSeekerPtr gSeeker,
+    const std::vector<std::string> &sourceNames,
     const std::unordered_map<std::string, double> &startTimesBySource,
     const std::filesystem::path &tmpDir,
     const std::filesystem::path &ffmpegLogFile,
@@ -258,14 +296,14 @@ RenderThread::exportAudioMultiSourceLR(
     std::array<char, 10000> ffmpegCmd;
     spdlog::info("exporting multi-source split audio...");
 
-    const auto seekerCount = gSeeker->seekerCount();
+    const auto seekerCount = sourceNames.size();
     if (seekerCount < 2)
     {
         spdlog::error("not enough sources to get audio. need at least 2.");
         return false;
     }
 
-    auto sourceForLeftAudio = gSeeker->getSeeker(0)->getDataSourceName();
+    auto sourceForLeftAudio = sourceNames.at(0);
     auto leftStartTime_sec = startTimesBySource.at(sourceForLeftAudio);
     spdlog::debug("dumping audio from source '{}'", sourceForLeftAudio.c_str());
     auto leftSource = project_->dataSourceManager().getSourceByName(sourceForLeftAudio);
@@ -288,7 +326,7 @@ RenderThread::exportAudioMultiSourceLR(
         audioOkay = false;
     }
 
-    auto sourceForRightAudio = gSeeker->getSeeker(1)->getDataSourceName();
+    auto sourceForRightAudio = sourceNames.at(1);
     auto rightStartTime_sec = startTimesBySource.at(sourceForRightAudio);
     spdlog::debug("dumping audio from source '{}'", sourceForRightAudio.c_str());
     auto rightSource = project_->dataSourceManager().getSourceByName(sourceForRightAudio);
@@ -7,6 +7,8 @@
 
 #include "GoProOverlay/data/GroupedSeeker.h"
 #include "GoProOverlay/data/RenderProject.h"
+#include "GoProOverlay/data/RenderSession.h"
+#include "GoProOverlay/data/SeekTimeline.h"
 
 class RenderThread : public QThread
 {
@@ -23,6 +25,14 @@ public:
     using ResPool = concrt::ResourcePool<RenderResources, concrt::PC_Model::SPSC>;
 
 public:
+    /**
+     * Must be constructed on the thread that owns the project (ie. the GUI
+     * thread). Everything the render needs from the seekers is read here, so
+     * the render never moves or reads them. It does render with the
+     * project's engine though, whose objects each draw into their own image,
+     * so nothing else may render the engine (ie. the preview) until the
+     * export finishes. The progress dialog is modal for this reason.
+     */
     RenderThread(
         gpo::RenderProject *project,
         QString exportDir,
@@ -42,18 +52,22 @@ signals:
         qulonglong progress,
         qulonglong total);
 
+    // the render moved into other chunks of paged telemetry. the owner of
+    // the sources should trim them (see gpo::DataSource::trimTelemetry()).
+    void
+    telemetryPaged();
+
 private:
     void
     renderThreadMain(
-        gpo::RenderEnginePtr engine,
-        gpo::GroupedSeekerPtr gSeeker);
+        gpo::RenderEnginePtr engine);
 
     void
     writerThreadMain();
 
     bool
     exportAudioSingleSource(
-        gpo::GroupedSeekerPtr gSeeker,
+        const std::vector<std::string> &sourceNames,
         const std::unordered_map<std::string, double> &startTimesBySource,
         const std::filesystem::path &tmpDir,
         const std::filesystem::path &ffmpegLogFile,
@@ -62,7 +76,7 @@ private:
     
     bool
     exportAudioMultiSourceLR(
-        gpo::GroupedSeekerPtr gSeeker,
+        const std::vector<std::string> &sourceNames,
         const std::unordered_map<std::string, double> &startTimesBySource,
         const std::filesystem::path &tmpDir,
         const std::filesystem::path &ffmpegLogFile,
@@ -76,6 +90,17 @@ private:
     cv::VideoWriter vWriter_;
     double renderFPS_;
 
+    // keeps every source alive until we're done so that the objects can read
+    // them through non-owning accessors each frame
+    std::unique_ptr<gpo::RenderSession> session_;
+    // snapshot of how the seekers step, taken before the render starts
+    gpo::SeekTimeline timeline_;
+    // where the render starts (lead-in included)
+    gpo::SeekState startState_;
+    // seekers' source names, in the group's order
+    std::vector<std::string> sourceNames_;
+    std::unordered_map<std::string, double> startTimesBySource_;
+
     ResPool pool_;
     std::thread renderThread_;
     std::thread writerThread_;
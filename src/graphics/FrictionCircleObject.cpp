@@ -93,7 +93,8 @@ namespace gpo
 	}
 
 	void
-	FrictionCircleObject::subRender()
+	FrictionCircleObject::subRender(
+		const SeekState &state)
 	{
 		ZoneScopedN("FrictionCircleObject::subRender()");
 		outlineImg_.copyTo(outImg_);
@@ -102,29 +103,35 @@ namespace gpo
 			return;
 		}
 
-		auto telemSrc = tSources_.front();
+		// resolve the source once per frame rather than once per sample
+		const auto telem = tSources_.front()->accessor();
+		const auto latAccls = telem.channel<float>(eTC_CALC_VEHI_ACCL_LAT);
+		const auto lonAccls = telem.channel<float>(eTC_CALC_VEHI_ACCL_LON);
+		const size_t seekedIdx = telem.seekedIdx(state);
+		const size_t nSamps = telem.size();
 
 		// draw tail
-		int startIdx = telemSrc->seekedIdx() - tailLength_;
+		int startIdx = seekedIdx - tailLength_;
 		if (startIdx < 0)
 		{
 			startIdx = 0;
 		}
-		for (size_t i=startIdx; i<=telemSrc->seekedIdx() && i<telemSrc->size(); i++)
+		for (size_t i=startIdx; i<=seekedIdx && i<nSamps; i++)
 		{
-			bool isLast = i == telemSrc->seekedIdx();
+			bool isLast = i == seekedIdx;
 			auto color = (isLast ? currentDotColor_ : tailColor_);
 			int dotRadius = (isLast ? 20 : 6);
-			const auto &vehiAccl = telemSrc->at(i).calcSamp.vehiAccl;
+			const float lat_g = latAccls[i];
+			const float lon_g = lonAccls[i];
 
 			auto drawPoint = cv::Point(
-				vehiAccl.lat_g * radius_px_ + center_.x,
-				vehiAccl.lon_g * radius_px_ + center_.y);
+				lat_g * radius_px_ + center_.x,
+				lon_g * radius_px_ + center_.y);
 			cv::circle(outImg_,drawPoint,dotRadius,color,cv::FILLED);
 
 			if (isLast)
 			{
-				double netG = std::sqrt((vehiAccl.lat_g*vehiAccl.lat_g) + (vehiAccl.lon_g*vehiAccl.lon_g));
+				double netG = std::sqrt((lat_g*lat_g) + (lon_g*lon_g));
 				char tmpStr[1024];
 				sprintf(tmpStr,"%.1fg",netG);
 				cv::putText(
@@ -24,7 +24,8 @@ namespace gpo
 	}
 
 	void
-	LapTimerObject::subRender()
+	LapTimerObject::subRender(
+		const SeekState &state)
 	{
 		ZoneScopedN("LapTimerObject::subRender()");
 		bgImg_.copyTo(outImg_);
@@ -33,8 +34,8 @@ namespace gpo
 			return;
 		}
 
-		auto telemSrc = tSources_.front();
-		const auto &trackData = telemSrc->at(telemSrc->seekedIdx()).calcSamp;
+		const auto telem = tSources_.front()->accessor();
+		const auto &trackData = telem.at(telem.seekedIdx(state)).calcSamp;
 		if (trackData.lap != -1)
 		{
 			lapTime_ = trackData.lapTimeOffset;
@@ -465,6 +465,60 @@ QTelemetryPlot::getY_ComponentInfo(
 	throw std::runtime_error("unable to find Y_ComponentEnumInfo for " + std::to_string((int)comp));
 }
 
+gpo::TelemetryChannel_E
+QTelemetryPlot::getY_ComponentChannel(
+	gpo::TelemetryPlot::Y_Component comp)
+{
+	switch (comp)
+	{
+	case gpo::TelemetryPlot::Y_Component::eYC_UNKNOWN:
+		return gpo::eTC_COUNT;
+	case gpo::TelemetryPlot::Y_Component::eYC_TIME:
+		return gpo::eTC_T_OFFSET;
+	case gpo::TelemetryPlot::Y_Component::eYC_ACCL_X:
+		return gpo::eTC_GOPRO_ACCL_X;
+	case gpo::TelemetryPlot::Y_Component::eYC_ACCL_Y:
+		return gpo::eTC_GOPRO_ACCL_Y;
+	case gpo::TelemetryPlot::Y_Component::eYC_ACCL_Z:
+		return gpo::eTC_GOPRO_ACCL_Z;
+	case gpo::TelemetryPlot::Y_Component::eYC_GYRO_X:
+		return gpo::eTC_GOPRO_GYRO_X;
+	case gpo::TelemetryPlot::Y_Component::eYC_GYRO_Y:
+		return gpo::eTC_GOPRO_GYRO_Y;
+	case gpo::TelemetryPlot::Y_Component::eYC_GYRO_Z:
+		return gpo::eTC_GOPRO_GYRO_Z;
+	case gpo::TelemetryPlot::Y_Component::eYC_GRAV_X:
+		return gpo::eTC_GOPRO_GRAV_X;
+	case gpo::TelemetryPlot::Y_Component::eYC_GRAV_Y:
+		return gpo::eTC_GOPRO_GRAV_Y;
+	case gpo::TelemetryPlot::Y_Component::eYC_GRAV_Z:
+		return gpo::eTC_GOPRO_GRAV_Z;
+	case gpo::TelemetryPlot::Y_Component::eYC_CORI_W:
+		return gpo::eTC_GOPRO_CORI_W;
+	case gpo::TelemetryPlot::Y_Component::eYC_CORI_X:
+		return gpo::eTC_GOPRO_CORI_X;
+	case gpo::TelemetryPlot::Y_Component::eYC_CORI_Y:
+		return gpo::eTC_GOPRO_CORI_Y;
+	case gpo::TelemetryPlot::Y_Component::eYC_CORI_Z:
+		return gpo::eTC_GOPRO_CORI_Z;
+	case gpo::TelemetryPlot::Y_Component::eYC_GPS_LAT:
+		return gpo::eTC_GOPRO_GPS_LAT;
+	case gpo::TelemetryPlot::Y_Component::eYC_GPS_LON:
+		return gpo::eTC_GOPRO_GPS_LON;
+	case gpo::TelemetryPlot::Y_Component::eYC_GPS_SPEED2D:
+		return gpo::eTC_GOPRO_GPS_SPEED2D;
+	case gpo::TelemetryPlot::Y_Component::eYC_GPS_SPEED3D:
+		return gpo::eTC_GOPRO_GPS_SPEED3D;
+	case gpo::TelemetryPlot::Y_Component::eYC_ECU_ENGINE_SPEED:
+		return gpo::eTC_ECU_ENGINE_SPEED;
+	case gpo::TelemetryPlot::Y_Component::eYC_ECU_TPS:
+		return gpo::eTC_ECU_TPS;
+	case gpo::TelemetryPlot::Y_Component::eYC_ECU_BOOST:
+		return gpo::eTC_ECU_BOOST;
+	}
+	return gpo::eTC_COUNT;
+}
+
 void
 QTelemetryPlot::addSource_(
 		gpo::TelemetrySourcePtr telemSrc,
@@ -521,22 +575,39 @@ QTelemetryPlot::setX_Data(
 	auto telemSrc = sourceObjs.telemSrc;
 	auto seeker = telemSrc->seeker();
 	size_t alignmentIdx = seeker->getAlignmentIdx();
-	auto &alignmentSamp = telemSrc->at(alignmentIdx);
+	const auto tOffsets = telemSrc->channel<double>(gpo::eTC_T_OFFSET);
 	auto dataPtr = sourceObjs.graph->data();
 	auto dataItr = dataPtr->begin();
-	for (size_t i=0; i<telemSrc->size() && dataItr!=dataPtr->end(); i++, dataItr++)
+	switch (comp)
 	{
-		switch (comp)
+	case gpo::TelemetryPlot::X_Component::eXC_Samples:
+		xAxis->setLabel("samples");
+		for (size_t i=0; i<tOffsets.size() && dataItr!=dataPtr->end(); i++, dataItr++)
 		{
-		case gpo::TelemetryPlot::X_Component::eXC_Samples:
 			dataItr->key = (double)(i) - alignmentIdx;
-			xAxis->setLabel("samples");
-			break;
-		case gpo::TelemetryPlot::X_Component::eXC_Time:
-			dataItr->key = telemSrc->at(i).t_offset - alignmentSamp.t_offset;
-			xAxis->setLabel("time (s)");
-			break;
 		}
+		break;
+	case gpo::TelemetryPlot::X_Component::eXC_Time:
+		xAxis->setLabel("time (s)");
+		for (size_t i=0; i<tOffsets.size() && dataItr!=dataPtr->end(); i++, dataItr++)
+		{
+			dataItr->key = tOffsets[i] - tOffsets[alignmentIdx];
+		}
+		break;
+	}
+}
+
+template <typename T>
+static
+void
+copyChannelToValues(
+	QSharedPointer<QCPGraphDataContainer> dataPtr,
+	const gpo::ChannelView<T> &view)
+{
+	auto dataItr = dataPtr->begin();
+	for (size_t i=0; i<view.size() && dataItr!=dataPtr->end(); i++, dataItr++)
+	{
+		dataItr->value = view[i];
 	}
 }
 
@@ -546,78 +617,27 @@ QTelemetryPlot::setY_Data(
 	gpo::TelemetryPlot::Y_Component comp)
 {
 	auto dataPtr = sourceObjs.graph->data();
-	auto dataItr = dataPtr->begin();
-	for (size_t i=0; i<sourceObjs.telemSrc->size() && dataItr!=dataPtr->end(); i++, dataItr++)
+	const gpo::TelemetryChannel_E channel = getY_ComponentChannel(comp);
+	if (channel == gpo::eTC_COUNT)
 	{
-		auto &tSamp = sourceObjs.telemSrc->at(i);
-		switch (comp)
+		for (auto dataItr = dataPtr->begin(); dataItr!=dataPtr->end(); dataItr++)
 		{
-		case gpo::TelemetryPlot::Y_Component::eYC_UNKNOWN:
 			dataItr->value = 0;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_TIME:
-			dataItr->value = tSamp.t_offset;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_ACCL_X:
-			dataItr->value = tSamp.gpSamp.accl.x;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_ACCL_Y:
-			dataItr->value = tSamp.gpSamp.accl.y;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_ACCL_Z:
-			dataItr->value = tSamp.gpSamp.accl.z;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_GYRO_X:
-			dataItr->value = tSamp.gpSamp.gyro.x;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_GYRO_Y:
-			dataItr->value = tSamp.gpSamp.gyro.y;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_GYRO_Z:
-			dataItr->value = tSamp.gpSamp.gyro.z;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_GRAV_X:
-			dataItr->value = tSamp.gpSamp.grav.x;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_GRAV_Y:
-			dataItr->value = tSamp.gpSamp.grav.y;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_GRAV_Z:
-			dataItr->value = tSamp.gpSamp.grav.z;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_CORI_W:
-			dataItr->value = tSamp.gpSamp.cori.w;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_CORI_X:
-			dataItr->value = tSamp.gpSamp.cori.x;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_CORI_Y:
-			dataItr->value = tSamp.gpSamp.cori.y;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_CORI_Z:
-			dataItr->value = tSamp.gpSamp.cori.z;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_GPS_LAT:
-			dataItr->value = tSamp.gpSamp.gps.coord.lat;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_GPS_LON:
-			dataItr->value = tSamp.gpSamp.gps.coord.lon;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_GPS_SPEED2D:
-			dataItr->value = tSamp.gpSamp.gps.speed2D;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_GPS_SPEED3D:
-			dataItr->value = tSamp.gpSamp.gps.speed3D;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_ECU_ENGINE_SPEED:
-			dataItr->value = tSamp.ecuSamp.engineSpeed_rpm;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_ECU_TPS:
-			dataItr->value = tSamp.ecuSamp.tps;
-			break;
-		case gpo::TelemetryPlot::Y_Component::eYC_ECU_BOOST:
-			dataItr->value = tSamp.ecuSamp.boost_psi;
-			break;
 		}
+		return;
+	}
+
+	const auto &telemSrc = sourceObjs.telemSrc;
+	switch (gpo::getChannelDescriptor(channel).type)
+	{
+	case gpo::eCT_FLOAT:
+		copyChannelToValues(dataPtr, telemSrc->channel<float>(channel));
+		break;
+	case gpo::eCT_DOUBLE:
+		copyChannelToValues(dataPtr, telemSrc->channel<double>(channel));
+		break;
+	case gpo::eCT_INT:
+		copyChannelToValues(dataPtr, telemSrc->channel<int>(channel));
+		break;
 	}
 }
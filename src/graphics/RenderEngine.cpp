@@ -283,6 +283,31 @@ namespace gpo
 		return fps;
 	}
 
+	void
+	RenderEngine::configureVideoDecoders()
+	{
+		// multiple sources of the same video share decoders, so dedup by file
+		std::unordered_map<std::string, VideoSourcePtr> sourcesByFile;
+		for (const auto &entity : entities_)
+		{
+			for (size_t i=0; i<entity->renderObject()->numVideoSources(); i++)
+			{
+				auto vSrc = entity->renderObject()->getVideoSource(i);
+				sourcesByFile.try_emplace(vSrc->getOriginFile(), vSrc);
+			}
+		}
+
+		const auto config = VideoDecodeConfig::makeDefault(sourcesByFile.size());
+		spdlog::info(
+			"configuring {} video decoder(s) with {} threads each",
+			sourcesByFile.size(),
+			config.threads);
+		for (const auto &[file, vSrc] : sourcesByFile)
+		{
+			vSrc->setDecodeConfig(config);
+		}
+	}
+
 	GroupedSeekerPtr
 	RenderEngine::getSeeker()
 	{
@@ -292,6 +317,15 @@ namespace gpo
 	void
 	RenderEngine::renderInto(
 		cv::UMat &frame)
+	{
+		// an empty state defers to the seekers
+		renderInto(frame, SeekState());
+	}
+
+	void
+	RenderEngine::renderInto(
+		cv::UMat &frame,
+		const SeekState &state)
 	{
 		spdlog::trace(__func__);
 
@@ -324,7 +358,7 @@ namespace gpo
 
 				try
 				{
-					ent->renderObject()->render();
+					ent->renderObject()->render(state);
 				}
 				catch (const std::exception &e)
 				{
@@ -704,6 +738,8 @@ namespace gpo
 		plot->renderObject()->as<TelemetryPlotObject>()->setTelemetryColor(botData->telemSrc,QColor(BOT_COLOR[2],BOT_COLOR[1],BOT_COLOR[0],BOT_COLOR[3]));// OpenCV is BGRA; Qt is RGBA
 		engine->addEntity(plot);
 
+		engine->configureVideoDecoders();
+
 		return engine;
 	}
 
@@ -762,6 +798,8 @@ namespace gpo
 		printout->renderObject()->setVisible(false);
 		engine->addEntity(printout);
 
+		engine->configureVideoDecoders();
+
 		return engine;
 	}
 }
\ No newline at end of file
@@ -112,9 +112,17 @@ namespace gpo
 
 	void
 	RenderedObject::render()
+	{
+		// an empty state defers to the seekers
+		render(SeekState());
+	}
+
+	void
+	RenderedObject::render(
+		const SeekState &state)
 	{
 		// call subclass's render method
-		subRender();
+		subRender(state);
 		clearNeedsRedraw();
 	}
 
@@ -174,14 +174,15 @@ namespace gpo
 	}
 
 	void
-	TelemetryPlotObject::subRender()
+	TelemetryPlotObject::subRender(
+		const SeekState &state)
 	{
 		ZoneScopedN("TelemetryPlotObject::subRender()");
 		if (tSources_.size() > 0)
 		{
 			auto telemSrc = tSources_.front();
 			auto seeker = telemSrc->seeker();
-			auto offsetFromAlignment = (long long)(seeker->seekedIdx()) - seeker->getAlignmentIdx();
+			auto offsetFromAlignment = (long long)(state.seekedIdx(seeker.get())) - seeker->getAlignmentIdx();
 
 			// compute x-range to have right side aligned with 1st dataset's current
 			// seeked location, and the width sized to fit N amount of seconds worth of data.
@@ -41,16 +41,17 @@ namespace gpo
 	}
 
 	void
-	TelemetryPrintoutObject::subRender()
+	TelemetryPrintoutObject::subRender(
+		const SeekState &state)
 	{
 		ZoneScopedN("TelemetryPrintoutObject::subRender()");
 		if ( ! requirementsMet())
 		{
 			return;
 		}
-		auto telemSrc = tSources_.front();
-		auto frameIdx = telemSrc->seekedIdx();
-		auto telemSamp = telemSrc->at(frameIdx);
+		const auto telem = tSources_.front()->accessor();
+		auto frameIdx = telem.seekedIdx(state);
+		auto telemSamp = telem.at(frameIdx);
 
 		outImg_.setTo(RGBA_COLOR(0,0,0,0));
 
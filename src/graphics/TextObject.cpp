@@ -86,7 +86,8 @@ namespace gpo
 	}
 
 	void
-	TextObject::subRender()
+	TextObject::subRender(
+		const SeekState & /* state */)
 	{
 		// do no rendering. we draw text directly into the image in drawInto()
 	}
@@ -151,7 +151,8 @@ namespace gpo
 	}
 
 	void
-	TrackMapObject::subRender()
+	TrackMapObject::subRender(
+		const SeekState &state)
 	{
 		ZoneScopedN("TrackMapObject::subRender()");
 		outlineImg_.copyTo(outImg_);
@@ -162,9 +163,9 @@ namespace gpo
 
 		for (unsigned int ss=0; ss<tSources_.size(); ss++)
 		{
-			auto telemSrc = tSources_.at(ss);
+			const auto telem = tSources_.at(ss)->accessor();
 
-			const auto &currSample = telemSrc->at(telemSrc->seekedIdx());
+			const auto &currSample = telem.at(telem.seekedIdx(state));
 			auto dotPoint = coordToPoint(currSample.calcSamp.onTrackLL);
 			cv::circle(outImg_,dotPoint,dotRadius_px_,dotColors_.at(ss),cv::FILLED);
 		}
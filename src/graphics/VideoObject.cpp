@@ -48,18 +48,19 @@ namespace gpo
 	}
 
 	void
-	VideoObject::subRender()
+	VideoObject::subRender(
+		const SeekState &state)
 	{
 		ZoneScopedN("VideoObject::subRender()");
 		if ( ! requirementsMet())
 		{
 			return;
 		}
-		auto vSource = vSources_.front();
+		auto video = vSources_.front()->accessor();
 
-		auto frameIdx = vSource->seekedIdx();
+		auto frameIdx = video.seekedIdx(state);
 		bool needNewFrame = frameIdx != prevRenderedFrameIdx_;
-		if (needNewFrame && ! vSource->getFrame(outImg_,frameIdx))
+		if (needNewFrame && ! video.getFrame(outImg_,frameIdx))
 		{
 			throw std::runtime_error("getFrame() failed on frameIdx " + std::to_string(frameIdx));
 		}
@@ -1,15 +1,19 @@
 #pragma once
 
-#include <opencv2/videoio.hpp>
+#include <atomic>
 #include <filesystem>
 #include <memory>
+#include <thread>
 #include <vector>
 #include <yaml-cpp/node/node.h>
 
+#include "TelemetryColumns.h"
 #include "TelemetrySeeker.h"
 #include "TelemetrySource.h"
 #include "TrackDataObjects.h"
+#include "VideoDecoderPool.h"
 #include "VideoSource.h"
+#include "GoProOverlay/utils/DataProcessingUtils.h"
 
 namespace gpo
 {
@@ -18,11 +22,16 @@ namespace gpo
 
 	using DataSourcePtr = std::shared_ptr<DataSource>;
 
+	// default cap on decoded paged telemetry per DataSource
+	constexpr size_t DEFAULT_TELEMETRY_MEMORY_LIMIT = 256 * 1024 * 1024;
+
 	class DataSource
 	{
 	public:
 		DataSource();
 
+		~DataSource();
+
 		std::string
 		getSourceName() const;
 
@@ -59,16 +68,85 @@ namespace gpo
 		double
 		getTelemetryRate_hz() const;
 
+		/**
+		 * Resamples the telemetry to 'newRate_hz'. see utils::resample().
+		 */
 		void
 		resampleTelemetry(
-			double newRate_hz);
+			double newRate_hz,
+			const utils::ResamplerConfig &config = utils::ResamplerConfig::makeLinear());
 
+		/**
+		 * Makes a copy of this DataSource. Telemetry chunks are shared with
+		 * the copy until either one modifies them, so this is cheap even
+		 * for long recordings.
+		 */
 		DataSourcePtr
 		duplicate() const;
 
+		/**
+		 * Enables/disables compact telemetry storage. When enabled, only
+		 * channels flagged as available are stored, and channels that can
+		 * tolerate it are quantized to float32 or 16bit fixed-point. Useful
+		 * for very long sessions where memory use adds up.
+		 */
+		void
+		setCompactTelemetry(
+			bool compact);
+
+		bool
+		isTelemetryCompact() const;
+
+		/**
+		 * Caps how much decoded telemetry can be held in memory for sources
+		 * that are paged in on demand (archives and cached videos).
+		 * Chunks are loaded around the seeker as it moves, and the least
+		 * recently used ones are evicted once over the limit. Has no effect
+		 * on telemetry that's fully resident, such as freshly parsed or
+		 * processed samples.
+		 * 
+		 * @param[in] maxBytes
+		 * the limit, or 0 for unlimited
+		 */
+		void
+		setTelemetryMemoryLimit(
+			size_t maxBytes);
+
+		size_t
+		getTelemetryMemoryLimit() const;
+
+		/**
+		 * Evicts the least recently used paged telemetry until it's back
+		 * under the memory limit. Chunks that are pinned (ie. by a
+		 * RenderSession) stay loaded. Call this from the thread that owns
+		 * the source, while other threads render from it.
+		 */
+		void
+		trimTelemetry();
+
+		/**
+		 * Starts decoding paged telemetry that hasn't been read yet on a
+		 * background thread, from the start of the recording onward. This
+		 * lets a source be shown right away while the rest of it streams in.
+		 * Streaming stops early once the memory limit is reached.
+		 */
+		void
+		streamTelemetryInBackground();
+
+		/**
+		 * Stops background streaming and waits for the thread to exit
+		 */
+		void
+		stopStreamingTelemetry();
+
+		bool
+		isStreamingTelemetry() const;
+
 		/**
 		 * Save the current state of the telemetry samples, allowing
-		 * you to restore them via restoreTelemetry().
+		 * you to restore them via restoreTelemetry(). The backup shares
+		 * telemetry chunks with the live samples, so only the chunks that
+		 * are later modified take up extra memory.
 		 * 
 		 * @return
 		 * true if telemetry samples were backed up
@@ -113,10 +191,21 @@ namespace gpo
 		loadDataFromFile(
 			const std::filesystem::path &sourceFile);
 
+		/**
+		 * Loads telemetry and video metadata from a GoPro MP4 file.
+		 * 
+		 * @param[in] useCache
+		 * if true, the parsed telemetry (including derived calc channels)
+		 * and video metadata are restored from the file's cache in the
+		 * per-user cache dir when it's valid, and the cache is (re)written
+		 * after a full parse. if the cache can't be written the video is
+		 * simply loaded uncached. see utils/io/cache.h for details.
+		 */
 		static
 		DataSourcePtr
 		loadDataFromVideo(
-			const std::filesystem::path &videoFile);
+			const std::filesystem::path &videoFile,
+			bool useCache = true);
 
 		static
 		DataSourcePtr
@@ -133,6 +222,17 @@ namespace gpo
 		loadTelemetryFromCSV(
 			const std::filesystem::path &csvFile);
 
+		/**
+		 * Loads telemetry from a file written by writeTelemetryToBinary() or
+		 * writeTelemetryToArchive(). The file is memory mapped rather than
+		 * parsed, so this is much faster than loading the equivalent CSV.
+		 * Archived telemetry is decompressed as it's seeked through.
+		 */
+		static
+		DataSourcePtr
+		loadTelemetryFromBinary(
+			const std::filesystem::path &binFile);
+
 		static
 		DataSourcePtr
 		makeDataFromTelemetry(
@@ -142,6 +242,23 @@ namespace gpo
 		writeTelemetryToCSV(
 			const std::filesystem::path &csvFilepath) const;
 
+		/**
+		 * Writes telemetry to the native binary format (see utils/io/gpot.h).
+		 * Compact telemetry is written in its compact encoding.
+		 */
+		bool
+		writeTelemetryToBinary(
+			const std::filesystem::path &binFilepath) const;
+
+		/**
+		 * Writes telemetry to a compressed archive (see utils/io/gpot.h).
+		 * Meant for long term storage; it's roughly an order of magnitude
+		 * smaller than the binary format.
+		 */
+		bool
+		writeTelemetryToArchive(
+			const std::filesystem::path &archiveFilepath) const;
+
 		/**
 		 * Merges all available telemetry data from another source into this
 		 * one. For this to be successful, the two sources need to have similar
@@ -201,19 +318,39 @@ namespace gpo
 		TelemetrySourcePtr telemSrc;
 		VideoSourcePtr videoSrc;
 
+	private:
+		// replaces the telemetry with processed samples, keeping the
+		// columns' storage layout in sync with 'dataAvail_'
+		void
+		storeSamples(
+			const TelemetrySamples &samples);
+
+		// called by the seeker whenever it moves into a different chunk.
+		// loads that chunk and trims paged telemetry down to the memory
+		// limit if anything new had to be loaded.
+		void
+		pageTelemetryAround(
+			size_t idx);
+
 	private:
 		// allow DataSourceManager to modify sourceName_ and originFile_
 		friend class DataSourceManager;
 
+		friend class RenderSession;
 		friend class TelemetrySeeker;
 		friend class TelemetrySource;
 		friend class VideoSource;
 
-		cv::VideoCapture vCapture_;
-		TelemetrySamplesPtr samples_;
+		// decoders for the video file. shared with duplicated DataSources.
+		VideoDecoderPoolPtr decoderPool_;
 
-		// user can backup telemetry samples, and this is where they are stored
-		TelemetrySamples backupSamples_;
+		// columnar telemetry storage. the pointer itself remains stable for
+		// the life of the DataSource; modifications are made in place.
+		TelemetryColumnsPtr columns_;
+
+		// user can backup telemetry samples, and this is where they are stored.
+		// chunks are shared with 'columns_' until one side modifies them.
+		TelemetryColumns backupColumns_;
 
 		// bitset defining which fields are valid in 'TelemetrySample'
 		// query bits using gpo::DataAvailable enum literals
@@ -222,6 +359,16 @@ namespace gpo
 		std::string sourceName_;
 		std::string originFile_;
 		std::shared_ptr<const Track> datumTrack_;
+		// lets reprocessDatumTrack() skip work that track edits didn't
+		// affect. cleared whenever the telemetry is replaced or merged into.
+		utils::TrackTimesCache trackTimesCache_;
+
+		// see setTelemetryMemoryLimit()
+		size_t telemMemoryLimit_;
+
+		std::thread streamThread_;
+		std::atomic<bool> streamStop_;
+		std::atomic<bool> streaming_;
 
 	};
 
@@ -273,6 +420,32 @@ namespace gpo
 		getSourceByName(
 			const std::string &sourceName) const;
 
+		/**
+		 * Applies a decode config to all current and future video sources.
+		 * Without one, the RenderEngine picks defaults based on the number
+		 * of videos it's rendering (see RenderEngine::configureVideoDecoders()).
+		 */
+		void
+		setDecodeConfig(
+			const VideoDecodeConfig &config);
+
+		void
+		clearDecodeConfig();
+
+		bool
+		hasDecodeConfig() const;
+
+		const VideoDecodeConfig &
+		getDecodeConfig() const;
+
+		/**
+		 * @return
+		 * a report of every video source's active decode config along with
+		 * its measured decode rate.
+		 */
+		YAML::Node
+		getDecodeReport() const;
+
 		// YAML encode/decode
 		YAML::Node
 		encode() const;
@@ -290,5 +463,9 @@ namespace gpo
 	private:
 		std::vector<DataSourcePtr> sources_ = {};
 
+		// user specified decode config. only valid if 'hasDecodeConfig_' is set.
+		VideoDecodeConfig decodeConfig_ = {};
+		bool hasDecodeConfig_ = false;
+
 	};
 }
\ No newline at end of file
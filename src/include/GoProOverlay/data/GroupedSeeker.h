@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 #include <GoProOverlay/data/RenderProject.h>
+#include "GoProOverlay/data/SeekState.h"
+#include "GoProOverlay/data/SeekTimeline.h"
 #include "GoProOverlay/data/TelemetrySeeker.h"
 
 namespace gpo
@@ -48,10 +51,40 @@ namespace gpo
 		removeAllSeekers(
 			TelemetrySeekerPtr seeker);
 
+		/**
+		 * Steps the group by time rather than by sample. Each nextAll()
+		 * moves a clock running at 'rate_hz' (ie. the export's frame rate)
+		 * forward one tick, and every seeker shows its sample nearest the
+		 * clock. Each source precomputes which sample that is for every
+		 * tick, so sources with different sample rates (ie. a 10Hz ECU log
+		 * next to a 59.94fps video) play together without being resampled
+		 * first. Seek limits and relative seeks count ticks instead of
+		 * samples while the clock is running.
+		 *
+		 * @param[in] rate_hz
+		 * the clock's rate. 0 goes back to stepping every seeker one
+		 * sample at a time.
+		 */
+		void
+		setMasterClock(
+			double rate_hz);
+
+		/**
+		 * @return
+		 * the master clock's rate, or 0 if seekers step by sample
+		 */
+		double
+		masterClockRate() const;
+
+		/**
+		 * Steps every seeker back one sample (or one master clock tick).
+		 * When the master clock is running, everyone always stops together.
+		 */
 		void
 		prevAll(
 			bool onlyIfAllHavePrev = true);
 
+		// same as prevAll(), but steps forward
 		void
 		nextAll(
 			bool onlyIfAllHaveNext = true,
@@ -99,6 +132,89 @@ namespace gpo
 		seekAllToLapExit(
 			unsigned int lap);
 
+		/**
+		 * Seeks every seeker to where it entered the lap's sector
+		 *
+		 * @return
+		 * true if every seeker drove the sector. nobody is moved otherwise.
+		 */
+		bool
+		seekAllToSectorEntry(
+			unsigned int lap,
+			unsigned int sector);
+
+		// same as seekAllToSectorEntry(), but seeks to the sector's exit
+		bool
+		seekAllToSectorExit(
+			unsigned int lap,
+			unsigned int sector);
+
+		/**
+		 * Lines up each seeker's lap with the first seeker's lap by where
+		 * they were on the track, rather than at a single point. While the
+		 * first seeker is within the lap, the others follow a schedule that
+		 * holds or skips their samples to stay at the same spot on the track.
+		 * Outside the lap, everyone steps together like normal.
+		 *
+		 * @param[in] bandRadius_sec
+		 * the most a run can lead or trail the first seeker's within the lap
+		 *
+		 * @return
+		 * true if every seeker's lap could be warped. false otherwise.
+		 */
+		bool
+		warpAllToLap(
+			unsigned int lap,
+			double bandRadius_sec = 5.0);
+
+		/**
+		 * Stops following any schedules set up by warpAllToLap()
+		 */
+		void
+		clearWarpSchedules();
+
+		/**
+		 * @return
+		 * a snapshot of where every seeker in the group is now
+		 */
+		SeekState
+		currentState() const;
+
+		/**
+		 * Computes where the seekers would be after 'frame' calls to
+		 * nextAll() from 'start', without moving any of them. Warp schedules
+		 * and the master clock are followed just like nextAll() would.
+		 * Reads the seekers, so only call this from the thread that moves
+		 * them. Use timeline() to step from other threads.
+		 */
+		SeekState
+		stateAt(
+			const SeekState &start,
+			size_t frame) const;
+
+		/**
+		 * @return
+		 * a snapshot of how the group steps right now (its seekers, master
+		 * clock and warp schedules). It stays the same no matter what's done
+		 * to the group afterwards, so other threads can step with it.
+		 */
+		SeekTimeline
+		timeline() const;
+
+		/**
+		 * Same as timeline(), but steps by a clock running at 'clockRate_hz'
+		 * instead of the group's own master clock, which is left alone. This
+		 * lets an export step by its frame rate while the preview keeps
+		 * stepping the way it was. Schedules that the seekers already have
+		 * for that rate are shared rather than built again.
+		 *
+		 * @param[in] clockRate_hz
+		 * the clock's rate, or 0 to step by sample
+		 */
+		SeekTimeline
+		timeline(
+			double clockRate_hz) const;
+
 		/**
 		 * Imagine we have three TelemetrySeekers that are seeked to some random point in
 		 * their data set. If we aligned them all based on their current location, then
@@ -138,9 +254,50 @@ namespace gpo
         subclassSaveModifications(
         	bool unnecessaryIsOkay) override;
 
+	private:
+		/**
+		 * Seeks followers to where their schedule says they should be, given
+		 * where the leader is now
+		 */
+		void
+		followWarpSchedules();
+
+		void
+		seekAllTo(
+			const SeekState &state);
+
+		/**
+		 * @return
+		 * true if the seekers are still where the master clock left them
+		 * (ie. nobody was moved with seekToIdx() directly)
+		 */
+		bool
+		clockInSync() const;
+
+		// moves the master clock by 'steps' ticks and the seekers with it
+		void
+		stepClock(
+			int64_t steps);
+
 	private:
 		std::vector<TelemetrySeekerPtr> seekers_;
 
+		struct WarpSchedule
+		{
+			TelemetrySeekerPtr leader;
+			TelemetrySeekerPtr follower;
+			// leader's index where the schedule begins
+			size_t leaderStartIdx;
+			// follower's index for each of the leader's from 'leaderStartIdx' on.
+			// shared with any timelines that were taken while it was set.
+			std::shared_ptr<const std::vector<size_t>> followerIdxs;
+		};
+		std::vector<WarpSchedule> warpSchedules_;
+
+		double masterClock_hz_;
+		// where the master clock last left the seekers
+		SeekState clockState_;
+
 	};
 
 	using GroupedSeekerPtr = std::shared_ptr<GroupedSeeker>;
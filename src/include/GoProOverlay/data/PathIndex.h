@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <opencv2/core/matx.hpp> // for cv::Vec2d
+#include <tuple>
+#include <vector>
+
+namespace gpo
+{
+
+	/**
+	 * Spatial index over a path of points for nearest point queries. It's a
+	 * k-d tree that also tracks the range of path indices in each subtree,
+	 * so queries can be restricted to a window of the path and still prune
+	 * most of the tree. Ties are broken towards the lower path index, which
+	 * matches a linear scan.
+	 *
+	 * The index references the path it was built from, so the path must
+	 * outlive it and not change.
+	 */
+	class PathIndex
+	{
+	public:
+		// windows this small are faster to scan than to search
+		static constexpr size_t LINEAR_SCAN_THRESHOLD = 256;
+
+		explicit
+		PathIndex(
+			const std::vector<cv::Vec2d> &path);
+
+		/**
+		 * Finds the path point nearest to 'p' with an index in [startIdx, endIdx).
+		 *
+		 * @return
+		 * 'found' is false if the window contains no points
+		 */
+		std::tuple<bool, cv::Vec2d, size_t>
+		findClosest(
+			const cv::Vec2d &p,
+			size_t startIdx,
+			size_t endIdx) const;
+
+		/**
+		 * @return
+		 * true if this index was built from 'path' (ie. the same vector)
+		 */
+		bool
+		isBuiltFrom(
+			const std::vector<cv::Vec2d> &path) const;
+
+	private:
+		struct Query
+		{
+			cv::Vec2d p;
+			size_t startIdx;
+			size_t endIdx;
+			double bestDistSqr;
+			size_t bestIdx;
+		};
+
+		void
+		build(
+			size_t lo,
+			size_t hi);
+
+		void
+		search(
+			Query &q,
+			size_t lo,
+			size_t hi) const;
+
+	private:
+		const std::vector<cv::Vec2d> &path_;
+
+		// path indices arranged as an implicit k-d tree. the node for the
+		// range [lo, hi) is stored at (lo + hi) / 2, and its children cover
+		// [lo, mid) and [mid + 1, hi).
+		std::vector<uint32_t> order_;
+		struct Node
+		{
+			// bounding box of the points beneath the node
+			cv::Vec2d min;
+			cv::Vec2d max;
+			// range of path indices beneath the node
+			uint32_t minIdx;
+			uint32_t maxIdx;
+			// axis the node splits on
+			uint8_t axis;
+		};
+		// indexed the same as 'order_'
+		std::vector<Node> nodes_;
+
+	};
+
+}
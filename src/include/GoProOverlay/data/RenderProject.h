@@ -23,6 +23,9 @@ struct LapAlignment
 {
 	unsigned int lap;
 	ElementSide_E side;
+	// keep sources lined up by track position throughout the lap rather
+	// than only at the alignment point (see GroupedSeeker::warpAllToLap())
+	bool warp = false;
 };
 
 struct SectorAlignment
@@ -189,6 +192,14 @@ public:
 	void
 	reprocessDatumTrack();
 
+	/**
+	 * Configures the video decoders prior to rendering. Uses the
+	 * DataSourceManager's decode config if the user provided one, otherwise
+	 * lets the engine choose defaults.
+	 */
+	void
+	configureVideoDecoders();
+
 	void
 	setEngine(
 		RenderEnginePtr engine);
@@ -270,6 +281,7 @@ namespace YAML
 			Node node;
 			node["lap"] = rhs.lap;
 			node["side"] = (int)rhs.side;
+			node["warp"] = rhs.warp;
 
 			return node;
 		}
@@ -281,6 +293,7 @@ namespace YAML
 		{
 			YAML_TO_FIELD(node,"lap",rhs.lap);
 			rhs.side = (gpo::ElementSide_E)node["side"].as<int>();
+			YAML_TO_FIELD_W_DEFAULT(node,"warp",rhs.warp,false);
 
 			return true;
 		}
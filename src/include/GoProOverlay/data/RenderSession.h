@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+
+#include "DataSource.h"
+#include "SeekState.h"
+
+namespace gpo
+{
+
+	/**
+	 * Keeps every DataSource in a DataSourceManager alive for as long as the
+	 * session exists, so the accessors that rendered objects take from their
+	 * sources (see TelemetrySource::accessor()) stay valid. Hold one for the
+	 * duration of a render or an analysis pass. Sources added to the manager
+	 * after the session starts aren't pinned.
+	 */
+	class RenderSession
+	{
+	public:
+		explicit
+		RenderSession(
+			const DataSourceManager &dsm);
+
+		size_t
+		sourceCount() const;
+
+		const DataSourcePtr &
+		getSource(
+			size_t idx) const;
+
+		/**
+		 * Keeps the chunk of telemetry that each source is seeked to in
+		 * 'state' loaded, until a later state moves it into another chunk.
+		 * Nothing is ever trimmed here, so this is safe to call from a
+		 * render thread. Paged telemetry is left for the thread that owns
+		 * the sources to trim (see DataSource::trimTelemetry()).
+		 *
+		 * @return
+		 * true if any source moved into another chunk
+		 */
+		bool
+		pageAround(
+			const SeekState &state);
+
+	private:
+		std::vector<DataSourcePtr> pinned_;
+
+		// chunk index that each source last pinned in pageAround()
+		std::vector<size_t> pinnedChunkIdxs_;
+		std::vector<std::vector<TelemetryChunkPin>> chunkPins_;
+
+	};
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace gpo
+{
+	// forward declaration
+	class TelemetrySeeker;
+
+	/**
+	 * Immutable snapshot of where a group of seekers are. Rendering from a
+	 * SeekState rather than the seekers themselves lets a frame be rendered
+	 * while the seekers are moved elsewhere (ie. scrubbing during an export),
+	 * and lets workers render different frames at the same time.
+	 *
+	 * An empty state defers to each seeker's live position.
+	 */
+	class SeekState
+	{
+	public:
+		struct Entry
+		{
+			const TelemetrySeeker *seeker;
+			size_t idx;
+			// the master clock tick the seeker is on (see
+			// GroupedSeeker::setMasterClock()). a slow source stays on the
+			// same sample for several ticks, so this is kept alongside 'idx'
+			// rather than being worked out from it. -1 if there's no clock.
+			size_t clockTick = -1;
+		};
+
+		SeekState() = default;
+
+		explicit
+		SeekState(
+			std::vector<Entry> entries);
+
+		/**
+		 * @return
+		 * where 'seeker' is in this state, or its live position if the state
+		 * is empty
+		 *
+		 * @throw std::out_of_range
+		 * if the state isn't empty and 'seeker' isn't part of it. the live
+		 * position can't be read safely from a thread that's rendering.
+		 */
+		size_t
+		seekedIdx(
+			const TelemetrySeeker *seeker) const;
+
+		/**
+		 * @return
+		 * the entry for 'seeker', or nullptr if it isn't part of the state
+		 */
+		const Entry *
+		find(
+			const TelemetrySeeker *seeker) const;
+
+		const std::vector<Entry> &
+		entries() const;
+
+		bool
+		empty() const;
+
+	private:
+		std::vector<Entry> entries_;
+
+	};
+}
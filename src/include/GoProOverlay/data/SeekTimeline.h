@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "GoProOverlay/data/SeekState.h"
+#include "GoProOverlay/data/TelemetrySeeker.h"
+
+namespace gpo
+{
+	/**
+	 * Immutable copy of everything needed to step a group of seekers: how
+	 * many samples each one has, their master clock schedules and any warp
+	 * schedules (see GroupedSeeker::timeline()). Stepping a timeline never
+	 * reads the seekers, so a render thread can work from one while the
+	 * seekers are moved, re-clocked or re-warped by the preview.
+	 */
+	class SeekTimeline
+	{
+	public:
+		struct Track
+		{
+			const TelemetrySeeker *seeker;
+			size_t nSamps;
+			// nullptr if the timeline steps by sample
+			ClockSchedulePtr clock;
+		};
+
+		struct Warp
+		{
+			const TelemetrySeeker *leader;
+			const TelemetrySeeker *follower;
+			// leader's index where the schedule begins
+			size_t leaderStartIdx;
+			// follower's index for each of the leader's from 'leaderStartIdx' on
+			std::shared_ptr<const std::vector<size_t>> followerIdxs;
+		};
+
+		SeekTimeline() = default;
+
+		/**
+		 * @param[in] clockRate_hz
+		 * rate of the clock that every track's schedule was built for, or 0
+		 * if the timeline steps by sample
+		 */
+		SeekTimeline(
+			std::vector<Track> tracks,
+			std::vector<Warp> warps,
+			double clockRate_hz);
+
+		double
+		clockRate() const;
+
+		/**
+		 * Adopts a state that was taken from somewhere else (ie. another
+		 * timeline or the seekers' live positions)
+		 *
+		 * @return
+		 * 'state' with each track's clock tick worked out again from its
+		 * sample, so that it's on this timeline's clock
+		 */
+		SeekState
+		stateOf(
+			const SeekState &state) const;
+
+		/**
+		 * Computes where the seekers would be after 'frame' steps forward
+		 * from 'start'. This doesn't depend on the states before it, so any
+		 * number of threads can each render their own frames.
+		 */
+		SeekState
+		stateAt(
+			const SeekState &start,
+			size_t frame) const;
+
+		/**
+		 * Same as stateAt(), but can step backwards too. Everyone stops once
+		 * any track runs out of samples (or ticks).
+		 */
+		SeekState
+		step(
+			const SeekState &start,
+			int64_t steps) const;
+
+		/**
+		 * @return
+		 * how many steps every track can take backwards and forwards from
+		 * 'state' (see GroupedSeeker::relativeSeekLimits())
+		 */
+		std::pair<size_t, size_t>
+		stepLimits(
+			const SeekState &state) const;
+
+	private:
+		/**
+		 * @return
+		 * where 'track' is in 'state', with its clock tick filled in if the
+		 * timeline has a clock
+		 */
+		SeekState::Entry
+		entryOf(
+			const SeekState &state,
+			const Track &track) const;
+
+		std::pair<size_t, size_t>
+		stepLimits(
+			const Track &track,
+			const SeekState::Entry &entry) const;
+
+		// moves 'entry' by 'steps', stopping at either end of the track
+		SeekState::Entry
+		stepEntry(
+			const Track &track,
+			const SeekState::Entry &entry,
+			int64_t steps) const;
+
+		// nullptr if 'seeker' isn't part of the timeline
+		const Track *
+		findTrack(
+			const TelemetrySeeker *seeker) const;
+
+		static
+		size_t
+		tickOf(
+			const Track &track,
+			size_t idx);
+
+	private:
+		std::vector<Track> tracks_;
+		std::vector<Warp> warps_;
+		double clockRate_hz_ = 0.0;
+
+	};
+}
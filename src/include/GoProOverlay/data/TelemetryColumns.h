@@ -0,0 +1,1044 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "TelemetrySample.h"
+
+namespace gpo
+{
+	// every scalar field within a TelemetrySample gets its own channel
+	enum TelemetryChannel_E
+	{
+		eTC_T_OFFSET = 0,
+
+		// GoPro
+		eTC_GOPRO_ACCL_X,
+		eTC_GOPRO_ACCL_Y,
+		eTC_GOPRO_ACCL_Z,
+		eTC_GOPRO_GYRO_X,
+		eTC_GOPRO_GYRO_Y,
+		eTC_GOPRO_GYRO_Z,
+		eTC_GOPRO_GRAV_X,
+		eTC_GOPRO_GRAV_Y,
+		eTC_GOPRO_GRAV_Z,
+		eTC_GOPRO_CORI_W,
+		eTC_GOPRO_CORI_X,
+		eTC_GOPRO_CORI_Y,
+		eTC_GOPRO_CORI_Z,
+		eTC_GOPRO_GPS_LAT,
+		eTC_GOPRO_GPS_LON,
+		eTC_GOPRO_GPS_ALTITUDE,
+		eTC_GOPRO_GPS_SPEED2D,
+		eTC_GOPRO_GPS_SPEED3D,
+
+		// ECU
+		eTC_ECU_ENGINE_SPEED,
+		eTC_ECU_TPS,
+		eTC_ECU_BOOST,
+
+		// Calculated
+		eTC_CALC_ON_TRACK_LAT,
+		eTC_CALC_ON_TRACK_LON,
+		eTC_CALC_LAP,
+		eTC_CALC_LAP_TIME_OFFSET,
+		eTC_CALC_SECTOR,
+		eTC_CALC_SECTOR_TIME_OFFSET,
+		eTC_CALC_SMOOTH_ACCL_X,
+		eTC_CALC_SMOOTH_ACCL_Y,
+		eTC_CALC_SMOOTH_ACCL_Z,
+		eTC_CALC_VEHI_ACCL_LAT,
+		eTC_CALC_VEHI_ACCL_LON,
+		eTC_CALC_TRACK_DISTANCE,
+
+		// must be last
+		eTC_COUNT
+	};
+
+	enum ChannelType_E
+	{
+		eCT_FLOAT = 0,
+		eCT_DOUBLE = 1,
+		eCT_INT = 2
+	};
+
+	template <typename T>
+	constexpr ChannelType_E
+	channelTypeOf();
+
+	template <>
+	constexpr ChannelType_E
+	channelTypeOf<float>()
+	{
+		return eCT_FLOAT;
+	}
+
+	template <>
+	constexpr ChannelType_E
+	channelTypeOf<double>()
+	{
+		return eCT_DOUBLE;
+	}
+
+	template <>
+	constexpr ChannelType_E
+	channelTypeOf<int>()
+	{
+		return eCT_INT;
+	}
+
+	// how a channel's values are laid out in memory
+	enum ChannelEncoding_E
+	{
+		// stored as the channel's ChannelType_E
+		eCE_NATIVE = 0,
+		// double values stored as 32bit floats
+		eCE_FLOAT32 = 1,
+		// values stored as 16bit fixed-point integers (value = raw * scale)
+		eCE_FIXED16 = 2,
+		// channel isn't stored at all. all values read back as 0.
+		eCE_ABSENT = 3
+	};
+
+	struct ChannelDescriptor
+	{
+		TelemetryChannel_E channel;
+
+		// same as the column title used in telemetry CSV files
+		const char *name;
+
+		// DataAvailable bit that flags this channel as valid.
+		// -1 if the channel is always valid (ie. t_offset).
+		int availBit;
+
+		// byte offset of the channel's field within a TelemetrySample
+		size_t sampleOffset;
+
+		ChannelType_E type;
+
+		// sizeof() the channel's type
+		size_t typeSize;
+
+		// encoding used when the channel is stored compactly. only chosen
+		// for channels whose precision tolerates it.
+		ChannelEncoding_E compactEncoding;
+
+		// quantization step for eCE_FIXED16 encoding
+		double compactScale;
+
+		// true if the channel is a smoothly varying measurement that can be
+		// resampled with a band-limited (windowed-sinc) kernel. channels
+		// with steps or resets (counters, lap/sector timers, map matched
+		// positions) ring under such kernels, so they're always resampled
+		// linearly.
+		bool bandLimited;
+	};
+
+	#define MAKE_CHANNEL(CHANNEL, MEMBER, NAME, AVAIL_BIT, COMPACT_ENCODING, COMPACT_SCALE, BAND_LIMITED) \
+		ChannelDescriptor{ \
+			CHANNEL, \
+			NAME, \
+			AVAIL_BIT, \
+			offsetof(TelemetrySample, MEMBER), \
+			channelTypeOf<std::remove_reference_t<decltype(std::declval<TelemetrySample>().MEMBER)>>(), \
+			sizeof(std::declval<TelemetrySample>().MEMBER), \
+			COMPACT_ENCODING, \
+			COMPACT_SCALE, \
+			BAND_LIMITED}
+
+	/**
+	 * Descriptors for all channels, indexed by TelemetryChannel_E. It's
+	 * constexpr so that code touching every field of a TelemetrySample
+	 * (ie. utils::lerp()) can be generated from it at compile time.
+	 */
+	inline constexpr std::array<ChannelDescriptor, eTC_COUNT> CHANNEL_DESCRIPTORS = {
+		MAKE_CHANNEL(eTC_T_OFFSET, t_offset, "t_offset", -1, eCE_NATIVE, 1.0, false),
+		MAKE_CHANNEL(eTC_GOPRO_ACCL_X, gpSamp.accl.x, "accl_x", eDA_GOPRO_ACCL, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_ACCL_Y, gpSamp.accl.y, "accl_y", eDA_GOPRO_ACCL, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_ACCL_Z, gpSamp.accl.z, "accl_z", eDA_GOPRO_ACCL, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_GYRO_X, gpSamp.gyro.x, "gyro_x", eDA_GOPRO_GYRO, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_GYRO_Y, gpSamp.gyro.y, "gyro_y", eDA_GOPRO_GYRO, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_GYRO_Z, gpSamp.gyro.z, "gyro_z", eDA_GOPRO_GYRO, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_GRAV_X, gpSamp.grav.x, "grav_x", eDA_GOPRO_GRAV, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_GRAV_Y, gpSamp.grav.y, "grav_y", eDA_GOPRO_GRAV, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_GRAV_Z, gpSamp.grav.z, "grav_z", eDA_GOPRO_GRAV, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_CORI_W, gpSamp.cori.w, "cori_w", eDA_GOPRO_CORI, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_CORI_X, gpSamp.cori.x, "cori_x", eDA_GOPRO_CORI, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_CORI_Y, gpSamp.cori.y, "cori_y", eDA_GOPRO_CORI, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_CORI_Z, gpSamp.cori.z, "cori_z", eDA_GOPRO_CORI, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_GPS_LAT, gpSamp.gps.coord.lat, "gps_lat", eDA_GOPRO_GPS_LATLON, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_GPS_LON, gpSamp.gps.coord.lon, "gps_lon", eDA_GOPRO_GPS_LATLON, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_GPS_ALTITUDE, gpSamp.gps.altitude, "gps_altitude", eDA_GOPRO_GPS_ALTITUDE, eCE_FLOAT32, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_GPS_SPEED2D, gpSamp.gps.speed2D, "gps_speed2D", eDA_GOPRO_GPS_SPEED2D, eCE_FLOAT32, 1.0, true),
+		MAKE_CHANNEL(eTC_GOPRO_GPS_SPEED3D, gpSamp.gps.speed3D, "gps_speed3D", eDA_GOPRO_GPS_SPEED3D, eCE_FLOAT32, 1.0, true),
+		MAKE_CHANNEL(eTC_ECU_ENGINE_SPEED, ecuSamp.engineSpeed_rpm, "engineSpeed", eDA_ECU_ENGINE_SPEED, eCE_FIXED16, 1.0, true),
+		MAKE_CHANNEL(eTC_ECU_TPS, ecuSamp.tps, "tps", eDA_ECU_TPS, eCE_FIXED16, 0.01, true),
+		MAKE_CHANNEL(eTC_ECU_BOOST, ecuSamp.boost_psi, "boost", eDA_ECU_BOOST, eCE_FIXED16, 0.01, true),
+		MAKE_CHANNEL(eTC_CALC_ON_TRACK_LAT, calcSamp.onTrackLL.lat, "onTrackLL_lat", eDA_CALC_ON_TRACK_LATLON, eCE_NATIVE, 1.0, false),
+		MAKE_CHANNEL(eTC_CALC_ON_TRACK_LON, calcSamp.onTrackLL.lon, "onTrackLL_lon", eDA_CALC_ON_TRACK_LATLON, eCE_NATIVE, 1.0, false),
+		MAKE_CHANNEL(eTC_CALC_LAP, calcSamp.lap, "lap", eDA_CALC_LAP, eCE_FIXED16, 1.0, false),
+		MAKE_CHANNEL(eTC_CALC_LAP_TIME_OFFSET, calcSamp.lapTimeOffset, "lapTimeOffset", eDA_CALC_LAP_TIME_OFFSET, eCE_FLOAT32, 1.0, false),
+		MAKE_CHANNEL(eTC_CALC_SECTOR, calcSamp.sector, "sector", eDA_CALC_SECTOR, eCE_FIXED16, 1.0, false),
+		MAKE_CHANNEL(eTC_CALC_SECTOR_TIME_OFFSET, calcSamp.sectorTimeOffset, "sectorTimeOffset", eDA_CALC_SECTOR_TIME_OFFSET, eCE_FLOAT32, 1.0, false),
+		MAKE_CHANNEL(eTC_CALC_SMOOTH_ACCL_X, calcSamp.smoothAccl.x, "smoothAccl_x", eDA_CALC_SMOOTH_ACCL, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_CALC_SMOOTH_ACCL_Y, calcSamp.smoothAccl.y, "smoothAccl_y", eDA_CALC_SMOOTH_ACCL, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_CALC_SMOOTH_ACCL_Z, calcSamp.smoothAccl.z, "smoothAccl_z", eDA_CALC_SMOOTH_ACCL, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_CALC_VEHI_ACCL_LAT, calcSamp.vehiAccl.lat_g, "vehiAcclLat", eDA_CALC_VEHI_ACCL, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_CALC_VEHI_ACCL_LON, calcSamp.vehiAccl.lon_g, "vehiAcclLon", eDA_CALC_VEHI_ACCL, eCE_NATIVE, 1.0, true),
+		MAKE_CHANNEL(eTC_CALC_TRACK_DISTANCE, calcSamp.trackDistance_m, "trackDistance", eDA_CALC_TRACK_DISTANCE, eCE_NATIVE, 1.0, false)
+	};
+
+	#undef MAKE_CHANNEL
+
+	constexpr bool
+	channelDescriptorsAreIndexed()
+	{
+		for (size_t i=0; i<CHANNEL_DESCRIPTORS.size(); i++)
+		{
+			if (CHANNEL_DESCRIPTORS[i].channel != static_cast<TelemetryChannel_E>(i))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	static_assert(channelDescriptorsAreIndexed(), "CHANNEL_DESCRIPTORS must be in TelemetryChannel_E order");
+
+	/**
+	 * @return
+	 * descriptors for all channels, indexed by TelemetryChannel_E
+	 */
+	const std::array<ChannelDescriptor, eTC_COUNT> &
+	getChannelDescriptors();
+
+	const ChannelDescriptor &
+	getChannelDescriptor(
+		TelemetryChannel_E channel);
+
+	// channels are stored in fixed size chunks of samples
+	constexpr size_t TELEM_CHUNK_SHIFT = 12;
+	constexpr size_t TELEM_CHUNK_SIZE = (1 << TELEM_CHUNK_SHIFT);
+	constexpr size_t TELEM_CHUNK_MASK = (TELEM_CHUNK_SIZE - 1);
+
+	/**
+	 * @return
+	 * number of bytes used to store a single value of a channel
+	 */
+	size_t
+	getEncodedSize(
+		const ChannelDescriptor &desc,
+		ChannelEncoding_E encoding);
+
+	/**
+	 * Fills 'dst' with 'nBytes' of encoded channel values for a lazily
+	 * loaded chunk.
+	 * 
+	 * @return
+	 * true on success
+	 */
+	using TelemetryChunkLoader = std::function<bool(uint8_t *dst, size_t nBytes)>;
+
+	/**
+	 * Keeps the bytes returned by TelemetryChunk::data() alive. Paged chunks
+	 * can't be evicted while they're pinned.
+	 */
+	using TelemetryChunkPin = std::shared_ptr<const void>;
+
+	/**
+	 * A chunk of encoded channel values. Chunks are shared between
+	 * containers and must be treated as immutable once shared; see
+	 * TelemetryColumns for the copy-on-write rules.
+	 */
+	class TelemetryChunk
+	{
+	public:
+		explicit
+		TelemetryChunk(
+			size_t nBytes = 0,
+			uint8_t fill = 0);
+
+		TelemetryChunk(
+			const uint8_t *begin,
+			const uint8_t *end);
+
+		/**
+		 * Makes a chunk that references memory owned by 'backing' (ie. a
+		 * memory mapped file) without copying it. The memory is copied the
+		 * first time the chunk is written to.
+		 */
+		TelemetryChunk(
+			const uint8_t *external,
+			size_t nBytes,
+			std::shared_ptr<const void> backing);
+
+		/**
+		 * Makes a chunk whose values are produced by 'loader' (ie. decompressed
+		 * from an archive) the first time they're read. Loading is thread safe.
+		 */
+		TelemetryChunk(
+			size_t nBytes,
+			TelemetryChunkLoader loader);
+
+		/**
+		 * Copies are always fully loaded and own their memory, since
+		 * they're only made right before being written to.
+		 */
+		TelemetryChunk(
+			const TelemetryChunk &other);
+
+		TelemetryChunk &
+		operator=(
+			const TelemetryChunk &other) = delete;
+
+		/**
+		 * @param[out] pin
+		 * keeps the returned bytes alive. the pointer must not be used once
+		 * the pin is released.
+		 *
+		 * @return
+		 * pointer to the chunk's bytes. lazy chunks are loaded first.
+		 */
+		const uint8_t *
+		data(
+			TelemetryChunkPin &pin) const;
+
+		/**
+		 * @return
+		 * writable pointer to the chunk's bytes. external memory is copied
+		 * into the chunk first.
+		 */
+		uint8_t *
+		mutableData();
+
+		size_t
+		size() const;
+
+		void
+		resize(
+			size_t nBytes,
+			uint8_t fill = 0);
+
+		bool
+		isExternal() const;
+
+		/**
+		 * @return
+		 * false if this is a lazy chunk that hasn't been read yet
+		 */
+		bool
+		isLoaded() const;
+
+		/**
+		 * @return
+		 * true if the chunk's values come from a loader, meaning they can be
+		 * evicted and reloaded later
+		 */
+		bool
+		isPaged() const;
+
+		/**
+		 * Loads a paged chunk without touching its values. Safe to call
+		 * from any thread.
+		 */
+		void
+		prefetch() const;
+
+		/**
+		 * Frees a paged chunk's values. They're reloaded on the next read.
+		 * Does nothing for chunks that aren't paged.
+		 *
+		 * @return
+		 * true if the values were freed. false if the chunk isn't resident,
+		 * or a reader still has it pinned.
+		 */
+		bool
+		evict();
+
+		/**
+		 * @return
+		 * when the chunk was last loaded or handed out by its container.
+		 * used to find the least recently used chunks to evict.
+		 */
+		uint64_t
+		lastUse() const;
+
+		void
+		touch() const;
+
+		/**
+		 * Compares the chunks' encoded bytes. Paged chunks that aren't
+		 * resident are never decompressed just to be compared, and are
+		 * treated as different instead.
+		 */
+		bool
+		operator==(
+			const TelemetryChunk &other) const;
+
+	private:
+		using PagedBytes = std::vector<uint8_t>;
+
+		/**
+		 * @return
+		 * the paged chunk's values, loading them first if needed. nullptr
+		 * if the chunk isn't paged.
+		 */
+		std::shared_ptr<const PagedBytes>
+		load() const;
+
+		/**
+		 * Same as data(), but paged chunks that aren't resident aren't
+		 * loaded.
+		 *
+		 * @return
+		 * false if the chunk isn't resident
+		 */
+		bool
+		residentData(
+			const uint8_t *&bytes,
+			TelemetryChunkPin &pin) const;
+
+	private:
+		std::vector<uint8_t> owned_;
+
+		const uint8_t *external_;
+		size_t externalSize_;
+		// keeps the external memory alive
+		std::shared_ptr<const void> backing_;
+
+		// guarded by 'loadMutex_'. the loaded values are shared with pins,
+		// so evicting only drops the chunk's reference to them.
+		TelemetryChunkLoader loader_;
+		mutable std::shared_ptr<const PagedBytes> paged_;
+		// size of a paged chunk's values. fixed for the chunk's lifetime.
+		size_t lazySize_;
+		std::atomic<bool> isPaged_;
+		mutable std::atomic<bool> loaded_;
+		mutable std::mutex loadMutex_;
+		mutable std::atomic<uint64_t> lastUse_;
+
+	};
+
+	using TelemetryChunkPtr = std::shared_ptr<TelemetryChunk>;
+
+	// forward declaration
+	class TelemetryColumns;
+
+	/**
+	 * A read-only view into a single channel of a TelemetryColumns
+	 * container. Views are invalidated when the container is modified.
+	 */
+	template <typename T>
+	class ChannelView
+	{
+	public:
+		class const_iterator
+		{
+		public:
+			const_iterator(
+				const ChannelView *view,
+				size_t idx)
+			 : view_(view)
+			 , idx_(idx)
+			{}
+
+			T
+			operator*() const
+			{
+				return (*view_)[idx_];
+			}
+
+			const_iterator &
+			operator++()
+			{
+				idx_++;
+				return *this;
+			}
+
+			bool
+			operator!=(
+				const const_iterator &other) const
+			{
+				return idx_ != other.idx_;
+			}
+
+		private:
+			const ChannelView *view_;
+			size_t idx_;
+
+		};
+
+	public:
+		ChannelView()
+		 : ChannelView(nullptr, eTC_T_OFFSET, 0, eCE_ABSENT, 1.0)
+		{}
+
+		ChannelView(
+			const TelemetryColumns *columns,
+			TelemetryChannel_E channel,
+			size_t size,
+			ChannelEncoding_E encoding,
+			double scale)
+		 : columns_(columns)
+		 , channel_(channel)
+		 , size_(size)
+		 , encoding_(encoding)
+		 , scale_(scale)
+		 , cachedChunkIdx_(-1)
+		 , cachedChunk_(nullptr)
+		 , cachedPin_(nullptr)
+		 , cachedBytes_(nullptr)
+		{}
+
+		T
+		operator[](
+			size_t idx) const;
+
+		/**
+		 * @return
+		 * pointer to the natively stored values of a chunk, or nullptr if
+		 * the channel isn't stored natively. useful for vectorized passes.
+		 * the pointer is valid until the view moves on to another chunk.
+		 */
+		const T *
+		chunkData(
+			size_t chunkIdx) const;
+
+		size_t
+		chunkCount() const
+		{
+			return (size_ + TELEM_CHUNK_SIZE - 1) >> TELEM_CHUNK_SHIFT;
+		}
+
+		ChannelEncoding_E
+		encoding() const
+		{
+			return encoding_;
+		}
+
+		size_t
+		size() const
+		{
+			return size_;
+		}
+
+		bool
+		empty() const
+		{
+			return size_ == 0;
+		}
+
+		const_iterator
+		begin() const
+		{
+			return const_iterator(this, 0);
+		}
+
+		const_iterator
+		end() const
+		{
+			return const_iterator(this, size_);
+		}
+
+	private:
+		/**
+		 * @return
+		 * the bytes of a chunk, pinned until the view moves on to another
+		 * chunk
+		 */
+		const uint8_t *
+		chunkBytes(
+			size_t chunkIdx) const;
+
+	private:
+		const TelemetryColumns *columns_;
+		TelemetryChannel_E channel_;
+		size_t size_;
+		ChannelEncoding_E encoding_;
+		double scale_;
+
+		// last chunk accessed. sequential scans stay within a chunk for
+		// TELEM_CHUNK_SIZE samples, so this avoids most of the lookups.
+		mutable size_t cachedChunkIdx_;
+		mutable std::shared_ptr<const TelemetryChunk> cachedChunk_;
+		mutable TelemetryChunkPin cachedPin_;
+		mutable const uint8_t *cachedBytes_;
+
+	};
+
+	/**
+	 * Structure-of-arrays telemetry container. Each channel is stored in its
+	 * own contiguous array so that per-channel passes (filters, plots, CSV
+	 * writers, etc.) only touch the bytes they actually need.
+	 *
+	 * In compact mode, channels that aren't flagged as available aren't
+	 * stored at all, and channels that tolerate it are quantized (see
+	 * ChannelDescriptor::compactEncoding). Reads are transparent either way.
+	 *
+	 * Each channel is split into chunks of TELEM_CHUNK_SIZE samples that are
+	 * reference counted. Copying a container only copies chunk pointers, and
+	 * a chunk is only cloned when it's written to while shared. assign()
+	 * keeps existing chunks whose contents didn't change, so processing that
+	 * only touches a few channels doesn't unshare the rest.
+	 */
+	class TelemetryColumns
+	{
+	public:
+		TelemetryColumns();
+
+		explicit
+		TelemetryColumns(
+			const TelemetrySamples &samples);
+
+		/**
+		 * Replaces the container's contents with the given samples
+		 */
+		void
+		assign(
+			const TelemetrySamples &samples);
+
+		/**
+		 * Materializes the columns back into an array of samples
+		 */
+		void
+		toSamples(
+			TelemetrySamples &samplesOut) const;
+
+		/**
+		 * AoS compatibility accessor. Gathers a single sample from every
+		 * channel, so prefer channel() for scans over many samples.
+		 *
+		 * @throw
+		 * std::out_of_range if idx >= size()
+		 */
+		TelemetrySample
+		sampleAt(
+			size_t idx) const;
+
+		/**
+		 * Scatters a single sample into every channel
+		 *
+		 * @throw
+		 * std::out_of_range if idx >= size()
+		 */
+		void
+		setSample(
+			size_t idx,
+			const TelemetrySample &samp);
+
+		/**
+		 * Copies a range of a channel from another container into this one.
+		 * The caller must ensure both ranges are in bounds.
+		 */
+		void
+		copyChannel(
+			TelemetryChannel_E channel,
+			const TelemetryColumns &src,
+			size_t srcStartIdx,
+			size_t dstStartIdx,
+			size_t nSamples);
+
+		/**
+		 * @throw
+		 * std::runtime_error if T doesn't match the channel's type
+		 */
+		template <typename T>
+		ChannelView<T>
+		channel(
+			TelemetryChannel_E channel) const
+		{
+			checkType<T>(channel);
+			return ChannelView<T>(
+				this,
+				channel,
+				size_,
+				columns_[channel].encoding,
+				getChannelDescriptor(channel).compactScale);
+		}
+
+		/**
+		 * Replaces a channel's values
+		 *
+		 * @param[in] values
+		 * must contain size() values
+		 *
+		 * @throw
+		 * std::runtime_error if T doesn't match the channel's type
+		 */
+		template <typename T>
+		void
+		assignChannel(
+			TelemetryChannel_E channel,
+			const std::vector<T> &values)
+		{
+			checkType<T>(channel);
+			if (values.size() != size_)
+			{
+				throw std::runtime_error("value count doesn't match container size");
+			}
+			for (size_t i=0; i<size_; i++)
+			{
+				setValue(channel, i, static_cast<double>(values[i]));
+			}
+		}
+
+		/**
+		 * Replaces a range of a channel's values. Natively stored channels
+		 * are copied a chunk at a time, so this is much cheaper than
+		 * writing samples individually.
+		 *
+		 * @param[in] values
+		 * 'nValues' values to write starting at sample 'startIdx'. the
+		 * caller must ensure the range is in bounds.
+		 *
+		 * @throw
+		 * std::runtime_error if T doesn't match the channel's type
+		 */
+		template <typename T>
+		void
+		assignChannel(
+			TelemetryChannel_E channel,
+			size_t startIdx,
+			const T *values,
+			size_t nValues)
+		{
+			checkType<T>(channel);
+			allocateChannel(channel);
+			if (columns_[channel].encoding != eCE_NATIVE)
+			{
+				for (size_t i=0; i<nValues; i++)
+				{
+					setValue(channel, startIdx + i, static_cast<double>(values[i]));
+				}
+				return;
+			}
+
+			size_t idx = startIdx;
+			const size_t endIdx = startIdx + nValues;
+			while (idx < endIdx)
+			{
+				const size_t localIdx = idx & TELEM_CHUNK_MASK;
+				const size_t n = std::min(TELEM_CHUNK_SIZE - localIdx, endIdx - idx);
+				T *chunkValues = reinterpret_cast<T *>(
+					mutableChunk(channel, idx >> TELEM_CHUNK_SHIFT).mutableData());
+				std::copy(values, values + n, chunkValues + localIdx);
+				values += n;
+				idx += n;
+			}
+		}
+
+		/**
+		 * Clears the container and sizes it to 'nSamples' without allocating
+		 * storage for any channel. Used by loaders that populate channels
+		 * directly via setChannelChunks().
+		 */
+		void
+		resetLayout(
+			size_t nSamples,
+			bool compact,
+			const DataAvailableBitSet &avail);
+
+		/**
+		 * Replaces a channel's storage with already encoded chunks. Every
+		 * chunk must hold TELEM_CHUNK_SIZE samples, except for the last.
+		 *
+		 * @throw
+		 * std::runtime_error if the chunks don't match the container's size
+		 */
+		void
+		setChannelChunks(
+			TelemetryChannel_E channel,
+			ChannelEncoding_E encoding,
+			std::vector<TelemetryChunkPtr> chunks);
+
+		/**
+		 * @return
+		 * the chunk holding the encoded values for samples
+		 * [chunkIdx * TELEM_CHUNK_SIZE, (chunkIdx + 1) * TELEM_CHUNK_SIZE)
+		 */
+		const TelemetryChunkPtr &
+		getChunk(
+			TelemetryChannel_E channel,
+			size_t chunkIdx) const;
+
+		/**
+		 * Enables/disables compact storage and re-encodes all channels.
+		 *
+		 * @param[in] avail
+		 * the channels that are valid. in compact mode, all other channels
+		 * are dropped from storage.
+		 */
+		void
+		setCompact(
+			bool compact,
+			const DataAvailableBitSet &avail);
+
+		bool
+		isCompact() const;
+
+		/**
+		 * Updates which channels are valid. Channels that become available
+		 * are allocated. In compact mode, the rest are dropped on the next
+		 * assign().
+		 */
+		void
+		setDataAvailable(
+			const DataAvailableBitSet &avail);
+
+		ChannelEncoding_E
+		getEncoding(
+			TelemetryChannel_E channel) const;
+
+		/**
+		 * Resizes all channels. New samples are zero initialized.
+		 */
+		void
+		resize(
+			size_t nSamples);
+
+		void
+		clear();
+
+		size_t
+		size() const;
+
+		bool
+		empty() const;
+
+		/**
+		 * @return
+		 * number of bytes used to store the samples. chunks shared with
+		 * other containers are included.
+		 */
+		size_t
+		size_bytes() const;
+
+		/**
+		 * @return
+		 * number of chunks that are shared with another container
+		 */
+		size_t
+		sharedChunkCount() const;
+
+		/**
+		 * @return
+		 * number of lazily loaded chunks that haven't been read yet
+		 */
+		size_t
+		unloadedChunkCount() const;
+
+		/**
+		 * @return
+		 * number of bytes held in memory by paged chunks (see
+		 * TelemetryChunk::isPaged()). memory mapped chunks aren't counted
+		 * since the OS pages those in and out on its own.
+		 */
+		size_t
+		pagedResidentBytes() const;
+
+		/**
+		 * Evicts the least recently used paged chunks until no more than
+		 * 'maxBytes' are resident. Chunks that a reader has pinned (ie. a
+		 * ChannelView's current chunk) are skipped, so other threads can
+		 * keep reading while this runs. The container itself must not be
+		 * modified concurrently.
+		 *
+		 * @return
+		 * number of bytes evicted
+		 */
+		size_t
+		trimPaged(
+			size_t maxBytes);
+
+		/**
+		 * Loads every channel's chunks that overlap samples [begin, end).
+		 * Chunks are decoded in parallel when OpenMP is available.
+		 *
+		 * @return
+		 * number of bytes that had to be loaded
+		 */
+		size_t
+		prefetch(
+			size_t begin,
+			size_t end) const;
+
+		/**
+		 * Same as prefetch(), but the paged chunks are also pinned so that
+		 * trimPaged() can't evict them until the pins are released.
+		 */
+		std::vector<TelemetryChunkPin>
+		pin(
+			size_t begin,
+			size_t end) const;
+
+		/**
+		 * @return
+		 * every paged chunk that isn't loaded yet, ordered by sample index.
+		 * holding onto these references will cause writes to the container
+		 * to copy the chunks first, so they're safe to load from another thread.
+		 */
+		std::vector<TelemetryChunkPtr>
+		unloadedChunks() const;
+
+	private:
+		template <typename T>
+		void
+		checkType(
+			TelemetryChannel_E channel) const
+		{
+			const auto &desc = getChannelDescriptor(channel);
+			if (desc.type != channelTypeOf<T>())
+			{
+				throw std::runtime_error(
+					std::string("type mismatch accessing channel '") + desc.name + "'");
+			}
+		}
+
+		/**
+		 * @return
+		 * the encoding a channel should have given the current mode
+		 */
+		ChannelEncoding_E
+		targetEncoding(
+			const ChannelDescriptor &desc) const;
+
+		/**
+		 * @return
+		 * the encoding a channel is stored with once it has storage
+		 */
+		ChannelEncoding_E
+		storedEncoding(
+			const ChannelDescriptor &desc) const;
+
+		/**
+		 * Gives an eCE_ABSENT channel zeroed storage so that it can be
+		 * written to. Does nothing if the channel already has storage.
+		 */
+		void
+		allocateChannel(
+			TelemetryChannel_E channel);
+
+		/**
+		 * Re-encodes a single channel in place
+		 */
+		void
+		setEncoding(
+			TelemetryChannel_E channel,
+			ChannelEncoding_E encoding);
+
+		/**
+		 * @return
+		 * a chunk that's safe to write to, cloning it first if it's shared
+		 */
+		TelemetryChunk &
+		mutableChunk(
+			TelemetryChannel_E channel,
+			size_t chunkIdx);
+
+		/**
+		 * @return
+		 * every channel's paged chunks that overlap samples [begin, end)
+		 */
+		std::vector<const TelemetryChunk *>
+		pagedChunks(
+			size_t begin,
+			size_t end) const;
+
+		double
+		getValue(
+			TelemetryChannel_E channel,
+			size_t idx) const;
+
+		/**
+		 * Writes a single value. Channels without storage (ie. ones missing
+		 * from a loaded file) are allocated first, so the write is never lost.
+		 */
+		void
+		setValue(
+			TelemetryChannel_E channel,
+			size_t idx,
+			double value);
+
+	private:
+		struct Column
+		{
+			ChannelEncoding_E encoding;
+
+			// encoded values split into chunks of TELEM_CHUNK_SIZE samples.
+			// empty if the channel's encoding is eCE_ABSENT.
+			std::vector<TelemetryChunkPtr> chunks;
+		};
+
+		size_t size_;
+		bool compact_;
+		DataAvailableBitSet avail_;
+
+		// indexed by TelemetryChannel_E
+		std::array<Column, eTC_COUNT> columns_;
+
+	};
+
+	using TelemetryColumnsPtr = std::shared_ptr<TelemetryColumns>;
+
+	template <typename T>
+	T
+	ChannelView<T>::operator[](
+		size_t idx) const
+	{
+		if (encoding_ == eCE_ABSENT)
+		{
+			return T(0);
+		}
+
+		const uint8_t *bytes = chunkBytes(idx >> TELEM_CHUNK_SHIFT);
+		const size_t localIdx = idx & TELEM_CHUNK_MASK;
+		switch (encoding_)
+		{
+		case eCE_NATIVE:
+			return reinterpret_cast<const T *>(bytes)[localIdx];
+		case eCE_FLOAT32:
+			return static_cast<T>(reinterpret_cast<const float *>(bytes)[localIdx]);
+		case eCE_FIXED16:
+			return static_cast<T>(reinterpret_cast<const int16_t *>(bytes)[localIdx] * scale_);
+		case eCE_ABSENT:
+			break;
+		}
+		return T(0);
+	}
+
+	template <typename T>
+	const T *
+	ChannelView<T>::chunkData(
+		size_t chunkIdx) const
+	{
+		if (encoding_ != eCE_NATIVE)
+		{
+			return nullptr;
+		}
+		return reinterpret_cast<const T *>(chunkBytes(chunkIdx));
+	}
+
+	template <typename T>
+	const uint8_t *
+	ChannelView<T>::chunkBytes(
+		size_t chunkIdx) const
+	{
+		if (chunkIdx != cachedChunkIdx_)
+		{
+			cachedChunk_ = columns_->getChunk(channel_, chunkIdx);
+			cachedBytes_ = cachedChunk_->data(cachedPin_);
+			cachedChunkIdx_ = chunkIdx;
+		}
+		return cachedBytes_;
+	}
+}
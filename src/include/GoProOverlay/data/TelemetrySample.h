@@ -32,7 +32,8 @@ namespace gpo
 		eDA_CALC_SECTOR = 195,
 		eDA_CALC_SECTOR_TIME_OFFSET = 196,
 		eDA_CALC_SMOOTH_ACCL = 197,
-		eDA_CALC_VEHI_ACCL = 198
+		eDA_CALC_VEHI_ACCL = 198,
+		eDA_CALC_TRACK_DISTANCE = 199
 	};
 
 	// must fit highest bit in DataAvailable enum
@@ -98,6 +99,11 @@ namespace gpo
 
 		// lateral & longitudinal g-forces experienced by the vehicle
 		VehicleAccl vehiAccl;
+
+		// distance travelled along the track since the first sample, measured
+		// between successive on track locations. never decreases, so it can
+		// be used to line up runs by position rather than by time.
+		double trackDistance_m;
 	};
 
 	struct TelemetrySample
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
 #include "TelemetrySample.h"
 
@@ -10,6 +10,23 @@ namespace gpo
 	// forward declaration
 	class DataSource;
 	using DataSourcePtr = std::shared_ptr<DataSource>;
+	class TelemetrySource;
+	using TelemetrySourcePtr = std::shared_ptr<TelemetrySource>;
+
+	/**
+	 * Maps a source's samples to and from the ticks of a clock (see
+	 * TelemetrySeeker::setClockRate()). Never modified once it's built, so
+	 * a snapshot of the seekers can keep using it after the clock changes.
+	 */
+	struct ClockSchedule
+	{
+		double rate_hz = 0.0;
+		// sample nearest to each of the clock's ticks
+		std::vector<size_t> idxAtTick;
+		// clock tick nearest to each of the samples
+		std::vector<size_t> tickOfIdx;
+	};
+	using ClockSchedulePtr = std::shared_ptr<const ClockSchedule>;
 
 	class TelemetrySeeker
 	{
@@ -21,6 +38,13 @@ namespace gpo
 		std::string
 		getDataSourceName() const;
 
+		/**
+		 * @return
+		 * the telemetry this seeker moves through
+		 */
+		TelemetrySourcePtr
+		getTelemetrySource() const;
+
 		void
 		prev();
 
@@ -61,6 +85,27 @@ namespace gpo
 		void
 		seekToLapExit(
 			unsigned int lap);
+
+		/**
+		 * @param[in] lap
+		 * the lap the sector was driven in (starts at 1)
+		 *
+		 * @param[in] sector
+		 * the sector's number within the lap (starts at 1)
+		 *
+		 * @throw std::out_of_range
+		 * if the sector wasn't driven during that lap
+		 */
+		void
+		seekToSectorEntry(
+			unsigned int lap,
+			unsigned int sector);
+
+		// same as seekToSectorEntry(), but seeks to the sector's last sample
+		void
+		seekToSectorExit(
+			unsigned int lap,
+			unsigned int sector);
 		
 		size_t
 		seekedIdx() const;
@@ -68,9 +113,38 @@ namespace gpo
 		size_t
 		size() const;
 
+		/**
+		 * @return
+		 * the number of distinct laps found in the data. lap numbers can
+		 * have gaps, so this isn't necessarily the highest lap number.
+		 */
 		unsigned int
 		lapCount() const;
 
+		/**
+		 * @return
+		 * true if the lap was found in the data
+		 */
+		bool
+		hasLap(
+			unsigned int lap) const;
+
+		/**
+		 * @return
+		 * the most sectors driven within any one lap
+		 */
+		unsigned int
+		sectorCount() const;
+
+		/**
+		 * @return
+		 * true if the sector was driven during the lap
+		 */
+		bool
+		hasSector(
+			unsigned int lap,
+			unsigned int sector) const;
+
 		double
 		rateHz() const;
 
@@ -82,22 +156,128 @@ namespace gpo
 		getLapEntryExit(
 			unsigned int lap) const;
 
+		/**
+		 * @return
+		 * the first and last sample within the lap's sector
+		 *
+		 * @throw std::out_of_range
+		 * if the sector wasn't driven during that lap
+		 */
+		std::pair<size_t, size_t>
+		getSectorEntryExit(
+			unsigned int lap,
+			unsigned int sector) const;
+
 		// forces seeker to analyze samples and find lap/sector seek points again
 		void
 		analyze();
 
+		/**
+		 * Builds a schedule that maps each tick of a clock running at
+		 * 'rate_hz' to this source's sample nearest that tick, so stepping by
+		 * time doesn't need to search the samples (see
+		 * GroupedSeeker::setMasterClock()). Ticks are counted from the
+		 * source's first sample. The schedule is rebuilt by analyze(), and a
+		 * rate of 0 drops it.
+		 */
+		void
+		setClockRate(
+			double rate_hz);
+
+		double
+		clockRate() const;
+
+		/**
+		 * @return
+		 * the number of clock ticks the source's samples span
+		 */
+		size_t
+		clockTickCount() const;
+
+		/**
+		 * @return
+		 * the clock tick nearest to sample 'idx'
+		 */
+		size_t
+		clockTickOf(
+			size_t idx) const;
+
+		/**
+		 * @return
+		 * the sample nearest to clock tick 'tick'. ticks past the end map to
+		 * the last sample.
+		 */
+		size_t
+		idxAtClockTick(
+			size_t tick) const;
+
+		/**
+		 * @return
+		 * the schedule built by setClockRate(), or nullptr if there's no
+		 * clock running
+		 */
+		ClockSchedulePtr
+		clockSchedule() const;
+
+		/**
+		 * Builds a schedule for a clock running at 'rate_hz' without
+		 * changing the seeker's own (see setClockRate()). Reads the
+		 * telemetry, so call it from the thread that owns the source.
+		 *
+		 * @return
+		 * the schedule, or nullptr if the rate is 0 or there's no telemetry
+		 */
+		ClockSchedulePtr
+		makeClockSchedule(
+			double rate_hz) const;
+
+	private:
+		// lets paged telemetry follow the seeker (see DataSource::setTelemetryMemoryLimit())
+		void
+		pageAroundSeek();
+
+		struct LapIndices;
+
+		const LapIndices &
+		lapIndices(
+			unsigned int lap) const;
+
+		const LapIndices &
+		sectorIndices(
+			unsigned int lap,
+			unsigned int sector) const;
+
 	private:
 		std::weak_ptr<DataSource> dataSrc_;
 		size_t seekedIdx_;
 		size_t alignmentIdx_;
 		double rate_hz_;
+		// chunk index that pageAroundSeek() last paged in
+		size_t pagedChunkIdx_;
 
 		struct LapIndices
 		{
 			size_t entryIdx = -1;
 			size_t exitIdx = -1;
+
+			bool
+			valid() const
+			{
+				return entryIdx != size_t(-1);
+			}
 		};
-		std::unordered_map<unsigned int, LapIndices> lapIndicesMap_;
+		// indexed by 'lap - 1'. laps are numbered consecutively, so these
+		// tables are dense and lookups don't need to hash.
+		std::vector<LapIndices> lapIndices_;
+		// row-major lap by sector table, indexed by
+		// '(lap - 1) * sectorsPerLap_ + (sector - 1)'. entries for sectors
+		// that weren't driven during a lap are left invalid.
+		std::vector<LapIndices> sectorIndices_;
+		unsigned int sectorsPerLap_;
+
+		double clockRate_hz_;
+		// replaced rather than modified, since snapshots may share it
+		ClockSchedulePtr clockSchedule_;
 
 	};
 
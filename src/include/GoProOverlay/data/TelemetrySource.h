@@ -2,6 +2,8 @@
 
 #include <memory>
 
+#include "SeekState.h"
+#include "TelemetryColumns.h"
 #include "TelemetrySample.h"
 #include "TelemetrySeeker.h"
 
@@ -11,6 +13,75 @@ namespace gpo
 	class DataSource;
 	using DataSourcePtr = std::shared_ptr<DataSource>;
 
+	/**
+	 * Non-owning handle onto a DataSource's telemetry for hot loops. Reads go
+	 * straight to the columns and seeker rather than locking the DataSource
+	 * on every call, so the DataSource must outlive the accessor (ie. hold a
+	 * RenderSession). The accessor doesn't see the telemetry being replaced.
+	 */
+	class TelemetryAccessor
+	{
+	public:
+		TelemetryAccessor(
+			const TelemetryColumns *columns,
+			const TelemetrySeeker *seeker)
+		 : columns_(columns)
+		 , seeker_(seeker)
+		{}
+
+		size_t
+		size() const
+		{
+			return columns_->size();
+		}
+
+		size_t
+		seekedIdx() const
+		{
+			return seeker_->seekedIdx();
+		}
+
+		/**
+		 * @return
+		 * where this source is in 'state'
+		 */
+		size_t
+		seekedIdx(
+			const SeekState &state) const
+		{
+			return state.seekedIdx(seeker_);
+		}
+
+		/**
+		 * Same as TelemetrySource::at(). Prefer channel() in loops.
+		 */
+		TelemetrySample
+		at(
+			size_t idx) const
+		{
+			return columns_->sampleAt(idx);
+		}
+
+		template <typename T>
+		ChannelView<T>
+		channel(
+			TelemetryChannel_E ch) const
+		{
+			return columns_->channel<T>(ch);
+		}
+
+		const TelemetryColumns &
+		columns() const
+		{
+			return *columns_;
+		}
+
+	private:
+		const TelemetryColumns *columns_;
+		const TelemetrySeeker *seeker_;
+
+	};
+
 	class TelemetrySource
 	{
 	public:
@@ -21,13 +92,29 @@ namespace gpo
 		std::string
 		getDataSourceName() const;
 
-		const TelemetrySample &
+		/**
+		 * Gathers a single sample from the underlying columnar storage.
+		 * Prefer channel() when scanning many samples.
+		 */
+		TelemetrySample
 		at(
 			size_t idx) const;
 
-		TelemetrySample &
-		at(
-			size_t idx);
+		/**
+		 * @return
+		 * a view of a single telemetry channel. the view is invalidated
+		 * if the underlying DataSource's telemetry is modified.
+		 */
+		template <typename T>
+		ChannelView<T>
+		channel(
+			TelemetryChannel_E ch) const
+		{
+			return columns().channel<T>(ch);
+		}
+
+		const TelemetryColumns &
+		columns() const;
 
 		size_t
 		seekedIdx() const;
@@ -38,15 +125,74 @@ namespace gpo
 		size_t
 		size() const;
 
+		/**
+		 * @return
+		 * the memory used to store the telemetry samples. this reflects
+		 * compact storage if enabled (see DataSource::setCompactTelemetry()).
+		 */
 		size_t
 		size_bytes() const;
 
 		double
 		getTelemetryRate_hz() const;
 
+		/**
+		 * @return
+		 * the index of the last sample at or before 't_offset'. this is O(1)
+		 * for uniformly sampled telemetry and O(log n) otherwise.
+		 */
+		size_t
+		findIndexAtTime(
+			double t_offset) const;
+
+		/**
+		 * Finds the pair of samples to interpolate between at 't_offset'.
+		 *
+		 * @param[out] idx
+		 * set such that samples 'idx' and 'idx + 1' bound 't_offset'
+		 *
+		 * @return
+		 * true if 't_offset' lies within the telemetry's time range
+		 */
+		bool
+		findLerpIndex(
+			size_t &idx,
+			double t_offset) const;
+
+		/**
+		 * Distance based equivalent of findIndexAtTime(). Requires the
+		 * eDA_CALC_TRACK_DISTANCE channel (ie. a datum track was set).
+		 * Distances don't advance at a steady rate, so this is O(log n).
+		 *
+		 * @return
+		 * the index of the last sample at or before 'distance_m'
+		 */
+		size_t
+		findIndexAtDistance(
+			double distance_m) const;
+
+		/**
+		 * Distance based equivalent of findLerpIndex().
+		 *
+		 * @return
+		 * true if 'distance_m' lies within the telemetry's distance range
+		 */
+		bool
+		findLerpIndexAtDistance(
+			size_t &idx,
+			double distance_m) const;
+
 		const DataAvailableBitSet &
 		dataAvailable() const;
 
+		/**
+		 * @return
+		 * an accessor that reads this telemetry without locking the
+		 * DataSource. see TelemetryAccessor for when it's safe to use.
+		 */
+		TelemetryAccessor
+		accessor() const;
+
 	private:
 		std::weak_ptr<DataSource> dataSrc_;
 
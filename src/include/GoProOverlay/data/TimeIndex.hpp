@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+
+namespace gpo
+{
+
+	/**
+	 * Maps time offsets to sample indices. Telemetry is nominally captured
+	 * at a fixed rate, so the index is first estimated from the average
+	 * sample rate and then corrected by stepping a few samples. Timestamps
+	 * that are too jittery for that to converge fall back to a binary search.
+	 * Lookups are O(1) for uniformly sampled data and O(log n) otherwise.
+	 *
+	 * 'TimeAt' is any callable that returns a sample's time offset given its
+	 * index. Time offsets must be non-decreasing. The index holds no state
+	 * besides the endpoints, so it's cheap to construct per lookup.
+	 */
+	template <typename TimeAt>
+	class TimeIndex
+	{
+	public:
+		// max samples to step from the estimate before resorting to a search
+		static constexpr size_t MAX_CORRECTION_STEPS = 4;
+
+		TimeIndex(
+			size_t size,
+			TimeAt timeAt)
+		 : size_(size)
+		 , timeAt_(timeAt)
+		 , startTime_(0.0)
+		 , rate_hz_(0.0)
+		{
+			if (size_ >= 2)
+			{
+				startTime_ = timeAt_(0);
+				const double duration = timeAt_(size_ - 1) - startTime_;
+				rate_hz_ = (duration > 0.0 ? (size_ - 1) / duration : 0.0);
+			}
+		}
+
+		/**
+		 * @return
+		 * the index of the last sample at or before 't'. returns 0 if 't'
+		 * precedes all samples, or if there are no samples.
+		 */
+		size_t
+		floorIndex(
+			double t) const
+		{
+			if (size_ < 2)
+			{
+				return 0;
+			}
+			else if (rate_hz_ > 0.0)
+			{
+				const double estimate = (t - startTime_) * rate_hz_;
+				size_t idx = 0;
+				if (estimate >= (size_ - 1))
+				{
+					idx = size_ - 1;
+				}
+				else if (estimate > 0.0)
+				{
+					idx = estimate;
+				}
+
+				for (size_t step=0; step<MAX_CORRECTION_STEPS; step++)
+				{
+					if (timeAt_(idx) > t)
+					{
+						if (idx == 0)
+						{
+							return 0;
+						}
+						idx--;
+					}
+					else if ((idx + 1) < size_ && timeAt_(idx + 1) <= t)
+					{
+						idx++;
+					}
+					else
+					{
+						return idx;
+					}
+				}
+			}
+			return searchFloorIndex(t);
+		}
+
+		/**
+		 * Finds the pair of samples to interpolate between at time 't'.
+		 * This is a drop-in replacement for gpt::findLerpIndex().
+		 *
+		 * @param[out] idx
+		 * set such that the samples at 'idx' and 'idx + 1' bound 't'. if
+		 * 't' is out of range, this is set to the nearest end instead.
+		 *
+		 * @return
+		 * true if 't' lies within the samples' time range
+		 */
+		bool
+		findLerpIndex(
+			size_t &idx,
+			double t) const
+		{
+			if (size_ < 2 || t < timeAt_(0))
+			{
+				idx = 0;
+				return false;
+			}
+			else if (t > timeAt_(size_ - 1))
+			{
+				idx = size_ - 1;
+				return false;
+			}
+			idx = floorIndex(t);
+			if ((idx + 1) >= size_)
+			{
+				idx = size_ - 2;
+			}
+			return true;
+		}
+
+	private:
+		size_t
+		searchFloorIndex(
+			double t) const
+		{
+			// find the first sample after 't' (ie. std::upper_bound)
+			size_t lo = 0;
+			size_t hi = size_;
+			while (lo < hi)
+			{
+				const size_t mid = lo + (hi - lo) / 2;
+				if (timeAt_(mid) <= t)
+				{
+					lo = mid + 1;
+				}
+				else
+				{
+					hi = mid;
+				}
+			}
+			return (lo > 0 ? lo - 1 : 0);
+		}
+
+	private:
+		size_t size_;
+		TimeAt timeAt_;
+		double startTime_;
+		double rate_hz_;
+
+	};
+
+	template <typename TimeAt>
+	TimeIndex<TimeAt>
+	makeTimeIndex(
+		size_t size,
+		TimeAt timeAt)
+	{
+		return TimeIndex<TimeAt>(size, timeAt);
+	}
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <opencv2/core/matx.hpp> // for cv::Vec2d
 #include <tuple>
@@ -7,6 +8,7 @@
 #include <yaml-cpp/yaml.h>
 
 #include "GoProOverlay/data/ModifiableObject.h"
+#include "GoProOverlay/data/PathIndex.h"
 #include "GoProOverlay/utils/YAML_Utils.h"// for YAML::convert<cv::Vec2d>
 #include "TelemetrySource.h"
 
@@ -264,6 +266,34 @@ namespace gpo
 
 	};
 
+	/**
+	 * Summarizes how a Track changed, so that data derived from it can be
+	 * partially recomputed.
+	 */
+	struct TrackEdits
+	{
+		// true if the path itself changed. everything derived from the
+		// track should be recomputed.
+		bool pathChanged = false;
+
+		// inclusive range of path indices whose gates/sectors were added,
+		// moved, or removed. the range is empty if firstPathIdx > lastPathIdx.
+		size_t firstPathIdx = SIZE_MAX;
+		size_t lastPathIdx = 0;
+
+		bool
+		empty() const;
+
+		void
+		addPathRange(
+			size_t pathIdxA,
+			size_t pathIdxB);
+
+		void
+		merge(
+			const TrackEdits &other);
+	};
+
 	class Track : public ModifiableObject
 	{
 	public:
@@ -405,6 +435,44 @@ namespace gpo
 		decode(
 			const YAML::Node& node);
 
+		/**
+		 * @return
+		 * a counter that's incremented every time modifications are applied
+		 */
+		size_t
+		getEditRevision() const;
+
+		/**
+		 * Reports how the track changed since an earlier edit revision,
+		 * including modifications that haven't been applied yet. Only the
+		 * edits from the most recent apply are remembered.
+		 * 
+		 * @param[in] revision
+		 * a value previously returned by getEditRevision()
+		 * 
+		 * @param[out] edits
+		 * what changed since 'revision'
+		 * 
+		 * @return
+		 * false if 'revision' is too old to tell what changed, in which case
+		 * everything derived from the track should be recomputed
+		 */
+		bool
+		getEditsSince(
+			size_t revision,
+			TrackEdits &edits) const;
+
+		/**
+		 * Modifications that don't come from the track's own setters are
+		 * assumed to affect the whole track, path included. This drops the
+		 * path's spatial index; it's rebuilt by the next
+		 * findClosestPointWithIdx() that needs it.
+		 */
+		void
+		markObjectModified(
+			bool needsApply = true,
+			bool needsSave = true) override;
+
 	protected:
         bool
         subclassApplyModifications(
@@ -414,6 +482,14 @@ namespace gpo
         subclassSaveModifications(
         	bool unnecessaryIsOkay) final;
 
+	private:
+		// marks the track as modified, noting that the gates/sectors between
+		// the two path indices changed
+		void
+		markPathObjectsModified(
+			size_t pathIdxA,
+			size_t pathIdxB);
+
 	private:
 		TrackGate start_;
 		TrackGate finish_;
@@ -421,6 +497,15 @@ namespace gpo
 		// list of lat/lon points making up the track's path
 		std::vector<cv::Vec2d> path_;
 
+		// spatial index over 'path_'. built lazily on first use, so it's
+		// swapped atomically in case concurrent const queries race to build it.
+		mutable std::shared_ptr<const PathIndex> pathIndex_;
+
+		// see getEditsSince()
+		size_t editRevision_;
+		TrackEdits pendingEdits_;
+		TrackEdits lastAppliedEdits_;
+
 	};
 
 	TrackPtr
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <opencv2/videoio.hpp>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "GoProOverlay/utils/YAML_Utils.h"
+
+namespace gpo
+{
+	/**
+	 * Settings for a video's decoders. Frames are always decoded to 8-bit
+	 * BGR, since that's what the renderer expects.
+	 */
+	struct VideoDecodeConfig
+	{
+		// number of decoder threads. 0 lets the backend decide. this is the
+		// only threading setting; OpenCV doesn't expose the threading model,
+		// so the FFmpeg backend picks it itself, preferring frame threading
+		// and falling back to slice threading if the codec can't.
+		unsigned int threads;
+
+		/**
+		 * @param[in] simultaneousSources
+		 * number of video sources that will be decoding at the same time
+		 *
+		 * @return
+		 * a config that splits the machine's cores evenly between sources
+		 */
+		static
+		VideoDecodeConfig
+		makeDefault(
+			size_t simultaneousSources);
+	};
+
+	struct VideoDecodeStats
+	{
+		// every frame decoded, including ones skipped over to reach the
+		// requested frame
+		size_t framesDecoded;
+
+		// accumulated time spent decoding frames. time spent seeking isn't
+		// included.
+		double decodeTime_sec;
+
+		double
+		decodeFps() const
+		{
+			return (decodeTime_sec > 0.0 ? framesDecoded / decodeTime_sec : 0.0);
+		}
+	};
+
+	// forward declaration
+	class VideoDecoderPool;
+
+	using VideoDecoderPoolPtr = std::shared_ptr<VideoDecoderPool>;
+
+	/**
+	 * A pool of independent decoders for a single video file.
+	 *
+	 * cv::VideoCapture shares its underlying handle when copied, so multiple
+	 * consumers of the same file (ie. duplicated DataSources) would otherwise
+	 * fight over one decoder position and force a re-seek on every alternate
+	 * read. Instead, consumers lease a decoder for each read and the pool hands
+	 * back the idle decoder that's positioned closest to the requested frame.
+	 * As long as there are no more concurrent streams than 'maxDecoders', each
+	 * stream ends up with its own decoder and reads sequentially.
+	 */
+	class VideoDecoderPool
+	{
+	public:
+		struct Decoder
+		{
+			cv::VideoCapture vCap;
+
+			// index of the frame the next read() will return without seeking
+			size_t nextFrameIdx;
+
+			// the pool's config generation this decoder was opened with
+			size_t configGen;
+		};
+
+		using DecoderPtr = std::shared_ptr<Decoder>;
+
+		static constexpr size_t DEFAULT_MAX_DECODERS = 4;
+
+		// an idle decoder less than this many frames behind a requested frame
+		// is read forward to it rather than seeked (roughly one GOP)
+		static constexpr size_t REUSE_FRAME_DISTANCE = 30;
+
+	public:
+		explicit
+		VideoDecoderPool(
+			const std::filesystem::path &videoFile,
+			size_t maxDecoders = DEFAULT_MAX_DECODERS);
+
+		/**
+		 * @return
+		 * the shared pool for the given video file. a new pool is created if
+		 * none exists, and pools are released once nobody references them.
+		 */
+		static
+		VideoDecoderPoolPtr
+		getPool(
+			const std::filesystem::path &videoFile);
+
+		const std::filesystem::path &
+		getFile() const;
+
+		void
+		setMaxDecoders(
+			size_t maxDecoders);
+
+		size_t
+		getMaxDecoders() const;
+
+		/**
+		 * Sets the config used to open decoders. Idle decoders are closed
+		 * immediately; leased decoders are closed when they're released.
+		 */
+		void
+		setDecodeConfig(
+			const VideoDecodeConfig &config);
+
+		VideoDecodeConfig
+		getDecodeConfig() const;
+
+		VideoDecodeStats
+		getDecodeStats() const;
+
+		void
+		resetDecodeStats();
+
+		/**
+		 * @return
+		 * the number of decoders currently opened by the pool
+		 */
+		size_t
+		decoderCount() const;
+
+		/**
+		 * Leases a decoder from the pool. Preference is given to the idle
+		 * decoder closest behind 'frameIdx', as long as it's less than
+		 * REUSE_FRAME_DISTANCE frames behind and can read forward to it.
+		 * Otherwise a new decoder is opened if we're below the limit, else
+		 * the idle decoder positioned closest to 'frameIdx' is returned.
+		 * Blocks if all decoders are leased and the limit has been reached.
+		 *
+		 * @return
+		 * the leased decoder, or nullptr if a new decoder failed to open.
+		 */
+		DecoderPtr
+		acquire(
+			size_t frameIdx);
+
+		/**
+		 * Returns a decoder previously leased via acquire() back to the pool.
+		 */
+		void
+		release(
+			DecoderPtr decoder);
+
+		/**
+		 * Convenience method that leases a decoder, reads a frame, and returns
+		 * the decoder back to the pool.
+		 */
+		bool
+		readFrame(
+			cv::UMat &outImg,
+			size_t frameIdx);
+
+	private:
+		bool
+		openDecoder(
+			Decoder &decoder,
+			const VideoDecodeConfig &config);
+
+	private:
+		std::filesystem::path videoFile_;
+		size_t maxDecoders_;
+		VideoDecodeConfig config_;
+		size_t configGen_;
+		VideoDecodeStats stats_;
+
+		mutable std::mutex mutex_;
+		std::condition_variable idleCond_;
+		std::vector<DecoderPtr> idle_;
+		size_t nLeased_;
+
+	};
+}
+
+namespace YAML
+{
+	template<>
+	struct convert<gpo::VideoDecodeConfig>
+	{
+		static Node
+		encode(
+			const gpo::VideoDecodeConfig& rhs)
+		{
+			Node node;
+			node["threads"] = rhs.threads;
+
+			return node;
+		}
+
+		static bool
+		decode(
+			const Node& node,
+			gpo::VideoDecodeConfig& rhs)
+		{
+			// older projects may also have a 'pixelFormat', which is ignored
+			YAML_TO_FIELD(node,"threads",rhs.threads);
+
+			return true;
+		}
+	};
+}
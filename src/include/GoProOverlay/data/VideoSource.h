@@ -3,8 +3,11 @@
 #include <memory>
 #include <opencv2/core/mat.hpp>
 #include <opencv2/core/types.hpp> // for cv::Size
+#include <opencv2/videoio.hpp>
 
+#include "SeekState.h"
 #include "TelemetrySeeker.h"
+#include "VideoDecoderPool.h"
 
 namespace gpo
 {
@@ -12,16 +15,90 @@ namespace gpo
 	class DataSource;
 	using DataSourcePtr = std::shared_ptr<DataSource>;
 
+	// static properties of a video stream. these are probed once when the
+	// source is loaded (or restored from the telemetry cache) and then held here
+	// so we don't have to go back to the decoder every time they're needed.
+	struct VideoMetadata
+	{
+		double fps;
+		size_t frameCount;
+		int frameWidth;
+		int frameHeight;
+	};
+
+	/**
+	 * Non-owning handle onto a DataSource's video for the render loop. Like
+	 * TelemetryAccessor, the DataSource must outlive it (ie. hold a
+	 * RenderSession).
+	 */
+	class VideoAccessor
+	{
+	public:
+		VideoAccessor(
+			VideoDecoderPool *decoderPool,
+			const TelemetrySeeker *seeker,
+			double fps)
+		 : decoderPool_(decoderPool)
+		 , seeker_(seeker)
+		 , fps_(fps)
+		{}
+
+		size_t
+		seekedIdx() const
+		{
+			return seeker_->seekedIdx();
+		}
+
+		/**
+		 * @return
+		 * where this source is in 'state'
+		 */
+		size_t
+		seekedIdx(
+			const SeekState &state) const
+		{
+			return state.seekedIdx(seeker_);
+		}
+
+		double
+		fps() const
+		{
+			return fps_;
+		}
+
+		bool
+		getFrame(
+			cv::UMat &outImg,
+			size_t idx)
+		{
+			return decoderPool_->readFrame(outImg,idx);
+		}
+
+	private:
+		VideoDecoderPool *decoderPool_;
+		const TelemetrySeeker *seeker_;
+		double fps_;
+
+	};
+
 	class VideoSource
 	{
 	public:
-		explicit
+		/**
+		 * Constructs a VideoSource with known metadata. Frames are decoded
+		 * through the DataSource's decoder pool, which won't open a decoder
+		 * until the first call to getFrame().
+		 */
 		VideoSource(
-			DataSourcePtr dSrc);
+			DataSourcePtr dSrc,
+			const VideoMetadata &meta);
 
 		std::string
 		getDataSourceName() const;
 
+		std::string
+		getOriginFile() const;
+
 		int
 		frameWidth() const;
 
@@ -32,7 +109,7 @@ namespace gpo
 		frameSize() const;
 
 		double
-		fps();
+		fps() const;
 
 		bool
 		getFrame(
@@ -46,12 +123,48 @@ namespace gpo
 		seeker();
 
 		size_t
-		frameCount();
+		frameCount() const;
+
+		const VideoMetadata &
+		metadata() const;
+
+		/**
+		 * Sets the decode config for this source's video file. Note that
+		 * the decoders are shared with all other sources of the same file.
+		 */
+		void
+		setDecodeConfig(
+			const VideoDecodeConfig &config);
+
+		VideoDecodeConfig
+		getDecodeConfig() const;
+
+		VideoDecodeStats
+		getDecodeStats() const;
+
+		/**
+		 * @return
+		 * an accessor that reads frames without locking the DataSource.
+		 * see VideoAccessor for when it's safe to use.
+		 */
+		VideoAccessor
+		accessor();
+
+		void
+		resetDecodeStats();
+
+		/**
+		 * @return
+		 * the metadata of an opened video capture
+		 */
+		static
+		VideoMetadata
+		probeMetadata(
+			cv::VideoCapture &vCap);
 
 	private:
 		std::weak_ptr<DataSource> dataSrc_;
-		cv::Size frameSize_;
-		size_t prevFrameIdxRead_;
+		VideoMetadata meta_;
 
 	};
 
@@ -44,7 +44,8 @@ namespace gpo
 	protected:
 		virtual
 		void
-		subRender() override;
+		subRender(
+			const SeekState &state) override;
 
 		virtual
 		YAML::Node
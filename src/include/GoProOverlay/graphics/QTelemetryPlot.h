@@ -221,6 +221,16 @@ public:
 	getY_ComponentInfo(
 		const gpo::TelemetryPlot::Y_Component &comp);
 
+	/**
+	 * @return
+	 * the telemetry channel that's plotted for 'comp', or eTC_COUNT if
+	 * there isn't one
+	 */
+	static
+	gpo::TelemetryChannel_E
+	getY_ComponentChannel(
+		gpo::TelemetryPlot::Y_Component comp);
+
 private:
 	void
 	addSource_(
@@ -148,14 +148,36 @@ namespace gpo
 		double
 		getHighestFPS() const;
 
+		/**
+		 * Applies a default decode config to all video sources used by this
+		 * engine. Cores are split evenly between the distinct videos since
+		 * they're all decoded simultaneously while rendering.
+		 */
+		void
+		configureVideoDecoders();
+
 		// FIXME make mathod const and return const &
 		GroupedSeekerPtr
 		getSeeker();
 
+		/**
+		 * Renders the sources at their seekers' current positions
+		 */
 		void
 		renderInto(
 			cv::UMat &frame);
 
+		/**
+		 * Renders the sources at the positions in 'state'. No seekers are
+		 * moved, so the seekers can keep being used while this runs (ie. to
+		 * scrub a preview). see GroupedSeeker::stateAt(). The objects draw
+		 * into their own images though, so only one render can run at a time.
+		 */
+		void
+		renderInto(
+			cv::UMat &frame,
+			const SeekState &state);
+
 		void
 		render();
 
@@ -8,6 +8,7 @@
 
 #include "GoProOverlay/data/DataSource.h"
 #include "GoProOverlay/data/ModifiableObject.h"
+#include "GoProOverlay/data/SeekState.h"
 #include "GoProOverlay/data/TelemetrySource.h"
 #include "GoProOverlay/data/TrackDataObjects.h"
 #include "GoProOverlay/data/VideoSource.h"
@@ -175,9 +176,20 @@ namespace gpo
 		const cv::UMat &
 		getImage() const;
 
+		/**
+		 * Renders the object at the sources' current seeked positions
+		 */
 		void
 		render();
 
+		/**
+		 * Renders the object at the positions in 'state' without moving
+		 * any seekers
+		 */
+		void
+		render(
+			const SeekState &state);
+
 		virtual
 		void
 		drawInto(
@@ -312,9 +324,15 @@ namespace gpo
 		bool
 		trackReqsMet() const;
 
+		/**
+		 * @param[in] state
+		 * where to render the sources at. read positions through it (ie.
+		 * TelemetryAccessor::seekedIdx(state)) rather than the seekers.
+		 */
 		virtual
 		void
-		subRender() = 0;
+		subRender(
+			const SeekState &state) = 0;
 
 		virtual
 		YAML::Node
@@ -63,7 +63,8 @@ namespace gpo
 
 	protected:
 		void
-		subRender() override;
+		subRender(
+			const SeekState &state) override;
 
 		// callback from RenderedObject class when all source requirements are met
 		void
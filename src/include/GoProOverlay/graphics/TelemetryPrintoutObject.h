@@ -24,7 +24,8 @@ namespace gpo
 	protected:
 		virtual
 		void
-		subRender() override;
+		subRender(
+			const SeekState &state) override;
 
 		virtual
 		YAML::Node
@@ -45,7 +45,8 @@ namespace gpo
 
 	protected:
 		void
-		subRender() override;
+		subRender(
+			const SeekState &state) override;
 
 		YAML::Node
 		subEncode() const override;
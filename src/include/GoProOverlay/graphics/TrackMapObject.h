@@ -23,7 +23,8 @@ namespace gpo
 	protected:
 		virtual
 		void
-		subRender() override;
+		subRender(
+			const SeekState &state) override;
 
 		// callback from RenderedObject class when all source requirements are met
 		virtual
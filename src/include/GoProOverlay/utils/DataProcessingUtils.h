@@ -1,9 +1,13 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include "GoProOverlay/data/TelemetryColumns.h"
 #include "GoProOverlay/data/TelemetrySample.h"
+#include "GoProOverlay/data/TimeIndex.hpp"
 #include "GoProOverlay/data/TrackDataObjects.h"
 #include "GoProOverlay/utils/RingFIFO.hpp"
+#include "GoProOverlay/utils/StreamingResampler.h"
 #include <vector>
 
 namespace constants
@@ -71,6 +75,13 @@ namespace utils
 		cv::Vec3f &latDir,
 		cv::Vec3f &lonDir);
 
+	bool
+	computeVehicleDirectionVectors(
+		const gpo::TelemetryColumns &columns,
+		const gpo::DataAvailableBitSet &avail,
+		cv::Vec3f &latDir,
+		cv::Vec3f &lonDir);
+
 	bool
 	computeVehicleAcceleration(
 		gpo::TelemetrySamplesPtr tSamps,
@@ -78,12 +89,112 @@ namespace utils
 		const cv::Vec3f &latDir,
 		const cv::Vec3f &lonDir);
 
+	/**
+	 * Fused version of smoothing the accelerometer and then calling
+	 * computeVehicleAcceleration(). Works directly on the columns a chunk
+	 * at a time. Each chunk of accelerometer samples is smoothed, and then
+	 * lateral & longitudinal g-forces are computed in a single vectorized
+	 * loop. Gravity removal, projection, and unit conversion are folded
+	 * into one set of coefficients per axis.
+	 * 
+	 * @param[in] smoothingWindowSize
+	 * size of the centered moving average applied to the accelerometer.
+	 * smoothed values are stored in the eTC_CALC_SMOOTH_ACCL_* channels.
+	 * 
+	 * @return
+	 * true if the calculation was successful, false otherwise
+	 */
+	bool
+	computeVehicleAcceleration(
+		gpo::TelemetryColumns &columns,
+		gpo::DataAvailableBitSet &avail,
+		const cv::Vec3f &latDir,
+		const cv::Vec3f &lonDir,
+		size_t smoothingWindowSize);
+
 	bool
 	computeTrackTimes(
 		const std::shared_ptr<const gpo::Track> &track,
 		gpo::TelemetrySamplesPtr tSamps,
 		gpo::DataAvailableBitSet &avail);
 
+	/**
+	 * State of the lap/sector gate detection at the start of a sample
+	 */
+	struct TrackTimesState
+	{
+		// first sample processed with this state
+		size_t sampIdx;
+
+		// gates crossed by the sample before 'sampIdx'
+		size_t movesBefore;
+
+		// position within Track::getSortedPathObjects() of the object
+		// being watched for a crossing
+		size_t objIdx;
+
+		// true if watching the object's entry gate, false for its exit
+		bool isEntry;
+
+		int currLap;
+		int sectorSeq;
+		int currSector;
+		double lapStartTimeOffset;
+		double sectorStartTimeOffset;
+
+		// true if any sample before 'sampIdx' was within a lap/sector
+		bool lapSeen;
+		bool sectorSeen;
+	};
+
+	/**
+	 * Results from computeTrackTimes() that are kept so later calls can
+	 * skip work that a track edit didn't affect. Must be cleared whenever
+	 * the telemetry it was computed from changes.
+	 */
+	struct TrackTimesCache
+	{
+		// the track the cache was computed against, and its edit revision
+		const gpo::Track *track = nullptr;
+		size_t trackRevision = 0;
+
+		// number of gates the track had (sectors count as two)
+		size_t totalGatesInTrack = 0;
+
+		// nearest path index to each sample. these only depend on the
+		// track's path, so gate/sector edits don't invalidate them.
+		std::vector<uint32_t> onTrackIdx;
+
+		// detection state every time a gate was crossed, in sample order.
+		// the first entry is always the initial state at sample 0.
+		std::vector<TrackTimesState> checkpoints;
+
+		void
+		clear();
+	};
+
+	/**
+	 * Columnar version of computeTrackTimes() that picks up where a
+	 * previous call left off. On-track projections are reused as long as
+	 * the track's path doesn't change. When gates or sectors are edited,
+	 * gate detection resumes from the last checkpoint before any sample
+	 * that could have watched an edited object, and only the samples from
+	 * there on are rewritten.
+	 * 
+	 * @param[inout] cache
+	 * state from the previous call on 'columns'. an empty cache computes
+	 * everything from scratch.
+	 * 
+	 * @return
+	 * true if the calculation was successful, false otherwise
+	 */
+	bool
+	computeTrackTimes(
+		const std::shared_ptr<const gpo::Track> &track,
+		gpo::TelemetryColumns &columns,
+		gpo::DataAvailableBitSet &avail,
+		TrackTimesCache &cache);
+
 	template <typename T>
 	void
 	smoothMovingAvg(
@@ -183,6 +294,27 @@ namespace utils
 		return nCycles / samps.back().t_offset;
 	}
 
+	/**
+	 * Finds the pair of samples to interpolate between at time 't'. Unlike
+	 * gpt::findLerpIndex(), this doesn't scan from 'idx', so lookups are
+	 * O(1) for uniformly sampled data and O(log n) otherwise.
+	 *
+	 * @return
+	 * true if 't' lies within the samples' time range
+	 */
+	template <typename TimedSample_T>
+	bool
+	findLerpIndex(
+		size_t &idx,
+		const std::vector<TimedSample_T> &samps,
+		double t)
+	{
+		auto index = gpo::makeTimeIndex(samps.size(), [&samps](size_t i){
+			return samps[i].t_offset;
+		});
+		return index.findLerpIndex(idx, t);
+	}
+
 	void
 	lerp(
 		gpo::ECU_Sample &out,
@@ -197,6 +329,10 @@ namespace utils
 		const gpo::ECU_TimedSample &b,
 		double ratio);
 
+	/**
+	 * Linearly interpolates every channel of a TelemetrySample. Integer
+	 * channels (ie. lap, sector) are rounded to the nearest whole value.
+	 */
 	void
 	lerp(
 		gpo::TelemetrySample &out,
@@ -209,4 +345,29 @@ namespace utils
 		std::vector<gpo::ECU_TimedSample> &out,
 		const std::vector<gpo::ECU_TimedSample> &in,
 		double outRate_hz);
+
+	/**
+	 * Resamples telemetry to a fixed rate. Output samples before/after the
+	 * input's time range hold its first/last values. 'out' is built from
+	 * scratch with the same storage mode as 'in', and each channel is
+	 * processed in a single pass over the samples.
+	 * 
+	 * @param[in] avail
+	 * the channels that are valid in 'in'. compact storage drops the same
+	 * channels from 'out'.
+	 *
+	 * @param[in] config
+	 * how floating point channels are interpolated. only channels flagged
+	 * as ChannelDescriptor::bandLimited go through a band-limited kernel.
+	 * the rest (ie. lap/sector counters and timers, on track locations,
+	 * time offsets and track distances) are always interpolated linearly,
+	 * since a kernel would ring around their steps.
+	 */
+	void
+	resample(
+		gpo::TelemetryColumns &out,
+		const gpo::TelemetryColumns &in,
+		const gpo::DataAvailableBitSet &avail,
+		double outRate_hz,
+		const ResamplerConfig &config = ResamplerConfig::makeLinear());
 }
\ No newline at end of file
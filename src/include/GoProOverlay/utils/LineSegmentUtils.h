@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <opencv2/core/matx.hpp> // for cv::Vec2d
 
 namespace utils
@@ -29,4 +30,23 @@ namespace utils
 	doIntersect(
 		cv::Vec2d p1, cv::Vec2d q1,
 		cv::Vec2d p2, cv::Vec2d q2);
+
+	// number of segments whose bounding boxes are checked together
+	static constexpr size_t INTERSECT_BLOCK_SIZE = 8;
+
+	// Finds the first of a run of consecutive segments that intersects
+	// line segment 'p1q1'. Segment 'i' goes from point 'i-1' to point 'i',
+	// where 'xs' and 'ys' hold the points' first and second components.
+	// Segments are checked a block at a time against the bounding box of
+	// 'p1q1' (using SIMD where available), and only blocks that overlap it
+	// are checked with doIntersect().
+	// Returns the index of the intersecting segment in ['begin', 'end'),
+	// or 'end' if none intersect. 'begin' must be at least 1.
+	size_t
+	findFirstIntersect(
+		cv::Vec2d p1, cv::Vec2d q1,
+		const double *xs,
+		const double *ys,
+		size_t begin,
+		size_t end);
 }
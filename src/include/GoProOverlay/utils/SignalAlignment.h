@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "GoProOverlay/data/TelemetrySource.h"
+
+namespace utils
+{
+
+	enum AlignPreprocess_E
+	{
+		// correlate the channel's values as is
+		eAP_Value = 0,
+		// correlate the channel's rate of change (ie. engine speed's
+		// derivative lines up with longitudinal acceleration)
+		eAP_Derivative = 1
+	};
+
+	struct SignalAlignment
+	{
+		// number of samples 'b' trails 'a' by. a feature at a[i] shows up
+		// at b[i + lag].
+		int64_t lag;
+
+		// Pearson correlation of the overlapping samples at 'lag', in [-1,1].
+		// values near 1 mean the signals line up well.
+		double confidence;
+
+		// number of samples that overlap at 'lag'
+		size_t overlap;
+	};
+
+	/**
+	 * Finds the lag that best lines up two signals sampled at the same rate.
+	 * The cross-correlation at every lag is computed at once with an FFT,
+	 * and each lag is then scored by the correlation of just the samples
+	 * that overlap. That way lags where only the signals' edges overlap
+	 * aren't penalized (or favored) by how much overlaps.
+	 *
+	 * @param[in] minOverlap
+	 * lags where fewer samples than this overlap are ignored
+	 *
+	 * @return
+	 * false if no lag overlapped enough, or either signal is constant
+	 */
+	bool
+	findSignalAlignment(
+		const double *a,
+		size_t nA,
+		const double *b,
+		size_t nB,
+		size_t minOverlap,
+		SignalAlignment &result);
+
+	/**
+	 * Loads a telemetry channel as a signal for findSignalAlignment().
+	 */
+	void
+	getAlignmentSignal(
+		const gpo::TelemetrySource &tSrc,
+		gpo::TelemetryChannel_E channel,
+		AlignPreprocess_E preprocess,
+		std::vector<double> &signal);
+
+	/**
+	 * Finds how far 'srcB' trails 'srcA' by correlating a channel from
+	 * each. The sources should share a sample rate (ie. resample one to
+	 * match the other first). At least a quarter of the shorter source
+	 * must overlap.
+	 *
+	 * @return
+	 * false if no alignment could be found
+	 */
+	bool
+	findTelemetryAlignment(
+		const gpo::TelemetrySource &srcA,
+		gpo::TelemetryChannel_E channelA,
+		AlignPreprocess_E preprocessA,
+		const gpo::TelemetrySource &srcB,
+		gpo::TelemetryChannel_E channelB,
+		AlignPreprocess_E preprocessB,
+		SignalAlignment &result);
+
+}
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace utils
+{
+
+	enum FilterType_E
+	{
+		// centered moving average (zero phase)
+		eFT_MovingAvg = 0,
+		// single pole exponential smoothing (causal, so output lags input)
+		eFT_Exponential = 1,
+		// 2nd order Butterworth low-pass run forwards then backwards (zero phase)
+		eFT_Butterworth = 2
+	};
+
+	struct FilterConfig
+	{
+		FilterType_E type;
+
+		// eFT_MovingAvg: number of samples in the window. rounded up to odd.
+		size_t windowSize;
+
+		// eFT_Exponential: smoothing factor in (0,1]. 1 means no smoothing.
+		double alpha;
+
+		// eFT_Butterworth: -3dB cutoff frequency of each pass
+		double cutoff_hz;
+		double sampleRate_hz;
+
+		static
+		FilterConfig
+		makeMovingAvg(
+			size_t windowSize);
+
+		static
+		FilterConfig
+		makeExponential(
+			double alpha);
+
+		static
+		FilterConfig
+		makeButterworth(
+			double cutoff_hz,
+			double sampleRate_hz);
+
+		/**
+		 * @return
+		 * true if the parameters for 'type' are usable. logs why not otherwise.
+		 */
+		bool
+		isValid() const;
+	};
+
+	// number of channels filtered together in a single pass
+	static constexpr size_t FILTER_LANES = 4;
+
+	/**
+	 * One sample of up to FILTER_LANES channels. Lanes are kept together so
+	 * the filter kernels can update every channel's state with one SIMD op.
+	 */
+	struct alignas(FILTER_LANES * sizeof(double)) FilterLanes
+	{
+		double v[FILTER_LANES];
+	};
+
+	// coefficients for a biquad in direct form II transposed (a0 = 1)
+	struct BiquadCoeffs
+	{
+		double b0, b1, b2;
+		double a1, a2;
+
+		static
+		BiquadCoeffs
+		makeButterworthLowPass(
+			double cutoff_hz,
+			double sampleRate_hz);
+	};
+
+	template <typename LoadFn, typename StoreFn>
+	void
+	filterMovingAvg(
+		size_t nElements,
+		size_t windowSize,
+		LoadFn load,
+		StoreFn store)
+	{
+		// ensure window size is odd
+		if (windowSize % 2 == 0)
+		{
+			windowSize++;
+		}
+		const size_t halfWindow = (windowSize - 1) / 2;
+
+		// the window is centered on each sample and shrinks near the ends.
+		// samples are kept in a ring until they leave the window, so each
+		// input is loaded only once and outputs may overwrite inputs. sums
+		// are kept in double so adding/removing samples doesn't drift.
+		size_t ringSize = 1;
+		while (ringSize < (windowSize + 1))
+		{
+			ringSize <<= 1;
+		}
+		const size_t ringMask = ringSize - 1;
+		std::vector<FilterLanes> ring(ringSize);
+		FilterLanes sum = {};
+		size_t count = 0;
+		auto add = [&](size_t idx){
+			FilterLanes &slot = ring[idx & ringMask];
+			load(idx, slot);
+			for (size_t ll=0; ll<FILTER_LANES; ll++)
+			{
+				sum.v[ll] += slot.v[ll];
+			}
+			count++;
+		};
+
+		for (size_t i=0; i<=halfWindow && i<nElements; i++)
+		{
+			add(i);
+		}
+
+		FilterLanes mean;
+		for (size_t i=0; i<nElements; i++)
+		{
+			const double scale = 1.0 / count;
+			for (size_t ll=0; ll<FILTER_LANES; ll++)
+			{
+				mean.v[ll] = sum.v[ll] * scale;
+			}
+			store(i, mean);
+
+			// slide window forward by one sample
+			if ((i + halfWindow + 1) < nElements)
+			{
+				add(i + halfWindow + 1);
+			}
+			if (i >= halfWindow)
+			{
+				const FilterLanes &slot = ring[(i - halfWindow) & ringMask];
+				for (size_t ll=0; ll<FILTER_LANES; ll++)
+				{
+					sum.v[ll] -= slot.v[ll];
+				}
+				count--;
+			}
+		}
+	}
+
+	template <typename LoadFn, typename StoreFn>
+	void
+	filterExponential(
+		size_t nElements,
+		double alpha,
+		LoadFn load,
+		StoreFn store)
+	{
+		if (nElements == 0)
+		{
+			return;
+		}
+
+		FilterLanes state;
+		FilterLanes x;
+		load(0, state);
+		for (size_t i=0; i<nElements; i++)
+		{
+			load(i, x);
+			for (size_t ll=0; ll<FILTER_LANES; ll++)
+			{
+				state.v[ll] += alpha * (x.v[ll] - state.v[ll]);
+			}
+			store(i, state);
+		}
+	}
+
+	/**
+	 * Runs a biquad over 'samps' in place. The filter's state is initialized
+	 * as if the first sample had been held forever, which avoids a startup
+	 * transient at the ends of the data.
+	 */
+	void
+	biquadInPlace(
+		FilterLanes *samps,
+		size_t nElements,
+		bool forward,
+		const BiquadCoeffs &c);
+
+	template <typename LoadFn, typename StoreFn>
+	void
+	filterButterworth(
+		size_t nElements,
+		double cutoff_hz,
+		double sampleRate_hz,
+		LoadFn load,
+		StoreFn store)
+	{
+		// filtering backwards over the forward pass cancels the phase shift.
+		// that needs the whole forward pass, so this can't be streamed.
+		std::vector<FilterLanes> samps(nElements);
+		for (size_t i=0; i<nElements; i++)
+		{
+			load(i, samps[i]);
+		}
+
+		const auto coeffs = BiquadCoeffs::makeButterworthLowPass(cutoff_hz, sampleRate_hz);
+		biquadInPlace(samps.data(), nElements, true, coeffs);
+		biquadInPlace(samps.data(), nElements, false, coeffs);
+
+		for (size_t i=0; i<nElements; i++)
+		{
+			store(i, samps[i]);
+		}
+	}
+
+	/**
+	 * Filters up to FILTER_LANES channels in a single pass over the samples.
+	 *
+	 * @param[in] load
+	 * callable as load(size_t idx, FilterLanes &out) that fetches the input
+	 * channels of sample 'idx'. every sample is loaded before it's stored.
+	 *
+	 * @param[in] store
+	 * callable as store(size_t idx, const FilterLanes &in) that writes the
+	 * filtered channels of sample 'idx'. samples are stored in order.
+	 */
+	template <typename LoadFn, typename StoreFn>
+	void
+	filterChannels(
+		size_t nElements,
+		const FilterConfig &config,
+		LoadFn load,
+		StoreFn store)
+	{
+		if ( ! config.isValid())
+		{
+			// pass samples through unfiltered
+			FilterLanes x;
+			for (size_t i=0; i<nElements; i++)
+			{
+				load(i, x);
+				store(i, x);
+			}
+			return;
+		}
+
+		switch (config.type)
+		{
+			case eFT_MovingAvg:
+				filterMovingAvg(nElements, config.windowSize, load, store);
+				break;
+			case eFT_Exponential:
+				filterExponential(nElements, config.alpha, load, store);
+				break;
+			case eFT_Butterworth:
+				filterButterworth(nElements, config.cutoff_hz, config.sampleRate_hz, load, store);
+				break;
+		}
+	}
+
+	/**
+	 * Filters several fields of an array of structures, FILTER_LANES fields
+	 * per pass. Input and output may be the same array, and output fields
+	 * may overwrite input fields.
+	 */
+	template <typename STRUCT_T, typename FIELD_T, size_t N_FIELDS>
+	void
+	filterStructured(
+		const STRUCT_T *inVector,
+		STRUCT_T *outVector,
+		const std::array<size_t, N_FIELDS> &inFieldOffsets,
+		const std::array<size_t, N_FIELDS> &outFieldOffsets,
+		size_t nElements,
+		const FilterConfig &config)
+	{
+		for (size_t firstField=0; firstField<N_FIELDS; firstField+=FILTER_LANES)
+		{
+			const size_t nLanes = std::min(FILTER_LANES, N_FIELDS - firstField);
+			auto load = [&](size_t idx, FilterLanes &out){
+				const char *inElement = reinterpret_cast<const char *>(inVector + idx);
+				for (size_t ll=0; ll<FILTER_LANES; ll++)
+				{
+					out.v[ll] = (ll < nLanes ?
+						*reinterpret_cast<const FIELD_T *>(inElement + inFieldOffsets[firstField + ll]) :
+						0.0);
+				}
+			};
+			auto store = [&](size_t idx, const FilterLanes &in){
+				char *outElement = reinterpret_cast<char *>(outVector + idx);
+				for (size_t ll=0; ll<nLanes; ll++)
+				{
+					*reinterpret_cast<FIELD_T *>(outElement + outFieldOffsets[firstField + ll]) =
+						static_cast<FIELD_T>(in.v[ll]);
+				}
+			};
+			filterChannels(nElements, config, load, store);
+		}
+	}
+
+}
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "GoProOverlay/utils/SignalFilters.h"// for FilterLanes
+
+namespace utils
+{
+
+	enum ResampleMode_E
+	{
+		// interpolate between the two input samples that bound each output
+		eRM_Linear = 0,
+		// band-limited interpolation with a Blackman windowed-sinc kernel
+		eRM_WindowedSinc = 1
+	};
+
+	struct ResamplerConfig
+	{
+		ResampleMode_E mode;
+
+		// eRM_WindowedSinc: zero crossings of the sinc kept on each side of
+		// its center. more gives a sharper cutoff at the cost of more taps.
+		size_t zeroCrossings;
+
+		// eRM_WindowedSinc: number of fractional sample offsets the kernel
+		// is tabulated at. offsets in between are interpolated.
+		size_t nPhases;
+
+		static
+		ResamplerConfig
+		makeLinear();
+
+		static
+		ResamplerConfig
+		makeWindowedSinc(
+			size_t zeroCrossings = 8,
+			size_t nPhases = 64);
+
+		/**
+		 * @return
+		 * true if the parameters for 'mode' are usable. logs why not otherwise.
+		 */
+		bool
+		isValid() const;
+	};
+
+	/**
+	 * Converts a stream of samples to a fixed output rate in a single forward
+	 * pass. Input samples are pushed in time order, either one at a time or
+	 * in blocks, and every output that can be computed from what's been
+	 * pushed so far is emitted immediately. Only the last few input samples
+	 * are kept, so memory use doesn't depend on the length of the stream.
+	 *
+	 * Input timestamps don't need to be uniform (ECU logs rarely are). Each
+	 * output time is mapped to a fractional position between the pair of
+	 * input samples that bound it, and the kernel is evaluated at that
+	 * fractional offset. For uniform inputs this is a regular polyphase
+	 * resampler.
+	 *
+	 * Outputs before the first input hold its value, as do kernel taps that
+	 * fall off either end of the input.
+	 */
+	class StreamingResampler
+	{
+	public:
+		/**
+		 * @param[in] inRate_hz
+		 * nominal input rate. when downsampling, the kernel's cutoff is
+		 * lowered to the output's Nyquist frequency to avoid aliasing.
+		 *
+		 * @param[in] startTime_sec
+		 * time of the first output sample
+		 */
+		StreamingResampler(
+			double inRate_hz,
+			double outRate_hz,
+			const ResamplerConfig &config,
+			double startTime_sec = 0.0);
+
+		/**
+		 * @return
+		 * number of input samples on either side of an output that it
+		 * depends on. outputs are emitted this many samples behind the input.
+		 */
+		size_t
+		halfTaps() const;
+
+		/**
+		 * @return
+		 * number of output samples emitted so far
+		 */
+		size_t
+		outputCount() const;
+
+		/**
+		 * Pushes the next input sample.
+		 *
+		 * @param[in] onOutput
+		 * callable as onOutput(size_t outIdx, double t_sec, const FilterLanes &y)
+		 * that receives each output sample that became computable. outputs
+		 * are emitted in order.
+		 */
+		template <typename OutputFn>
+		void
+		push(
+			double t_sec,
+			const FilterLanes &x,
+			OutputFn onOutput)
+		{
+			const size_t slot = nIn_ & ringMask_;
+			histT_[slot] = t_sec;
+			histX_[slot] = x;
+			if (nIn_ == 0)
+			{
+				firstT_ = t_sec;
+				firstX_ = x;
+			}
+			nIn_++;
+			drain(onOutput, false, 0);
+		}
+
+		template <typename OutputFn>
+		void
+		pushBlock(
+			const double *t_sec,
+			const FilterLanes *x,
+			size_t nSamps,
+			OutputFn onOutput)
+		{
+			for (size_t i=0; i<nSamps; i++)
+			{
+				push(t_sec[i], x[i], onOutput);
+			}
+		}
+
+		/**
+		 * Emits outputs until 'totalOutputs' have been emitted, treating the
+		 * last pushed sample as the end of the input. Does nothing if no
+		 * samples were pushed.
+		 */
+		template <typename OutputFn>
+		void
+		finish(
+			size_t totalOutputs,
+			OutputFn onOutput)
+		{
+			drain(onOutput, true, totalOutputs);
+		}
+
+	private:
+		double
+		timeAt(
+			size_t idx) const
+		{
+			return histT_[idx & ringMask_];
+		}
+
+		const FilterLanes &
+		valueAt(
+			size_t idx) const
+		{
+			return histX_[idx & ringMask_];
+		}
+
+		/**
+		 * Computes the output at fractional offset 'frac' past sample
+		 * 'floorIdx_'. Taps past 'lastIdx' hold the last sample's value.
+		 */
+		void
+		interpolate(
+			double frac,
+			size_t lastIdx,
+			FilterLanes &y);
+
+		template <typename OutputFn>
+		void
+		drain(
+			OutputFn onOutput,
+			bool finishing,
+			size_t totalOutputs)
+		{
+			if (nIn_ == 0)
+			{
+				return;
+			}
+
+			const size_t lastIdx = nIn_ - 1;
+			FilterLanes y;
+			while ( ! finishing || outIdx_ < totalOutputs)
+			{
+				const double t = startTime_ + outIdx_ * outDt_;
+
+				// output times only move forward, so the bounding pair of
+				// input samples is tracked rather than searched for
+				while (floorIdx_ < lastIdx && timeAt(floorIdx_ + 1) <= t)
+				{
+					floorIdx_++;
+				}
+
+				if (t < firstT_)
+				{
+					y = firstX_;
+				}
+				else if (floorIdx_ == lastIdx)
+				{
+					// at or past the newest sample
+					if ( ! finishing)
+					{
+						break;
+					}
+					y = valueAt(lastIdx);
+				}
+				else if ( ! finishing && (floorIdx_ + halfTaps_) > lastIdx)
+				{
+					// kernel reaches past the newest sample
+					break;
+				}
+				else
+				{
+					const double tA = timeAt(floorIdx_);
+					const double tB = timeAt(floorIdx_ + 1);
+					interpolate((t - tA) / (tB - tA), lastIdx, y);
+				}
+				onOutput(outIdx_, t, y);
+				outIdx_++;
+			}
+		}
+
+	private:
+		ResampleMode_E mode_;
+		double startTime_;
+		double outDt_;
+
+		// kernel tabulated at (nPhases_ + 1) fractional offsets in [0,1]. row
+		// 'p' holds the weights of the 2 * halfTaps_ samples around an output
+		// at offset p / nPhases_ past the floor sample (oldest first).
+		size_t halfTaps_;
+		size_t nPhases_;
+		std::vector<double> table_;
+		std::vector<double> weights_;
+
+		// ring of the most recent input samples
+		size_t ringMask_;
+		std::vector<double> histT_;
+		std::vector<FilterLanes> histX_;
+		double firstT_;
+		FilterLanes firstX_;
+
+		// number of input samples pushed
+		size_t nIn_;
+		// index of the last input sample at or before the next output
+		size_t floorIdx_;
+		// index of the next output sample
+		size_t outIdx_;
+
+	};
+
+}
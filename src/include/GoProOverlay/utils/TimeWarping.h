@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <opencv2/core/matx.hpp> // for cv::Vec2d
+#include <vector>
+
+#include "GoProOverlay/data/TelemetrySource.h"
+
+namespace utils
+{
+
+	/**
+	 * Lines up two paths sample by sample with dynamic time warping. The
+	 * warping path is restricted to a band around the diagonal that joins
+	 * the first and last samples of each path, so both time and memory are
+	 * O(nA * bandRadius) rather than O(nA * nB).
+	 *
+	 * @param[in] bandRadius
+	 * how many samples of 'b' the path may stray from the diagonal. widened
+	 * if needed so the band stays connected when 'b' is much longer than 'a',
+	 * and so it spans all of 'b' when 'a' is a single sample.
+	 *
+	 * @param[out] bIdxForA
+	 * for each sample of 'a', the first sample of 'b' the path lines it up
+	 * with. the schedule is nondecreasing and starts at 0. repeated entries
+	 * mean samples of 'b' are held, and jumps mean samples of 'b' are skipped.
+	 *
+	 * @return
+	 * false if either path is empty
+	 */
+	bool
+	warpPaths(
+		const cv::Vec2d *a,
+		size_t nA,
+		const cv::Vec2d *b,
+		size_t nB,
+		size_t bandRadius,
+		std::vector<size_t> &bIdxForA);
+
+	/**
+	 * Lines up a range of samples from two telemetry sources by where they
+	 * were on the track (eTC_CALC_ON_TRACK_LAT/LON), so the same corner
+	 * lines up even when one run drives it slower.
+	 *
+	 * @param[in] rangeA
+	 * [first,last] sample indices from 'srcA' (ie. a lap's entry and exit)
+	 *
+	 * @param[in] bandRadius_sec
+	 * the most one run can lead or trail the other by, relative to a
+	 * constant speed ratio over the whole range
+	 *
+	 * @param[out] bIdxForA
+	 * for each sample in 'rangeA', the index into 'srcB' to show alongside it
+	 *
+	 * @return
+	 * false if either range is invalid
+	 */
+	bool
+	warpTelemetry(
+		const gpo::TelemetrySource &srcA,
+		std::pair<size_t, size_t> rangeA,
+		const gpo::TelemetrySource &srcB,
+		std::pair<size_t, size_t> rangeB,
+		double bandRadius_sec,
+		std::vector<size_t> &bIdxForA);
+
+}
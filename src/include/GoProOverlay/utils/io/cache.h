@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+#include "GoProOverlay/data/TelemetryColumns.h"
+#include "GoProOverlay/data/TelemetrySample.h"
+#include "GoProOverlay/data/VideoSource.h"
+
+namespace utils
+{
+namespace io
+{
+
+	// identifies the exact version of a source file that a cache was built from
+	struct CacheKey
+	{
+		uint64_t fileSize;
+
+		// std::filesystem::file_time_type ticks since epoch
+		int64_t mtime;
+
+		// FNV-1a hash over the file's head and tail blocks (see makeCacheKey())
+		uint64_t contentHash;
+	};
+
+	/**
+	 * Builds a CacheKey for a source file. Hashing an entire multi-gigabyte
+	 * video on every open would defeat the purpose of the cache, so only the
+	 * first and last blocks of the file are hashed. Combined with the file
+	 * size and mtime this is enough to catch re-encoded or re-copied files.
+	 *
+	 * @return
+	 * true if the key was built, false if the file could not be read.
+	 */
+	bool
+	makeCacheKey(
+		const std::filesystem::path &sourceFile,
+		CacheKey &keyOut);
+
+	/**
+	 * @return
+	 * the per-user directory that caches are stored in. this is
+	 * $XDG_CACHE_HOME/gopro-overlay, or ~/.cache/gopro-overlay if
+	 * XDG_CACHE_HOME isn't set. an empty path is returned if neither
+	 * location is known, in which case caching is disabled.
+	 */
+	std::filesystem::path
+	getCacheDir();
+
+	/**
+	 * @return
+	 * the location of the cache file for a source file with the given key,
+	 * or an empty path if caching is disabled (see getCacheDir()). caches
+	 * are named after the key, so nothing is ever written next to the
+	 * source file and copies of the same recording share one cache.
+	 */
+	std::filesystem::path
+	getCachePath(
+		const CacheKey &key);
+
+	/**
+	 * Writes telemetry samples (including any derived calc channels), the
+	 * data available bitset and optionally the video metadata to the
+	 * source file's cache. Telemetry is stored as an embedded
+	 * archive (see utils/io/gpot.h), so caches of long recordings stay small
+	 * and can be paged in on demand.
+	 *
+	 * @param[in] vMeta
+	 * video metadata to store. can be nullptr for non-video sources.
+	 *
+	 * @return
+	 * true if the cache was written. false if it couldn't be (ie. the cache
+	 * directory isn't writable), in which case the source simply isn't
+	 * cached.
+	 */
+	bool
+	writeCache(
+		const std::filesystem::path &sourceFile,
+		const gpo::TelemetrySamplesPtr &tSamps,
+		const gpo::DataAvailableBitSet &avail,
+		const gpo::VideoMetadata *vMeta);
+
+	bool
+	writeCache(
+		const std::filesystem::path &sourceFile,
+		const gpo::TelemetryColumns &columns,
+		const gpo::DataAvailableBitSet &avail,
+		const gpo::VideoMetadata *vMeta);
+
+	/**
+	 * Reads back a cache written by writeCache(). The cache
+	 * is only accepted if its key still matches the source file and it was
+	 * written by a compatible version of this library.
+	 *
+	 * @param[out] vMeta
+	 * populated with the cached video metadata. can be nullptr. if non-null
+	 * and the cache holds no video metadata, it's treated as a cache miss.
+	 *
+	 * @return
+	 * true if the cache was valid and loaded. false on miss/stale cache.
+	 */
+	bool
+	readCache(
+		const std::filesystem::path &sourceFile,
+		gpo::TelemetrySamplesPtr tSamps,
+		gpo::DataAvailableBitSet &avail,
+		gpo::VideoMetadata *vMeta);
+
+	/**
+	 * Same as above, but the cached telemetry isn't decompressed up front.
+	 * 'columns' pages it in from the cache as it's read.
+	 */
+	bool
+	readCache(
+		const std::filesystem::path &sourceFile,
+		gpo::TelemetryColumns &columns,
+		gpo::DataAvailableBitSet &avail,
+		gpo::VideoMetadata *vMeta);
+
+}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <filesystem>
+#include <ostream>
+
+#include "GoProOverlay/data/TelemetryColumns.h"
+#include "GoProOverlay/data/TelemetrySample.h"
+
+namespace utils
+{
+namespace io
+{
+
+	// file extension used by native binary telemetry files
+	static constexpr const char *GPOT_FILE_EXTENSION = ".gpot";
+	// file extension used by compressed telemetry archives
+	static constexpr const char *GPOZ_FILE_EXTENSION = ".gpoz";
+
+	/**
+	 * Writes telemetry to the native binary format. The file consists of a
+	 * versioned header, the DataAvailableBitSet, a channel directory, and
+	 * then each channel's encoded values stored contiguously and aligned so
+	 * that they can be used in place once memory mapped. Channels are
+	 * written in whatever encoding the columns currently use, so compact
+	 * telemetry stays compact on disk. Values are stored in host byte order.
+	 *
+	 * @return
+	 * true if the file was written
+	 */
+	bool
+	writeTelemetryToBinary(
+		const gpo::TelemetryColumns &columns,
+		const gpo::DataAvailableBitSet &avail,
+		const std::filesystem::path &binFilepath);
+
+	/**
+	 * Writes telemetry to a compressed archive. Each channel is split into
+	 * blocks of TELEM_CHUNK_SIZE samples. Every value in a block is delta
+	 * (integers) or XOR (floating point) encoded against the previous one,
+	 * the bytes are shuffled so like bytes are adjacent, and the block is
+	 * then deflated. Blocks don't depend on each other, so readers only
+	 * decompress the parts of a session they actually touch.
+	 *
+	 * @return
+	 * true if the file was written
+	 */
+	bool
+	writeTelemetryToArchive(
+		const gpo::TelemetryColumns &columns,
+		const gpo::DataAvailableBitSet &avail,
+		const std::filesystem::path &archiveFilepath);
+
+	/**
+	 * Writes a telemetry archive to a stream. Offsets within the archive are
+	 * relative to the stream's position when this is called, so archives can
+	 * be embedded in other files (see readTelemetryFromBinary()'s
+	 * 'payloadOffset').
+	 */
+	bool
+	writeTelemetryToArchive(
+		const gpo::TelemetryColumns &columns,
+		const gpo::DataAvailableBitSet &avail,
+		std::ostream &out);
+
+	/**
+	 * Memory maps a binary telemetry file written by writeTelemetryToBinary()
+	 * or writeTelemetryToArchive(). The format is detected from the file's
+	 * header rather than its extension.
+	 *
+	 * Uncompressed channels reference the mapped file directly, so opening
+	 * is O(1) in the number of samples. Compressed channels are decompressed
+	 * a block at a time the first time each block is read. Either way, chunks
+	 * are only copied into memory if modified.
+	 *
+	 * @param[in] payloadOffset
+	 * where the telemetry starts within the file. must be a multiple of 64.
+	 *
+	 * @return
+	 * true if the file was valid and mapped
+	 */
+	bool
+	readTelemetryFromBinary(
+		const std::filesystem::path &binFilepath,
+		gpo::TelemetryColumns &columns,
+		gpo::DataAvailableBitSet &avail,
+		uint64_t payloadOffset = 0);
+
+	/**
+	 * Converts between CSV, binary, and archived telemetry files. The
+	 * formats are determined by the file extensions.
+	 *
+	 * @return
+	 * true if the conversion succeeded
+	 */
+	bool
+	convertTelemetryFile(
+		const std::filesystem::path &inFilepath,
+		const std::filesystem::path &outFilepath);
+
+}
+}
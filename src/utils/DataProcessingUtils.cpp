@@ -1,9 +1,16 @@
 #include "GoProOverlay/utils/DataProcessingUtils.h"
 
 #include "GoProOverlay/utils/LineSegmentUtils.h"
+#include "GoProOverlay/utils/SignalFilters.h"
 #include "GoProTelem/SampleMath.h"// for lerp()
+#include <cmath>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
+#include <type_traits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace utils
 {
@@ -50,18 +57,16 @@ namespace utils
 		return prj;
 	}
 
-	bool
-	computeVehicleDirectionVectors(
-		gpo::TelemetrySamplesPtr tSamps,
-		const gpo::DataAvailableBitSet &avail,
+	// picks the vehicle's direction vectors based on the gravity vector at
+	// the start of the recording
+	static
+	void
+	directionVectorsFromGravity(
+		bool hasGrav,
+		const cv::Vec3f &grav0,
 		cv::Vec3f &latDir,
 		cv::Vec3f &lonDir)
 	{
-		if (tSamps->empty())
-		{
-			return false;
-		}
-
 		// default init
 		latDir[VEC3_X] = +0.0;
 		latDir[VEC3_Y] = +0.0;
@@ -77,25 +82,24 @@ namespace utils
 		// tell you the vehicle's longitudinal direction.
 		lonDir[VEC3_Y] = -1.0;
 
-		if (avail.test(gpo::DataAvailable::eDA_GOPRO_GRAV))
+		if (hasGrav)
 		{
 			// base lateral direction vectors on direction of gravity
 			// and our assumption on the vehicle's longitudinal direction.
-			const auto &grav0 = tSamps->at(0).gpSamp.grav;
 			const float G_THRESHOLD = 0.5;// half G
-			if (grav0.x > G_THRESHOLD)
+			if (grav0[VEC3_X] > G_THRESHOLD)
 			{
 				latDir[VEC3_Z] = -1.0;
 			}
-			else if (grav0.x < -G_THRESHOLD)
+			else if (grav0[VEC3_X] < -G_THRESHOLD)
 			{
 				latDir[VEC3_Z] = +1.0;
 			}
-			else if (grav0.z > G_THRESHOLD)
+			else if (grav0[VEC3_Z] > G_THRESHOLD)
 			{
 				latDir[VEC3_X] = +1.0;
 			}
-			else if (grav0.z < -G_THRESHOLD)
+			else if (grav0[VEC3_Z] < -G_THRESHOLD)
 			{
 				latDir[VEC3_X] = -1.0;
 			}
@@ -110,7 +114,46 @@ namespace utils
 			spdlog::warn("telemetry doesn't have gravity vector. using default lateral direction vectors");
 			latDir[VEC3_X] = -1.0;
 		}
+	}
 
+	bool
+	computeVehicleDirectionVectors(
+		gpo::TelemetrySamplesPtr tSamps,
+		const gpo::DataAvailableBitSet &avail,
+		cv::Vec3f &latDir,
+		cv::Vec3f &lonDir)
+	{
+		if (tSamps->empty())
+		{
+			return false;
+		}
+
+		const auto &grav = tSamps->at(0).gpSamp.grav;
+		cv::Vec3f grav0;
+		grav0[VEC3_X] = grav.x;
+		grav0[VEC3_Y] = grav.y;
+		grav0[VEC3_Z] = grav.z;
+		directionVectorsFromGravity(avail.test(gpo::DataAvailable::eDA_GOPRO_GRAV),grav0,latDir,lonDir);
+		return true;
+	}
+
+	bool
+	computeVehicleDirectionVectors(
+		const gpo::TelemetryColumns &columns,
+		const gpo::DataAvailableBitSet &avail,
+		cv::Vec3f &latDir,
+		cv::Vec3f &lonDir)
+	{
+		if (columns.empty())
+		{
+			return false;
+		}
+
+		cv::Vec3f grav0;
+		grav0[VEC3_X] = columns.channel<float>(gpo::eTC_GOPRO_GRAV_X)[0];
+		grav0[VEC3_Y] = columns.channel<float>(gpo::eTC_GOPRO_GRAV_Y)[0];
+		grav0[VEC3_Z] = columns.channel<float>(gpo::eTC_GOPRO_GRAV_Z)[0];
+		directionVectorsFromGravity(avail.test(gpo::DataAvailable::eDA_GOPRO_GRAV),grav0,latDir,lonDir);
 		return true;
 	}
 
@@ -204,29 +247,134 @@ namespace utils
 
 		return true;
 	}
-	
+
 	bool
-	computeTrackTimes(
-		const std::shared_ptr<const gpo::Track> &track,
-		gpo::TelemetrySamplesPtr tSamps,
-		gpo::DataAvailableBitSet &avail)
+	computeVehicleAcceleration(
+		gpo::TelemetryColumns &columns,
+		gpo::DataAvailableBitSet &avail,
+		const cv::Vec3f &latDir,
+		const cv::Vec3f &lonDir,
+		size_t smoothingWindowSize)
 	{
-		if ( ! track)
+		if ( ! avail.test(gpo::DataAvailable::eDA_GOPRO_ACCL))
 		{
-			spdlog::error("{} - track can't be null!", __func__);
+			spdlog::error("{} - telemetry has no acceleration source", __func__);
 			return false;
 		}
-		
-		std::vector<const gpo::TrackPathObject *> trackObjs;
-		if ( ! track->getSortedPathObjects(trackObjs))
+
+		// lat_g = dot(accl - grav * GRAVITY, latDirNorm) / GRAVITY
+		//       = dot(accl, latDirNorm / GRAVITY) + dot(grav, -latDirNorm)
+		// projecting onto a normalized direction and then dividing by that
+		// direction's non-zero component reduces to the dot product alone.
+		const bool hasGrav = avail.test(gpo::DataAvailable::eDA_GOPRO_GRAV);
+		const cv::Vec3f latDirNorm = normalize(latDir);
+		const cv::Vec3f lonDirNorm = normalize(lonDir);
+		float latAcclCoeff[3];
+		float lonAcclCoeff[3];
+		float latGravCoeff[3];
+		float lonGravCoeff[3];
+		for (size_t ii=0; ii<3; ii++)
 		{
-			return false;
+			latAcclCoeff[ii] = latDirNorm[ii] / constants::GRAVITY;
+			lonAcclCoeff[ii] = lonDirNorm[ii] / constants::GRAVITY;
+			latGravCoeff[ii] = (hasGrav ? -latDirNorm[ii] : 0.0f);
+			lonGravCoeff[ii] = (hasGrav ? -lonDirNorm[ii] : 0.0f);
 		}
-		else if (trackObjs.empty())
+
+		// allocate the output channels (compact mode only stores available ones)
+		avail.set(gpo::DataAvailable::eDA_CALC_SMOOTH_ACCL);
+		avail.set(gpo::DataAvailable::eDA_CALC_VEHI_ACCL);
+		columns.setDataAvailable(avail);
+
+		const std::array<gpo::ChannelView<float>, 3> accl = {
+			columns.channel<float>(gpo::eTC_GOPRO_ACCL_X),
+			columns.channel<float>(gpo::eTC_GOPRO_ACCL_Y),
+			columns.channel<float>(gpo::eTC_GOPRO_ACCL_Z)
+		};
+		const std::array<gpo::ChannelView<float>, 3> grav = {
+			columns.channel<float>(gpo::eTC_GOPRO_GRAV_X),
+			columns.channel<float>(gpo::eTC_GOPRO_GRAV_Y),
+			columns.channel<float>(gpo::eTC_GOPRO_GRAV_Z)
+		};
+
+		// outputs for the chunk being processed
+		std::array<std::vector<float>, 3> smooth;
+		std::array<std::vector<float>, 3> gravBuffer;
+		for (size_t ii=0; ii<3; ii++)
 		{
-			// no track objects to process
-			return true;
+			smooth[ii].resize(gpo::TELEM_CHUNK_SIZE);
+			gravBuffer[ii].assign(gpo::TELEM_CHUNK_SIZE, 0.0f);
 		}
+		std::vector<float> latG(gpo::TELEM_CHUNK_SIZE);
+		std::vector<float> lonG(gpo::TELEM_CHUNK_SIZE);
+
+		auto finishChunk = [&](size_t chunkIdx, size_t count){
+			// gravity is read in place when stored natively
+			const float *g[3];
+			for (size_t ii=0; ii<3; ii++)
+			{
+				g[ii] = (hasGrav ? grav[ii].chunkData(chunkIdx) : nullptr);
+				if (g[ii] == nullptr)
+				{
+					g[ii] = gravBuffer[ii].data();
+					for (size_t k=0; hasGrav && k<count; k++)
+					{
+						gravBuffer[ii][k] = grav[ii][(chunkIdx << gpo::TELEM_CHUNK_SHIFT) + k];
+					}
+				}
+			}
+
+			const float *sx = smooth[VEC3_X].data();
+			const float *sy = smooth[VEC3_Y].data();
+			const float *sz = smooth[VEC3_Z].data();
+			for (size_t k=0; k<count; k++)
+			{
+				latG[k] =
+					latAcclCoeff[VEC3_X] * sx[k] + latAcclCoeff[VEC3_Y] * sy[k] + latAcclCoeff[VEC3_Z] * sz[k] +
+					latGravCoeff[VEC3_X] * g[VEC3_X][k] + latGravCoeff[VEC3_Y] * g[VEC3_Y][k] + latGravCoeff[VEC3_Z] * g[VEC3_Z][k];
+				lonG[k] =
+					lonAcclCoeff[VEC3_X] * sx[k] + lonAcclCoeff[VEC3_Y] * sy[k] + lonAcclCoeff[VEC3_Z] * sz[k] +
+					lonGravCoeff[VEC3_X] * g[VEC3_X][k] + lonGravCoeff[VEC3_Y] * g[VEC3_Y][k] + lonGravCoeff[VEC3_Z] * g[VEC3_Z][k];
+			}
+
+			const size_t startIdx = chunkIdx << gpo::TELEM_CHUNK_SHIFT;
+			columns.assignChannel(gpo::eTC_CALC_SMOOTH_ACCL_X, startIdx, sx, count);
+			columns.assignChannel(gpo::eTC_CALC_SMOOTH_ACCL_Y, startIdx, sy, count);
+			columns.assignChannel(gpo::eTC_CALC_SMOOTH_ACCL_Z, startIdx, sz, count);
+			columns.assignChannel(gpo::eTC_CALC_VEHI_ACCL_LAT, startIdx, latG.data(), count);
+			columns.assignChannel(gpo::eTC_CALC_VEHI_ACCL_LON, startIdx, lonG.data(), count);
+		};
+
+		const size_t nSamps = columns.size();
+		filterChannels(
+			nSamps,
+			FilterConfig::makeMovingAvg(smoothingWindowSize),
+			[&accl](size_t idx, FilterLanes &out){
+				out.v[VEC3_X] = accl[VEC3_X][idx];
+				out.v[VEC3_Y] = accl[VEC3_Y][idx];
+				out.v[VEC3_Z] = accl[VEC3_Z][idx];
+				out.v[3] = 0.0;
+			},
+			[&](size_t idx, const FilterLanes &in){
+				const size_t localIdx = idx & gpo::TELEM_CHUNK_MASK;
+				smooth[VEC3_X][localIdx] = in.v[VEC3_X];
+				smooth[VEC3_Y][localIdx] = in.v[VEC3_Y];
+				smooth[VEC3_Z][localIdx] = in.v[VEC3_Z];
+				if (localIdx == gpo::TELEM_CHUNK_MASK || (idx + 1) == nSamps)
+				{
+					finishChunk(idx >> gpo::TELEM_CHUNK_SHIFT, localIdx + 1);
+				}
+			});
+
+		return true;
+	}
+	
+	// counts the gates among the track's objects. sectors have two.
+	static
+	size_t
+	countTrackGates(
+		const std::vector<const gpo::TrackPathObject *> &trackObjs)
+	{
 		size_t totalGatesInTrack = 0;
 		for (const auto &trackObj : trackObjs)
 		{
@@ -243,173 +391,722 @@ namespace utils
 				spdlog::warn("unknown track object. it's not a gate and it's not a sector.");
 			}
 		}
+		return totalGatesInTrack;
+	}
 
-		avail.reset(gpo::eDA_CALC_LAP);
-		avail.reset(gpo::eDA_CALC_LAP_TIME_OFFSET);
-		avail.reset(gpo::eDA_CALC_SECTOR);
-		avail.reset(gpo::eDA_CALC_SECTOR_TIME_OFFSET);
-		int currLap = -1;
-		int sectorSeq = 1;// increments everytime we exit a sector
-		int currSector = -1;
-		cv::Vec2d prevCoord;
-		auto tpoItr = trackObjs.begin();
-		bool isSector = (*tpoItr)->isSector();
-		bool isEntry = true;
-		double lapStartTimeOffset = 0;
-		double sectorStartTimeOffset = 0;
-		gpo::GateType_E gateType = (*tpoItr)->getGateType();
-		gpo::DetectionGate gate = (*tpoItr)->getEntryGate();
-		size_t onTrackFindInitialIdx = 0;
-		for (size_t ii=0; ii<tSamps->size(); ii++)
+	static
+	TrackTimesState
+	initialTrackTimesState()
+	{
+		TrackTimesState state;
+		state.sampIdx = 0;
+		state.movesBefore = 0;
+		state.objIdx = 0;
+		state.isEntry = true;
+		state.currLap = -1;
+		state.sectorSeq = 1;// increments everytime we exit a sector
+		state.currSector = -1;
+		state.lapStartTimeOffset = 0.0;
+		state.sectorStartTimeOffset = 0.0;
+		state.lapSeen = false;
+		state.sectorSeen = false;
+		return state;
+	}
+
+	// detection gates of the track's sorted objects, computed once up front
+	// rather than every time detection moves on to the next object
+	struct TrackGates
+	{
+		std::vector<gpo::DetectionGate> entry;
+		std::vector<gpo::DetectionGate> exit;
+	};
+
+	static
+	TrackGates
+	makeTrackGates(
+		const std::vector<const gpo::TrackPathObject *> &trackObjs)
+	{
+		TrackGates gates;
+		gates.entry.reserve(trackObjs.size());
+		gates.exit.reserve(trackObjs.size());
+		for (const auto &trackObj : trackObjs)
 		{
-			auto &samp = tSamps->at(ii);
-			auto &calcSamp = samp.calcSamp;
-			cv::Vec2d currCoord(samp.gpSamp.gps.coord.lat,samp.gpSamp.gps.coord.lon);
-			std::pair<size_t,size_t> onTrackFindWindow = {5,100};
-			if (samp.gpSamp.gps.speed2D < 0.447)// 0.447m/s ~= 1mph
-			{
-				// search everywhere when speed is low or stationary. we do this because we
-				// can get can have "clumps" of points to search through. this can result
-				// in us getting stuck inside the clump and never being able to search past
-				// if the search window isn't wide enough
-				onTrackFindWindow = {tSamps->size(),tSamps->size()};
-			}
-			else if (samp.gpSamp.gps.speed2D < 2.25)// 2.25m/s ~= 5mph
-			{
-				onTrackFindWindow = {100,500};
-			}
-			// TODO might want to look into quadtrees to improve this search algorithm
-			auto findRes = track->findClosestPointWithIdx(
-						currCoord,
-						onTrackFindInitialIdx,
-						onTrackFindWindow);
-			const auto &foundCoord = std::get<1>(findRes);
-			calcSamp.onTrackLL.lat = foundCoord[0];
-			calcSamp.onTrackLL.lon = foundCoord[1];
-			avail.set(gpo::eDA_CALC_ON_TRACK_LATLON);
-			onTrackFindInitialIdx = std::get<2>(findRes);
-
-			// see if we crossed 'gate'. if so, then move to the next logical gate in the 'trackObjs'
-			// list. we check these in a loop because sectors can have gates that are back-to-back,
-			// in which case we want to quickly progress through them and look for the next one that
-			// hasn't be crossed yet.
-			bool movedToNextObject = false;
-			size_t numMoves = 0;
-			do
-			{
-				movedToNextObject = false;
-				bool crossed = ii != 0 && gate.detect(prevCoord,foundCoord);
-				if (crossed && gateType == gpo::GateType_E::eGT_Start)
+			gates.entry.push_back(trackObj->getEntryGate());
+			gates.exit.push_back(trackObj->getExitGate());
+		}
+		return gates;
+	}
+
+	static
+	const gpo::DetectionGate &
+	watchedGate(
+		const TrackGates &gates,
+		const TrackTimesState &state)
+	{
+		return (state.isEntry ? gates.entry : gates.exit).at(state.objIdx);
+	}
+
+	/**
+	 * Finds the next sample whose path from the previous sample crosses the
+	 * gate currently being watched. No other sample can change the state.
+	 * 
+	 * @param[in] lats
+	 * @param[in] lons
+	 * on track location of every sample
+	 * 
+	 * @return
+	 * index of the crossing sample in [fromIdx, nSamps), or nSamps if none
+	 */
+	static
+	size_t
+	findNextCrossing(
+		const TrackGates &gates,
+		const TrackTimesState &state,
+		const double *lats,
+		const double *lons,
+		size_t fromIdx,
+		size_t nSamps)
+	{
+		// the first sample has no previous sample to cross from
+		const auto &gate = watchedGate(gates,state);
+		return utils::findFirstIntersect(gate.a(),gate.b(),lats,lons,std::max<size_t>(fromIdx,1),nSamps);
+	}
+
+	// searches everywhere when speed is low or stationary. we do this because we
+	// can get can have "clumps" of points to search through. this can result
+	// in us getting stuck inside the clump and never being able to search past
+	// if the search window isn't wide enough
+	static
+	std::pair<size_t,size_t>
+	onTrackFindWindow(
+		double speed2D,
+		size_t nSamps)
+	{
+		if (speed2D < 0.447)// 0.447m/s ~= 1mph
+		{
+			return {nSamps,nSamps};
+		}
+		else if (speed2D < 2.25)// 2.25m/s ~= 5mph
+		{
+			return {100,500};
+		}
+		return {5,100};
+	}
+
+	// samples per chunk when projecting onto the track in parallel
+	static constexpr size_t PROJECTION_CHUNK_SIZE = 4096;
+
+	/**
+	 * @return
+	 * true if a parallel region entered from here would get more than one
+	 * thread. it won't if OpenMP is disabled, or if we're already inside
+	 * a parallel region (ie. processing several sources at once).
+	 */
+	static
+	bool
+	canProjectInParallel()
+	{
+#ifdef _OPENMP
+		return omp_get_max_threads() > 1 && ! omp_in_parallel();
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * Finds the nearest path index to every sample's GPS location. Each
+	 * search is windowed around where the previous sample was found, so
+	 * the results are a sequential chain. To spread the work across cores,
+	 * every chunk of samples is first projected speculatively, starting from
+	 * the path point nearest its first sample. The chunks are then stitched
+	 * together in order: a chunk is redone from the real starting point only
+	 * until its results line up with the speculative ones, since from there
+	 * on they're identical. The output always matches a sequential pass.
+	 * 
+	 * @param[in] coordAt
+	 * callable as coordAt(size_t idx) returning the sample's cv::Vec2d lat/lon
+	 * 
+	 * @param[in] speedAt
+	 * callable as speedAt(size_t idx) returning the sample's 2D GPS speed
+	 */
+	template <typename CoordAt, typename SpeedAt>
+	static
+	void
+	projectOntoTrack(
+		const gpo::Track &track,
+		size_t nSamps,
+		CoordAt coordAt,
+		SpeedAt speedAt,
+		std::vector<uint32_t> &onTrackIdx)
+	{
+		onTrackIdx.resize(nSamps);
+		if (nSamps == 0)
+		{
+			return;
+		}
+		auto project = [&](size_t ii, size_t initialIdx) -> size_t
+		{
+			// wide windows are answered by the track's spatial index
+			auto findRes = track.findClosestPointWithIdx(
+						coordAt(ii),
+						initialIdx,
+						onTrackFindWindow(speedAt(ii),nSamps));
+			return std::get<2>(findRes);
+		};
+
+		// build the track's spatial index up front rather than racing to
+		track.findClosestPointWithIdx(coordAt(0));
+
+		// speculating only costs extra work when there's nobody to share it with
+		const size_t chunkSize = (canProjectInParallel() ? PROJECTION_CHUNK_SIZE : nSamps);
+		const size_t nChunks = (nSamps + chunkSize - 1) / chunkSize;
+		#pragma omp parallel for schedule(dynamic)
+		for (size_t cc=0; cc<nChunks; cc++)
+		{
+			const size_t begin = cc * chunkSize;
+			const size_t end = std::min(begin + chunkSize, nSamps);
+			size_t onTrackFindInitialIdx = 0;
+			if (cc > 0)
+			{
+				onTrackFindInitialIdx = std::get<2>(track.findClosestPointWithIdx(coordAt(begin)));
+			}
+			for (size_t ii=begin; ii<end; ii++)
+			{
+				onTrackFindInitialIdx = project(ii,onTrackFindInitialIdx);
+				onTrackIdx[ii] = onTrackFindInitialIdx;
+			}
+		}
+
+		for (size_t cc=1; cc<nChunks; cc++)
+		{
+			const size_t begin = cc * chunkSize;
+			const size_t end = std::min(begin + chunkSize, nSamps);
+			size_t onTrackFindInitialIdx = onTrackIdx[begin - 1];
+			for (size_t ii=begin; ii<end; ii++)
+			{
+				onTrackFindInitialIdx = project(ii,onTrackFindInitialIdx);
+				if (onTrackFindInitialIdx == onTrackIdx[ii])
 				{
-					lapStartTimeOffset = samp.t_offset;
-					if (currLap == -1)
-					{
-						currLap = 1;
-					}
-					else
-					{
-						currLap++;
-					}
+					// caught up with the speculative results
+					break;
 				}
-				else if (crossed && gateType == gpo::GateType_E::eGT_Finish)
+				onTrackIdx[ii] = onTrackFindInitialIdx;
+			}
+		}
+	}
+
+	/**
+	 * Advances the lap/sector detection state over one sample
+	 * 
+	 * @return
+	 * the number of gates the sample crossed
+	 */
+	static
+	size_t
+	stepTrackTimes(
+		const std::vector<const gpo::TrackPathObject *> &trackObjs,
+		const TrackGates &gates,
+		size_t totalGatesInTrack,
+		size_t sampIdx,
+		double tOffset,
+		const cv::Vec2d &prevCoord,
+		const cv::Vec2d &currCoord,
+		TrackTimesState &state)
+	{
+		// see if we crossed 'gate'. if so, then move to the next logical gate in the 'trackObjs'
+		// list. we check these in a loop because sectors can have gates that are back-to-back,
+		// in which case we want to quickly progress through them and look for the next one that
+		// hasn't be crossed yet.
+		bool movedToNextObject = false;
+		size_t numMoves = 0;
+		do
+		{
+			movedToNextObject = false;
+			const auto *trackObj = trackObjs[state.objIdx];
+			const auto gateType = trackObj->getGateType();
+			bool crossed = sampIdx != 0 && watchedGate(gates,state).detect(prevCoord,currCoord);
+			if (crossed && gateType == gpo::GateType_E::eGT_Start)
+			{
+				state.lapStartTimeOffset = tOffset;
+				if (state.currLap == -1)
 				{
-					currLap = -1;
+					state.currLap = 1;
 				}
-				else if (crossed && gateType == gpo::GateType_E::eGT_NOT_A_GATE)
+				else
 				{
-					if (isEntry)
-					{
-						currSector = sectorSeq;
-						sectorStartTimeOffset = samp.t_offset;
-					}
-					else
-					{
-						currSector = -1;
-						sectorSeq++;
-					}
+					state.currLap++;
 				}
-
-				// determine next gate to monitor for cross detection
-				if (crossed && ! isSector)
+			}
+			else if (crossed && gateType == gpo::GateType_E::eGT_Finish)
+			{
+				state.currLap = -1;
+			}
+			else if (crossed && gateType == gpo::GateType_E::eGT_NOT_A_GATE)
+			{
+				if (state.isEntry)
 				{
-					if (++tpoItr != trackObjs.end())
-					{
-						// crossed regular gate, so look for next track object now
-						gateType = (*tpoItr)->getGateType();
-						gate = (*tpoItr)->getEntryGate();
-						isSector = (*tpoItr)->isSector();
-						isEntry = true;
-						movedToNextObject = true;
-						numMoves++;
-					}
-					else
-					{
-						// crossed last track object, so loop back to first
-						sectorSeq = 1;
-						tpoItr = trackObjs.begin();
-						gateType = (*tpoItr)->getGateType();
-						gate = (*tpoItr)->getEntryGate();
-						isSector = (*tpoItr)->isSector();
-						isEntry = true;
-						movedToNextObject = true;
-						numMoves++;
-					}
+					state.currSector = state.sectorSeq;
+					state.sectorStartTimeOffset = tOffset;
 				}
-				else if (crossed && isSector)
+				else
 				{
-					if (isEntry)
-					{
-						// crossed sector entry, so look for exit now
-						gate = (*tpoItr)->getExitGate();
-						isEntry = false;
-						movedToNextObject = true;
-						numMoves++;
-					}
-					else if (++tpoItr != trackObjs.end())
-					{
-						// crossed sector exit, so look for next track object now
-						gateType = (*tpoItr)->getGateType();
-						gate = (*tpoItr)->getEntryGate();
-						isSector = (*tpoItr)->isSector();
-						isEntry = true;
-						movedToNextObject = true;
-						numMoves++;
-					}
-					else
-					{
-						// crossed last track object, so loop back to first
-						sectorSeq = 1;
-						tpoItr = trackObjs.begin();
-						gateType = (*tpoItr)->getGateType();
-						gate = (*tpoItr)->getEntryGate();
-						isSector = (*tpoItr)->isSector();
-						isEntry = true;
-						movedToNextObject = true;
-						numMoves++;
-					}
+					state.currSector = -1;
+					state.sectorSeq++;
+				}
+			}
+
+			// determine next gate to monitor for cross detection
+			if (crossed && trackObj->isSector() && state.isEntry)
+			{
+				// crossed sector entry, so look for exit now
+				state.isEntry = false;
+				movedToNextObject = true;
+				numMoves++;
+			}
+			else if (crossed)
+			{
+				// crossed a regular gate or a sector exit, so look for next track object now
+				if (++state.objIdx == trackObjs.size())
+				{
+					// crossed last track object, so loop back to first
+					state.sectorSeq = 1;
+					state.objIdx = 0;
 				}
+				state.isEntry = true;
+				movedToNextObject = true;
+				numMoves++;
+			}
+		}
+		while (movedToNextObject && numMoves < (totalGatesInTrack - 1));
+
+		return numMoves;
+	}
+
+	// computes a sample's lap/sector fields from the detection state
+	static
+	void
+	trackTimesAt(
+		TrackTimesState &state,
+		double tOffset,
+		int &lap,
+		double &lapTimeOffset,
+		int &sector,
+		double &sectorTimeOffset)
+	{
+		lap = state.currLap;
+		lapTimeOffset = (state.currLap == -1 ? 0.0 : tOffset - state.lapStartTimeOffset);
+		state.lapSeen = state.lapSeen || state.currLap != -1;
+
+		sector = state.currSector;
+		sectorTimeOffset = (state.currSector == -1 ? 0.0 : tOffset - state.sectorStartTimeOffset);
+		state.sectorSeen = state.sectorSeen || state.currSector != -1;
+	}
+	
+	// mean radius of the earth
+	static constexpr double EARTH_RADIUS_M = 6371000.0;
+
+	/**
+	 * Distance between two nearby coordinates. Uses an equirectangular
+	 * approximation, which is plenty accurate over the few meters between
+	 * successive samples.
+	 */
+	static
+	double
+	coordDistance_m(
+		double latA,
+		double lonA,
+		double latB,
+		double lonB)
+	{
+		const double DEG_TO_RAD = M_PI / 180.0;
+		const double meanLat = (latA + latB) * 0.5 * DEG_TO_RAD;
+		const double dx = (lonB - lonA) * DEG_TO_RAD * std::cos(meanLat);
+		const double dy = (latB - latA) * DEG_TO_RAD;
+		return EARTH_RADIUS_M * std::sqrt(dx*dx + dy*dy);
+	}
+
+	/**
+	 * Distance travelled along the track by each sample. Samples are
+	 * projected onto the path's points, so a sample's distance is the length
+	 * of the path up to its point, relative to where the first sample was.
+	 * Measuring along the path keeps GPS jitter from adding up, and keeps
+	 * corners from being cut when a sample skips ahead a few points.
+	 * Distances never decrease; wandering back while stopped holds the
+	 * distance, and wrapping from the path's end back to its start (ie. a
+	 * path that covers a single lap) carries on into the next lap.
+	 */
+	static
+	void
+	accumulateTrackDistance(
+		const gpo::Track &track,
+		const std::vector<uint32_t> &onTrackIdx,
+		double *distances)
+	{
+		const size_t nPoints = track.pathCount();
+		if (onTrackIdx.empty() || nPoints == 0)
+		{
+			std::fill(distances, distances + onTrackIdx.size(), 0.0);
+			return;
+		}
+
+		// prefix sums of the path's segment lengths
+		std::vector<double> pathDistances(nPoints, 0.0);
+		for (size_t pp=1; pp<nPoints; pp++)
+		{
+			const cv::Vec2d prev = track.getPathPoint(pp-1);
+			const cv::Vec2d curr = track.getPathPoint(pp);
+			pathDistances[pp] = pathDistances[pp-1] + coordDistance_m(prev[0],prev[1],curr[0],curr[1]);
+		}
+		const cv::Vec2d first = track.getPathPoint(0);
+		const cv::Vec2d last = track.getPathPoint(nPoints-1);
+		const double loopLength = pathDistances.back() + coordDistance_m(last[0],last[1],first[0],first[1]);
+
+		double loopStart = -pathDistances[onTrackIdx[0]];
+		double prevPathDistance = pathDistances[onTrackIdx[0]];
+		distances[0] = 0.0;
+		for (size_t ii=1; ii<onTrackIdx.size(); ii++)
+		{
+			const double pathDistance = pathDistances[onTrackIdx[ii]];
+			if (prevPathDistance - pathDistance > loopLength / 2.0)
+			{
+				loopStart += loopLength;
+			}
+			prevPathDistance = pathDistance;
+			distances[ii] = std::max(distances[ii-1], loopStart + pathDistance);
+		}
+	}
+
+	bool
+	computeTrackTimes(
+		const std::shared_ptr<const gpo::Track> &track,
+		gpo::TelemetrySamplesPtr tSamps,
+		gpo::DataAvailableBitSet &avail)
+	{
+		if ( ! track)
+		{
+			spdlog::error("{} - track can't be null!", __func__);
+			return false;
+		}
+		
+		std::vector<const gpo::TrackPathObject *> trackObjs;
+		if ( ! track->getSortedPathObjects(trackObjs))
+		{
+			return false;
+		}
+		else if (trackObjs.empty())
+		{
+			// no track objects to process
+			return true;
+		}
+		const size_t totalGatesInTrack = countTrackGates(trackObjs);
+
+		avail.reset(gpo::eDA_CALC_LAP);
+		avail.reset(gpo::eDA_CALC_LAP_TIME_OFFSET);
+		avail.reset(gpo::eDA_CALC_SECTOR);
+		avail.reset(gpo::eDA_CALC_SECTOR_TIME_OFFSET);
+		std::vector<uint32_t> onTrackIdx;
+		projectOntoTrack(
+			*track,
+			tSamps->size(),
+			[&tSamps](size_t idx){
+				const auto &coord = tSamps->at(idx).gpSamp.gps.coord;
+				return cv::Vec2d(coord.lat,coord.lon);
+			},
+			[&tSamps](size_t idx){
+				return tSamps->at(idx).gpSamp.gps.speed2D;
+			},
+			onTrackIdx);
+
+		const size_t nSamps = tSamps->size();
+		std::vector<double> onTrackLats(nSamps);
+		std::vector<double> onTrackLons(nSamps);
+		for (size_t ii=0; ii<nSamps; ii++)
+		{
+			auto &calcSamp = tSamps->at(ii).calcSamp;
+			const cv::Vec2d foundCoord = track->getPathPoint(onTrackIdx[ii]);
+			onTrackLats[ii] = foundCoord[0];
+			onTrackLons[ii] = foundCoord[1];
+			calcSamp.onTrackLL.lat = foundCoord[0];
+			calcSamp.onTrackLL.lon = foundCoord[1];
+			avail.set(gpo::eDA_CALC_ON_TRACK_LATLON);
+		}
+
+		std::vector<double> trackDistances(nSamps);
+		accumulateTrackDistance(*track,onTrackIdx,trackDistances.data());
+		for (size_t ii=0; ii<nSamps; ii++)
+		{
+			tSamps->at(ii).calcSamp.trackDistance_m = trackDistances[ii];
+		}
+		if (nSamps > 0)
+		{
+			avail.set(gpo::eDA_CALC_TRACK_DISTANCE);
+		}
+
+		const TrackGates gates = makeTrackGates(trackObjs);
+		TrackTimesState state = initialTrackTimesState();
+		size_t nextCrossIdx = findNextCrossing(gates,state,onTrackLats.data(),onTrackLons.data(),0,nSamps);
+		for (size_t ii=0; ii<nSamps; ii++)
+		{
+			auto &samp = tSamps->at(ii);
+			auto &calcSamp = samp.calcSamp;
+			if (ii == nextCrossIdx)
+			{
+				stepTrackTimes(
+					trackObjs,
+					gates,
+					totalGatesInTrack,
+					ii,
+					samp.t_offset,
+					cv::Vec2d(onTrackLats[ii-1],onTrackLons[ii-1]),
+					cv::Vec2d(onTrackLats[ii],onTrackLons[ii]),
+					state);
+				nextCrossIdx = findNextCrossing(gates,state,onTrackLats.data(),onTrackLons.data(),ii+1,nSamps);
 			}
-			while (movedToNextObject && numMoves < (totalGatesInTrack - 1));
 
 			// update telemetry sample
-			calcSamp.lap = currLap;
-			calcSamp.lapTimeOffset = (currLap == -1 ? 0.0 : samp.t_offset - lapStartTimeOffset);
-			if (currLap != -1)
+			trackTimesAt(
+				state,
+				samp.t_offset,
+				calcSamp.lap,
+				calcSamp.lapTimeOffset,
+				calcSamp.sector,
+				calcSamp.sectorTimeOffset);
+		}
+
+		if (state.lapSeen)
+		{
+			avail.set(gpo::eDA_CALC_LAP);
+			avail.set(gpo::eDA_CALC_LAP_TIME_OFFSET);
+		}
+		if (state.sectorSeen)
+		{
+			avail.set(gpo::eDA_CALC_SECTOR);
+			avail.set(gpo::eDA_CALC_SECTOR_TIME_OFFSET);
+		}
+
+		return true;
+	}
+
+	void
+	TrackTimesCache::clear()
+	{
+		track = nullptr;
+		trackRevision = 0;
+		totalGatesInTrack = 0;
+		onTrackIdx.clear();
+		checkpoints.clear();
+	}
+
+	// finds the nearest path point to every sample's GPS location and
+	// stores them in the eTC_CALC_ON_TRACK_* channels, along with the
+	// distance travelled between them
+	static
+	void
+	computeOnTrackLocations(
+		const gpo::Track &track,
+		gpo::TelemetryColumns &columns,
+		gpo::DataAvailableBitSet &avail,
+		std::vector<uint32_t> &onTrackIdx)
+	{
+		const size_t nSamps = columns.size();
+		const auto lats = columns.channel<double>(gpo::eTC_GOPRO_GPS_LAT);
+		const auto lons = columns.channel<double>(gpo::eTC_GOPRO_GPS_LON);
+		const auto speeds = columns.channel<double>(gpo::eTC_GOPRO_GPS_SPEED2D);
+		projectOntoTrack(
+			track,
+			nSamps,
+			[&lats, &lons](size_t idx){
+				return cv::Vec2d(lats[idx],lons[idx]);
+			},
+			[&speeds](size_t idx){
+				return speeds[idx];
+			},
+			onTrackIdx);
+
+		std::vector<double> onTrackLats(nSamps);
+		std::vector<double> onTrackLons(nSamps);
+		for (size_t ii=0; ii<nSamps; ii++)
+		{
+			const cv::Vec2d onTrackCoord = track.getPathPoint(onTrackIdx[ii]);
+			onTrackLats[ii] = onTrackCoord[0];
+			onTrackLons[ii] = onTrackCoord[1];
+		}
+
+		std::vector<double> trackDistances(nSamps);
+		accumulateTrackDistance(track,onTrackIdx,trackDistances.data());
+
+		avail.set(gpo::eDA_CALC_ON_TRACK_LATLON);
+		avail.set(gpo::eDA_CALC_TRACK_DISTANCE);
+		columns.setDataAvailable(avail);
+		columns.assignChannel(gpo::eTC_CALC_ON_TRACK_LAT, 0, onTrackLats.data(), nSamps);
+		columns.assignChannel(gpo::eTC_CALC_ON_TRACK_LON, 0, onTrackLons.data(), nSamps);
+		columns.assignChannel(gpo::eTC_CALC_TRACK_DISTANCE, 0, trackDistances.data(), nSamps);
+	}
+
+	bool
+	computeTrackTimes(
+		const std::shared_ptr<const gpo::Track> &track,
+		gpo::TelemetryColumns &columns,
+		gpo::DataAvailableBitSet &avail,
+		TrackTimesCache &cache)
+	{
+		if ( ! track)
+		{
+			spdlog::error("{} - track can't be null!", __func__);
+			return false;
+		}
+		else if (track->pathCount() == 0)
+		{
+			spdlog::error("{} - track has no path", __func__);
+			return false;
+		}
+
+		std::vector<const gpo::TrackPathObject *> trackObjs;
+		if ( ! track->getSortedPathObjects(trackObjs))
+		{
+			return false;
+		}
+		else if (trackObjs.empty())
+		{
+			// no track objects to process
+			return true;
+		}
+		const size_t totalGatesInTrack = countTrackGates(trackObjs);
+		const size_t nSamps = columns.size();
+
+		// figure out how much of the previous results are still valid
+		gpo::TrackEdits edits;
+		const bool reusable =
+			cache.track == track.get() &&
+			cache.onTrackIdx.size() == nSamps &&
+			! cache.checkpoints.empty() &&
+			track->getEditsSince(cache.trackRevision,edits) &&
+			! edits.pathChanged;
+		if ( ! reusable)
+		{
+			computeOnTrackLocations(*track,columns,avail,cache.onTrackIdx);
+			cache.checkpoints.assign(1,initialTrackTimesState());
+		}
+		else
+		{
+			// objects that lie entirely before the edited path range are the
+			// same, and in the same order, as last time. detection plays out
+			// the same up until it starts watching any object past those.
+			size_t unaffectedObjs = trackObjs.size();
+			if ( ! edits.empty())
 			{
-				avail.set(gpo::eDA_CALC_LAP);
-				avail.set(gpo::eDA_CALC_LAP_TIME_OFFSET);
+				unaffectedObjs = 0;
+				while (unaffectedObjs < trackObjs.size() &&
+					trackObjs[unaffectedObjs]->getExitIdx() < edits.firstPathIdx)
+				{
+					unaffectedObjs++;
+				}
+			}
+
+			// a chain of crossings within one sample is capped by the gate
+			// count, so a sample that hit either cap could play out differently
+			const size_t maxMoves = std::min(cache.totalGatesInTrack,totalGatesInTrack) - 1;
+			size_t resumeIdx = 0;
+			for (size_t cc=1; cc<cache.checkpoints.size(); cc++)
+			{
+				const auto &checkpoint = cache.checkpoints[cc];
+				if (checkpoint.objIdx >= unaffectedObjs || checkpoint.movesBefore >= maxMoves)
+				{
+					break;
+				}
+				resumeIdx = cc;
 			}
-			calcSamp.sector = currSector;
-			calcSamp.sectorTimeOffset = (currSector == -1 ? 0.0 : samp.t_offset - sectorStartTimeOffset);
-			if (currSector != -1)
+			cache.checkpoints.resize(resumeIdx + 1);
+		}
+		cache.track = track.get();
+		cache.trackRevision = track->getEditRevision();
+		cache.totalGatesInTrack = totalGatesInTrack;
+
+		TrackTimesState state = cache.checkpoints.back();
+		const size_t startIdx = state.sampIdx;
+		// if no sample before 'startIdx' was within a lap/sector, then those
+		// channels may not be stored yet (ie. compact telemetry), so fill
+		// them in from the start.
+		const size_t lapStartIdx = (state.lapSeen ? startIdx : 0);
+		const size_t sectorStartIdx = (state.sectorSeen ? startIdx : 0);
+		std::vector<int> laps(nSamps - lapStartIdx, -1);
+		std::vector<double> lapTimeOffsets(nSamps - lapStartIdx, 0.0);
+		std::vector<int> sectors(nSamps - sectorStartIdx, -1);
+		std::vector<double> sectorTimeOffsets(nSamps - sectorStartIdx, 0.0);
+
+		// on track locations from the sample before 'startIdx' onwards, so the
+		// first sample processed still has a previous location to cross from
+		const size_t coordBaseIdx = (startIdx > 0 ? startIdx - 1 : 0);
+		const size_t nCoords = nSamps - coordBaseIdx;
+		std::vector<double> onTrackLats(nCoords);
+		std::vector<double> onTrackLons(nCoords);
+		for (size_t cc=0; cc<nCoords; cc++)
+		{
+			const cv::Vec2d onTrackCoord = track->getPathPoint(cache.onTrackIdx[coordBaseIdx + cc]);
+			onTrackLats[cc] = onTrackCoord[0];
+			onTrackLons[cc] = onTrackCoord[1];
+		}
+
+		const auto tOffsets = columns.channel<double>(gpo::eTC_T_OFFSET);
+		const TrackGates gates = makeTrackGates(trackObjs);
+		auto nextCrossing = [&](size_t fromIdx) -> size_t {
+			return coordBaseIdx + findNextCrossing(
+				gates,
+				state,
+				onTrackLats.data(),
+				onTrackLons.data(),
+				fromIdx - coordBaseIdx,
+				nCoords);
+		};
+		size_t nextCrossIdx = nextCrossing(startIdx);
+		for (size_t ii=startIdx; ii<nSamps; ii++)
+		{
+			const double tOffset = tOffsets[ii];
+			size_t moves = 0;
+			if (ii == nextCrossIdx)
 			{
-				avail.set(gpo::eDA_CALC_SECTOR);
-				avail.set(gpo::eDA_CALC_SECTOR_TIME_OFFSET);
+				const size_t cc = ii - coordBaseIdx;
+				moves = stepTrackTimes(
+					trackObjs,
+					gates,
+					totalGatesInTrack,
+					ii,
+					tOffset,
+					cv::Vec2d(onTrackLats[cc-1],onTrackLons[cc-1]),
+					cv::Vec2d(onTrackLats[cc],onTrackLons[cc]),
+					state);
+				nextCrossIdx = nextCrossing(ii + 1);
 			}
 
-			prevCoord = foundCoord;
+			trackTimesAt(
+				state,
+				tOffset,
+				laps[ii - lapStartIdx],
+				lapTimeOffsets[ii - lapStartIdx],
+				sectors[ii - sectorStartIdx],
+				sectorTimeOffsets[ii - sectorStartIdx]);
+
+			if (moves > 0)
+			{
+				TrackTimesState checkpoint = state;
+				checkpoint.sampIdx = ii + 1;
+				checkpoint.movesBefore = moves;
+				cache.checkpoints.push_back(checkpoint);
+			}
 		}
 
+		avail.set(gpo::eDA_CALC_ON_TRACK_LATLON);
+		avail.set(gpo::eDA_CALC_TRACK_DISTANCE);
+		avail.set(gpo::eDA_CALC_LAP,state.lapSeen);
+		avail.set(gpo::eDA_CALC_LAP_TIME_OFFSET,state.lapSeen);
+		avail.set(gpo::eDA_CALC_SECTOR,state.sectorSeen);
+		avail.set(gpo::eDA_CALC_SECTOR_TIME_OFFSET,state.sectorSeen);
+		columns.setDataAvailable(avail);
+		columns.assignChannel(gpo::eTC_CALC_LAP, lapStartIdx, laps.data(), laps.size());
+		columns.assignChannel(gpo::eTC_CALC_LAP_TIME_OFFSET, lapStartIdx, lapTimeOffsets.data(), lapTimeOffsets.size());
+		columns.assignChannel(gpo::eTC_CALC_SECTOR, sectorStartIdx, sectors.data(), sectors.size());
+		columns.assignChannel(gpo::eTC_CALC_SECTOR_TIME_OFFSET, sectorStartIdx, sectorTimeOffsets.data(), sectorTimeOffsets.size());
+
 		return true;
 	}
 
@@ -436,34 +1133,96 @@ namespace utils
 		lerp(out.sample, a.sample, b.sample, ratio);
 	}
 
-	#define FIELD_LERP(OUT,A,B,RATIO,FIELD) OUT.FIELD = gpt::lerp(A.FIELD, B.FIELD, RATIO)
-	#define FIELD_LERP_ROUNDED(OUT,A,B,RATIO,FIELD) OUT.FIELD = std::round(gpt::lerp(A.FIELD, B.FIELD, RATIO))
+	template <typename T>
+	static
+	T
+	lerpChannelValue(
+		T a,
+		T b,
+		double ratio)
+	{
+		if constexpr (std::is_integral_v<T>)
+		{
+			// counters like lap/sector can't be fractional
+			return static_cast<T>(std::round(gpt::lerp(static_cast<double>(a), static_cast<double>(b), ratio)));
+		}
+		else
+		{
+			return gpt::lerp(a, b, ratio);
+		}
+	}
+
+	template <gpo::ChannelType_E TYPE>
+	static
+	constexpr size_t
+	channelCountOfType()
+	{
+		size_t count = 0;
+		for (const auto &desc : gpo::CHANNEL_DESCRIPTORS)
+		{
+			count += (desc.type == TYPE ? 1 : 0);
+		}
+		return count;
+	}
+
+	template <gpo::ChannelType_E TYPE>
+	static
+	constexpr std::array<size_t, channelCountOfType<TYPE>()>
+	sampleOffsetsOfType()
+	{
+		std::array<size_t, channelCountOfType<TYPE>()> offsets = {};
+		size_t n = 0;
+		for (const auto &desc : gpo::CHANNEL_DESCRIPTORS)
+		{
+			if (desc.type == TYPE)
+			{
+				offsets[n++] = desc.sampleOffset;
+			}
+		}
+		return offsets;
+	}
+
+	// byte offsets of every field within a TelemetrySample, grouped by type
+	// so that each group can be interpolated without branching per field
+	static constexpr auto FLOAT_SAMPLE_OFFSETS = sampleOffsetsOfType<gpo::eCT_FLOAT>();
+	static constexpr auto DOUBLE_SAMPLE_OFFSETS = sampleOffsetsOfType<gpo::eCT_DOUBLE>();
+	static constexpr auto INT_SAMPLE_OFFSETS = sampleOffsetsOfType<gpo::eCT_INT>();
+	static_assert(
+		FLOAT_SAMPLE_OFFSETS.size() + DOUBLE_SAMPLE_OFFSETS.size() + INT_SAMPLE_OFFSETS.size() == gpo::eTC_COUNT,
+		"every channel must be interpolated");
 
+	template <typename T, size_t N>
+	static
 	void
-	lerp(
+	lerpFields(
 		gpo::TelemetrySample &out,
 		const gpo::TelemetrySample &a,
 		const gpo::TelemetrySample &b,
-		double ratio)
+		double ratio,
+		const std::array<size_t, N> &offsets)
 	{
-		static bool warnedOnce = false;
-		if ( ! warnedOnce)
+		auto *outBytes = reinterpret_cast<char *>(&out);
+		const auto *aBytes = reinterpret_cast<const char *>(&a);
+		const auto *bBytes = reinterpret_cast<const char *>(&b);
+		for (const size_t offset : offsets)
 		{
-			spdlog::warn("lerp() on TelemetrySample is not a complete implementation yet");
-			warnedOnce = true;
+			*reinterpret_cast<T *>(outBytes + offset) = lerpChannelValue(
+				*reinterpret_cast<const T *>(aBytes + offset),
+				*reinterpret_cast<const T *>(bBytes + offset),
+				ratio);
 		}
-		
-		FIELD_LERP(out,a,b,ratio,t_offset);
-		// lerp(out.gpSamp, a.gpSamp, b.gpSamp, ratio);
-		lerp(out.ecuSamp, a.ecuSamp, b.ecuSamp, ratio);
-		// FIELD_LERP(out,a,b,ratio,onTrackLL);
-		FIELD_LERP_ROUNDED(out,a,b,ratio,calcSamp.lap);
-		FIELD_LERP(out,a,b,ratio,calcSamp.lapTimeOffset);
-		FIELD_LERP_ROUNDED(out,a,b,ratio,calcSamp.sector);
-		FIELD_LERP(out,a,b,ratio,calcSamp.sectorTimeOffset);
-		lerp(out.calcSamp.smoothAccl, a.calcSamp.smoothAccl, b.calcSamp.smoothAccl, ratio);
-		FIELD_LERP(out,a,b,ratio,calcSamp.vehiAccl.lat_g);
-		FIELD_LERP(out,a,b,ratio,calcSamp.vehiAccl.lon_g);
+	}
+
+	void
+	lerp(
+		gpo::TelemetrySample &out,
+		const gpo::TelemetrySample &a,
+		const gpo::TelemetrySample &b,
+		double ratio)
+	{
+		lerpFields<float>(out, a, b, ratio, FLOAT_SAMPLE_OFFSETS);
+		lerpFields<double>(out, a, b, ratio, DOUBLE_SAMPLE_OFFSETS);
+		lerpFields<int>(out, a, b, ratio, INT_SAMPLE_OFFSETS);
 	}
 
 	void
@@ -486,7 +1245,7 @@ namespace utils
 		double outTime_sec = 0.0;
 		for (size_t outIdx=0; outIdx<nSampsOut; outIdx++)
 		{
-			bool found = gpt::findLerpIndex(takeIdx,in,outTime_sec);
+			bool found = findLerpIndex(takeIdx,in,outTime_sec);
 
 			if (found)
 			{
@@ -507,4 +1266,212 @@ namespace utils
 			outTime_sec += outDt_sec;
 		}
 	}
+
+	// the pair of input samples an output sample is interpolated between
+	struct LerpStep
+	{
+		size_t idxA;
+		size_t idxB;
+		double ratio;
+	};
+
+	template <typename T>
+	static
+	void
+	resampleChannel(
+		gpo::TelemetryColumns &out,
+		const gpo::TelemetryColumns &in,
+		gpo::TelemetryChannel_E channel,
+		const std::vector<LerpStep> &steps)
+	{
+		const auto inValues = in.channel<T>(channel);
+		std::vector<T> outValues(std::min(gpo::TELEM_CHUNK_SIZE, steps.size()));
+		for (size_t blockStart=0; blockStart<steps.size(); blockStart+=gpo::TELEM_CHUNK_SIZE)
+		{
+			const size_t nInBlock = std::min(gpo::TELEM_CHUNK_SIZE, steps.size() - blockStart);
+			for (size_t i=0; i<nInBlock; i++)
+			{
+				const auto &step = steps[blockStart + i];
+				outValues[i] = lerpChannelValue(inValues[step.idxA], inValues[step.idxB], step.ratio);
+			}
+			out.assignChannel(channel, blockStart, outValues.data(), nInBlock);
+		}
+	}
+
+	/**
+	 * Resamples channels of type 'T' through a StreamingResampler,
+	 * FILTER_LANES channels per pass over the input.
+	 */
+	template <typename T>
+	static
+	void
+	resampleChannelsStreaming(
+		gpo::TelemetryColumns &out,
+		const gpo::TelemetryColumns &in,
+		const std::vector<gpo::TelemetryChannel_E> &channels,
+		size_t nSampsOut,
+		double outRate_hz,
+		const ResamplerConfig &config)
+	{
+		const auto tOffsets = in.channel<double>(gpo::eTC_T_OFFSET);
+		const size_t nSampsIn = in.size();
+		const double duration_sec = tOffsets[nSampsIn - 1] - tOffsets[0];
+		const double inRate_hz = (duration_sec > 0.0 ? (nSampsIn - 1) / duration_sec : outRate_hz);
+
+		std::vector<T> outValues[FILTER_LANES];
+		for (size_t firstCh=0; firstCh<channels.size(); firstCh+=FILTER_LANES)
+		{
+			const size_t nLanes = std::min(FILTER_LANES, channels.size() - firstCh);
+			std::vector<gpo::ChannelView<T>> inValues;
+			for (size_t ll=0; ll<nLanes; ll++)
+			{
+				inValues.push_back(in.channel<T>(channels[firstCh + ll]));
+				outValues[ll].resize(std::min(gpo::TELEM_CHUNK_SIZE, nSampsOut));
+			}
+
+			// outputs are buffered and written a block at a time
+			size_t blockStart = 0;
+			auto flushBlock = [&](size_t blockEnd){
+				for (size_t ll=0; ll<nLanes; ll++)
+				{
+					out.assignChannel(channels[firstCh + ll], blockStart, outValues[ll].data(), blockEnd - blockStart);
+				}
+				blockStart = blockEnd;
+			};
+			auto onOutput = [&](size_t outIdx, double /* t_sec */, const FilterLanes &y){
+				if (outIdx >= nSampsOut)
+				{
+					return;
+				}
+				for (size_t ll=0; ll<nLanes; ll++)
+				{
+					outValues[ll][outIdx - blockStart] = static_cast<T>(y.v[ll]);
+				}
+				if ((outIdx + 1 - blockStart) == gpo::TELEM_CHUNK_SIZE)
+				{
+					flushBlock(outIdx + 1);
+				}
+			};
+
+			StreamingResampler resampler(inRate_hz, outRate_hz, config);
+			FilterLanes x = {};
+			for (size_t i=0; i<nSampsIn; i++)
+			{
+				for (size_t ll=0; ll<nLanes; ll++)
+				{
+					x.v[ll] = inValues[ll][i];
+				}
+				resampler.push(tOffsets[i], x, onOutput);
+			}
+			resampler.finish(nSampsOut, onOutput);
+			if (blockStart < nSampsOut)
+			{
+				flushBlock(nSampsOut);
+			}
+		}
+	}
+
+	void
+	resample(
+		gpo::TelemetryColumns &out,
+		const gpo::TelemetryColumns &in,
+		const gpo::DataAvailableBitSet &avail,
+		double outRate_hz,
+		const ResamplerConfig &config)
+	{
+		out.clear();
+		out.setCompact(in.isCompact(), avail);
+		if (in.empty())
+		{
+			return;
+		}
+
+		const auto tOffsets = in.channel<double>(gpo::eTC_T_OFFSET);
+		const size_t nSampsIn = in.size();
+		const double duration_sec = tOffsets[nSampsIn - 1];
+		const size_t nSampsOut = round(outRate_hz * duration_sec);
+		const double outDt_sec = 1.0 / outRate_hz;
+
+		// output times only move forward, so the input samples to interpolate
+		// between can be found in a single pass rather than searched for
+		std::vector<LerpStep> steps(nSampsOut);
+		size_t floorIdx = 0;
+		double outTime_sec = 0.0;
+		for (size_t outIdx=0; outIdx<nSampsOut; outIdx++)
+		{
+			auto &step = steps[outIdx];
+			if (nSampsIn < 2 || outTime_sec < tOffsets[0])
+			{
+				step = {0, 0, 0.0};
+			}
+			else if (outTime_sec > tOffsets[nSampsIn - 1])
+			{
+				step = {nSampsIn - 1, nSampsIn - 1, 0.0};
+			}
+			else
+			{
+				while ((floorIdx + 1) < nSampsIn && tOffsets[floorIdx + 1] <= outTime_sec)
+				{
+					floorIdx++;
+				}
+				const size_t idxA = std::min(floorIdx, nSampsIn - 2);
+				const double tA = tOffsets[idxA];
+				const double tB = tOffsets[idxA + 1];
+				if (tB > tA)
+				{
+					step = {idxA, idxA + 1, (outTime_sec - tA) / (tB - tA)};
+				}
+				else
+				{
+					// repeated timestamps (ie. at the end of a log) leave
+					// nothing to interpolate across
+					step = {idxA, idxA, 0.0};
+				}
+			}
+			outTime_sec += outDt_sec;
+		}
+
+		out.resize(nSampsOut);
+		const bool useKernel = config.isValid() && config.mode != eRM_Linear;
+		std::vector<gpo::TelemetryChannel_E> kernelFloatChannels;
+		std::vector<gpo::TelemetryChannel_E> kernelDoubleChannels;
+		for (const auto &desc : gpo::CHANNEL_DESCRIPTORS)
+		{
+			if (out.getEncoding(desc.channel) == gpo::eCE_ABSENT)
+			{
+				continue;
+			}
+			// channels with steps or resets ring under the kernel, so only
+			// band-limited ones go through it
+			const bool kernelOkay = useKernel && desc.bandLimited;
+			switch (desc.type)
+			{
+				case gpo::eCT_FLOAT:
+					if (kernelOkay)
+					{
+						kernelFloatChannels.push_back(desc.channel);
+					}
+					else
+					{
+						resampleChannel<float>(out, in, desc.channel, steps);
+					}
+					break;
+				case gpo::eCT_DOUBLE:
+					if (kernelOkay)
+					{
+						kernelDoubleChannels.push_back(desc.channel);
+					}
+					else
+					{
+						resampleChannel<double>(out, in, desc.channel, steps);
+					}
+					break;
+				case gpo::eCT_INT:
+					resampleChannel<int>(out, in, desc.channel, steps);
+					break;
+			}
+		}
+		resampleChannelsStreaming<float>(out, in, kernelFloatChannels, nSampsOut, outRate_hz, config);
+		resampleChannelsStreaming<double>(out, in, kernelDoubleChannels, nSampsOut, outRate_hz, config);
+	}
 }
@@ -1,5 +1,11 @@
 #include "GoProOverlay/utils/LineSegmentUtils.h"
 
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace utils
 {
 	// Given three colinear points p, q, r, the function checks if 
@@ -73,4 +79,89 @@ namespace utils
 
 		return false; // Doesn't fall in any of the above cases
 	}
+
+	size_t
+	findFirstIntersect(
+		cv::Vec2d p1,
+		cv::Vec2d q1,
+		const double *xs,
+		const double *ys,
+		size_t begin,
+		size_t end)
+	{
+		// two segments can only intersect if their bounding boxes overlap
+		const double minX = std::min(p1[0], q1[0]);
+		const double maxX = std::max(p1[0], q1[0]);
+		const double minY = std::min(p1[1], q1[1]);
+		const double maxY = std::max(p1[1], q1[1]);
+		auto mayIntersect = [&](size_t i) -> bool {
+			return
+				std::max(xs[i-1], xs[i]) >= minX && std::min(xs[i-1], xs[i]) <= maxX &&
+				std::max(ys[i-1], ys[i]) >= minY && std::min(ys[i-1], ys[i]) <= maxY;
+		};
+		auto intersects = [&](size_t i) -> bool {
+			return mayIntersect(i) &&
+				doIntersect(p1, q1, cv::Vec2d(xs[i-1], ys[i-1]), cv::Vec2d(xs[i], ys[i]));
+		};
+#ifdef __SSE2__
+		const __m128d vMinX = _mm_set1_pd(minX);
+		const __m128d vMaxX = _mm_set1_pd(maxX);
+		const __m128d vMinY = _mm_set1_pd(minY);
+		const __m128d vMaxY = _mm_set1_pd(maxY);
+		// true if any of the block's segments may intersect. each lane
+		// holds one segment, with its start point in 'a' and its end in 'b'.
+		auto blockMayIntersect = [&](size_t i) -> bool {
+			__m128d overlaps = _mm_setzero_pd();
+			for (size_t bb=0; bb<INTERSECT_BLOCK_SIZE; bb+=2)
+			{
+				const __m128d ax = _mm_loadu_pd(xs + i + bb - 1);
+				const __m128d bx = _mm_loadu_pd(xs + i + bb);
+				const __m128d ay = _mm_loadu_pd(ys + i + bb - 1);
+				const __m128d by = _mm_loadu_pd(ys + i + bb);
+				__m128d overlap = _mm_cmpge_pd(_mm_max_pd(ax, bx), vMinX);
+				overlap = _mm_and_pd(overlap, _mm_cmple_pd(_mm_min_pd(ax, bx), vMaxX));
+				overlap = _mm_and_pd(overlap, _mm_cmpge_pd(_mm_max_pd(ay, by), vMinY));
+				overlap = _mm_and_pd(overlap, _mm_cmple_pd(_mm_min_pd(ay, by), vMaxY));
+				overlaps = _mm_or_pd(overlaps, overlap);
+			}
+			return _mm_movemask_pd(overlaps) != 0;
+		};
+#else
+		auto blockMayIntersect = [&](size_t i) -> bool {
+			for (size_t bb=0; bb<INTERSECT_BLOCK_SIZE; bb++)
+			{
+				if (mayIntersect(i + bb))
+				{
+					return true;
+				}
+			}
+			return false;
+		};
+#endif
+
+		size_t i = begin;
+		for (; (i + INTERSECT_BLOCK_SIZE) <= end; i += INTERSECT_BLOCK_SIZE)
+		{
+			if ( ! blockMayIntersect(i))
+			{
+				continue;
+			}
+
+			for (size_t bb=0; bb<INTERSECT_BLOCK_SIZE; bb++)
+			{
+				if (intersects(i + bb))
+				{
+					return i + bb;
+				}
+			}
+		}
+		for (; i < end; i++)
+		{
+			if (intersects(i))
+			{
+				return i;
+			}
+		}
+		return end;
+	}
 }
\ No newline at end of file
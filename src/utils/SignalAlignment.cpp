@@ -0,0 +1,328 @@
+#include "GoProOverlay/utils/SignalAlignment.h"
+
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace utils
+{
+
+	struct Complex
+	{
+		double re;
+		double im;
+	};
+
+	/**
+	 * In place radix-2 FFT. 'x.size()' must be a power of two. The inverse
+	 * transform is scaled by 1/n so that it undoes the forward one.
+	 */
+	static
+	void
+	fftInPlace(
+		std::vector<Complex> &x,
+		bool inverse)
+	{
+		const size_t n = x.size();
+		if (n < 2)
+		{
+			return;
+		}
+
+		// bit reversal permutation
+		for (size_t i=1, j=0; i<n; i++)
+		{
+			size_t bit = n >> 1;
+			for (; j & bit; bit >>= 1)
+			{
+				j ^= bit;
+			}
+			j ^= bit;
+			if (i < j)
+			{
+				std::swap(x[i], x[j]);
+			}
+		}
+
+		// twiddles for the last stage. earlier stages stride through them.
+		const double sign = (inverse ? 1.0 : -1.0);
+		std::vector<Complex> twiddles(n / 2);
+		for (size_t k=0; k<twiddles.size(); k++)
+		{
+			const double theta = sign * 2.0 * M_PI * k / n;
+			twiddles[k] = {std::cos(theta), std::sin(theta)};
+		}
+
+		for (size_t len=2; len<=n; len<<=1)
+		{
+			const size_t half = len / 2;
+			const size_t stride = n / len;
+			for (size_t start=0; start<n; start+=len)
+			{
+				Complex *lo = x.data() + start;
+				Complex *hi = lo + half;
+				for (size_t k=0; k<half; k++)
+				{
+					const Complex w = twiddles[k * stride];
+					const Complex v = {
+						hi[k].re * w.re - hi[k].im * w.im,
+						hi[k].re * w.im + hi[k].im * w.re};
+					hi[k] = {lo[k].re - v.re, lo[k].im - v.im};
+					lo[k] = {lo[k].re + v.re, lo[k].im + v.im};
+				}
+			}
+		}
+
+		if (inverse)
+		{
+			const double scale = 1.0 / n;
+			for (auto &c : x)
+			{
+				c.re *= scale;
+				c.im *= scale;
+			}
+		}
+	}
+
+	/**
+	 * Shifts and scales a signal to zero mean and unit variance, which keeps
+	 * the correlation sums well conditioned.
+	 *
+	 * @return
+	 * false if the signal is constant
+	 */
+	static
+	bool
+	standardize(
+		const double *in,
+		size_t n,
+		std::vector<double> &out)
+	{
+		double mean = 0.0;
+		for (size_t i=0; i<n; i++)
+		{
+			mean += in[i];
+		}
+		mean /= n;
+
+		double var = 0.0;
+		for (size_t i=0; i<n; i++)
+		{
+			var += (in[i] - mean) * (in[i] - mean);
+		}
+		if ( ! (var > 0.0))
+		{
+			return false;
+		}
+
+		const double invStd = 1.0 / std::sqrt(var / n);
+		out.resize(n);
+		for (size_t i=0; i<n; i++)
+		{
+			out[i] = (in[i] - mean) * invStd;
+		}
+		return true;
+	}
+
+	// prefix sums of a signal and its square. entry 'i' covers [0,i).
+	static
+	void
+	prefixSums(
+		const std::vector<double> &x,
+		std::vector<double> &sums,
+		std::vector<double> &sqrSums)
+	{
+		sums.assign(x.size() + 1, 0.0);
+		sqrSums.assign(x.size() + 1, 0.0);
+		for (size_t i=0; i<x.size(); i++)
+		{
+			sums[i + 1] = sums[i] + x[i];
+			sqrSums[i + 1] = sqrSums[i] + x[i] * x[i];
+		}
+	}
+
+	bool
+	findSignalAlignment(
+		const double *a,
+		size_t nA,
+		const double *b,
+		size_t nB,
+		size_t minOverlap,
+		SignalAlignment &result)
+	{
+		std::vector<double> za;
+		std::vector<double> zb;
+		if (nA == 0 || nB == 0 || ! standardize(a, nA, za) || ! standardize(b, nB, zb))
+		{
+			return false;
+		}
+		minOverlap = std::max<size_t>(minOverlap, 2);
+
+		// pad so the circular correlation doesn't wrap onto itself
+		size_t n = 1;
+		while (n < (nA + nB - 1))
+		{
+			n <<= 1;
+		}
+
+		// both signals are real, so they're packed into the real and
+		// imaginary parts of one transform and separated afterwards
+		std::vector<Complex> z(n, Complex{0.0, 0.0});
+		for (size_t i=0; i<nA; i++)
+		{
+			z[i].re = za[i];
+		}
+		for (size_t i=0; i<nB; i++)
+		{
+			z[i].im = zb[i];
+		}
+		fftInPlace(z, false);
+
+		// A[k] = (Z[k] + conj(Z[n-k])) / 2
+		// B[k] = (Z[k] - conj(Z[n-k])) / 2i
+		// the cross-correlation's spectrum is conj(A[k]) * B[k]
+		std::vector<Complex> spectrum(n);
+		for (size_t k=0; k<n; k++)
+		{
+			const Complex zk = z[k];
+			const Complex zn = z[(n - k) & (n - 1)];
+			const Complex ak = {(zk.re + zn.re) * 0.5, (zk.im - zn.im) * 0.5};
+			const Complex bk = {(zk.im + zn.im) * 0.5, (zn.re - zk.re) * 0.5};
+			spectrum[k] = {
+				ak.re * bk.re + ak.im * bk.im,
+				ak.re * bk.im - ak.im * bk.re};
+		}
+		fftInPlace(spectrum, true);
+		// spectrum[lag mod n].re now holds sum(a[i] * b[i + lag])
+
+		std::vector<double> sumsA, sqrSumsA, sumsB, sqrSumsB;
+		prefixSums(za, sumsA, sqrSumsA);
+		prefixSums(zb, sumsB, sqrSumsB);
+
+		bool found = false;
+		result = {0, -1.0, 0};
+		for (int64_t lag=-(int64_t)(nA - 1); lag<(int64_t)nB; lag++)
+		{
+			// samples of 'a' that overlap 'b' at this lag
+			const int64_t i0 = std::max<int64_t>(0, -lag);
+			const int64_t i1 = std::min<int64_t>(nA, nB - lag);
+			if ((i1 - i0) < (int64_t)minOverlap)
+			{
+				continue;
+			}
+
+			const double count = i1 - i0;
+			const double sa = sumsA[i1] - sumsA[i0];
+			const double saa = sqrSumsA[i1] - sqrSumsA[i0];
+			const double sb = sumsB[i1 + lag] - sumsB[i0 + lag];
+			const double sbb = sqrSumsB[i1 + lag] - sqrSumsB[i0 + lag];
+			const double sab = spectrum[(lag + n) & (n - 1)].re;
+			const double varA = saa - sa * sa / count;
+			const double varB = sbb - sb * sb / count;
+			if (varA <= 1e-9 * count || varB <= 1e-9 * count)
+			{
+				// one side is flat over the overlap
+				continue;
+			}
+
+			const double corr = (sab - sa * sb / count) / std::sqrt(varA * varB);
+			if (corr > result.confidence)
+			{
+				result.lag = lag;
+				result.confidence = corr;
+				result.overlap = i1 - i0;
+				found = true;
+			}
+		}
+		return found;
+	}
+
+	template <typename T>
+	static
+	void
+	copyChannel(
+		const gpo::TelemetrySource &tSrc,
+		gpo::TelemetryChannel_E channel,
+		std::vector<double> &out)
+	{
+		const auto view = tSrc.channel<T>(channel);
+		out.resize(view.size());
+		for (size_t i=0; i<view.size(); i++)
+		{
+			out[i] = view[i];
+		}
+	}
+
+	void
+	getAlignmentSignal(
+		const gpo::TelemetrySource &tSrc,
+		gpo::TelemetryChannel_E channel,
+		AlignPreprocess_E preprocess,
+		std::vector<double> &signal)
+	{
+		switch (gpo::getChannelDescriptor(channel).type)
+		{
+			case gpo::eCT_FLOAT:
+				copyChannel<float>(tSrc, channel, signal);
+				break;
+			case gpo::eCT_DOUBLE:
+				copyChannel<double>(tSrc, channel, signal);
+				break;
+			case gpo::eCT_INT:
+				copyChannel<int>(tSrc, channel, signal);
+				break;
+		}
+
+		if (preprocess == eAP_Derivative && signal.size() > 1)
+		{
+			// central difference over a few samples to keep sensor/ECU
+			// quantization noise from swamping the derivative. scale doesn't
+			// matter since the signals are standardized anyway.
+			const size_t SPAN = 2;
+			const size_t n = signal.size();
+			std::vector<double> deriv(n);
+			for (size_t i=0; i<n; i++)
+			{
+				const size_t lo = (i >= SPAN ? i - SPAN : 0);
+				const size_t hi = std::min(i + SPAN, n - 1);
+				deriv[i] = (signal[hi] - signal[lo]) / (hi - lo);
+			}
+			signal.swap(deriv);
+		}
+	}
+
+	bool
+	findTelemetryAlignment(
+		const gpo::TelemetrySource &srcA,
+		gpo::TelemetryChannel_E channelA,
+		AlignPreprocess_E preprocessA,
+		const gpo::TelemetrySource &srcB,
+		gpo::TelemetryChannel_E channelB,
+		AlignPreprocess_E preprocessB,
+		SignalAlignment &result)
+	{
+		const double rateA = srcA.getTelemetryRate_hz();
+		const double rateB = srcB.getTelemetryRate_hz();
+		if (std::abs(rateA - rateB) > (rateA * 0.01))
+		{
+			spdlog::warn(
+				"aligning sources with different sample rates ({}Hz vs {}Hz). resample one of them first.",
+				rateA,
+				rateB);
+		}
+
+		std::vector<double> signalA;
+		std::vector<double> signalB;
+		getAlignmentSignal(srcA, channelA, preprocessA, signalA);
+		getAlignmentSignal(srcB, channelB, preprocessB, signalB);
+		const size_t minOverlap = std::min(signalA.size(), signalB.size()) / 4;
+		return findSignalAlignment(
+			signalA.data(),
+			signalA.size(),
+			signalB.data(),
+			signalB.size(),
+			minOverlap,
+			result);
+	}
+
+}
@@ -0,0 +1,124 @@
+#include "GoProOverlay/utils/SignalFilters.h"
+
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace utils
+{
+
+	FilterConfig
+	FilterConfig::makeMovingAvg(
+		size_t windowSize)
+	{
+		FilterConfig config = {};
+		config.type = eFT_MovingAvg;
+		config.windowSize = windowSize;
+		return config;
+	}
+
+	FilterConfig
+	FilterConfig::makeExponential(
+		double alpha)
+	{
+		FilterConfig config = {};
+		config.type = eFT_Exponential;
+		config.alpha = alpha;
+		return config;
+	}
+
+	FilterConfig
+	FilterConfig::makeButterworth(
+		double cutoff_hz,
+		double sampleRate_hz)
+	{
+		FilterConfig config = {};
+		config.type = eFT_Butterworth;
+		config.cutoff_hz = cutoff_hz;
+		config.sampleRate_hz = sampleRate_hz;
+		return config;
+	}
+
+	bool
+	FilterConfig::isValid() const
+	{
+		switch (type)
+		{
+			case eFT_MovingAvg:
+				return true;
+			case eFT_Exponential:
+				if (alpha <= 0.0 || alpha > 1.0)
+				{
+					spdlog::error("exponential filter alpha must be in (0,1]. alpha = {}", alpha);
+					return false;
+				}
+				return true;
+			case eFT_Butterworth:
+				if (cutoff_hz <= 0.0 || cutoff_hz >= sampleRate_hz / 2.0)
+				{
+					spdlog::error(
+						"Butterworth cutoff must be between 0 and Nyquist. cutoff = {}Hz; sampleRate = {}Hz",
+						cutoff_hz,
+						sampleRate_hz);
+					return false;
+				}
+				return true;
+		}
+		spdlog::error("unknown filter type {}", static_cast<int>(type));
+		return false;
+	}
+
+	BiquadCoeffs
+	BiquadCoeffs::makeButterworthLowPass(
+		double cutoff_hz,
+		double sampleRate_hz)
+	{
+		// bilinear transform of a 2nd order analog Butterworth low-pass
+		const double k = std::tan(M_PI * cutoff_hz / sampleRate_hz);
+		const double norm = 1.0 / (1.0 + M_SQRT2 * k + k * k);
+		BiquadCoeffs c;
+		c.b0 = k * k * norm;
+		c.b1 = 2.0 * c.b0;
+		c.b2 = c.b0;
+		c.a1 = 2.0 * (k * k - 1.0) * norm;
+		c.a2 = (1.0 - M_SQRT2 * k + k * k) * norm;
+		return c;
+	}
+
+	void
+	biquadInPlace(
+		FilterLanes *samps,
+		size_t nElements,
+		bool forward,
+		const BiquadCoeffs &c)
+	{
+		if (nElements == 0)
+		{
+			return;
+		}
+
+		// steady state for a constant input (the filter has unity DC gain)
+		const size_t firstIdx = (forward ? 0 : nElements - 1);
+		FilterLanes z1;
+		FilterLanes z2;
+		for (size_t ll=0; ll<FILTER_LANES; ll++)
+		{
+			const double x0 = samps[firstIdx].v[ll];
+			z1.v[ll] = x0 * (1.0 - c.b0);
+			z2.v[ll] = x0 * (c.b2 - c.a2);
+		}
+
+		for (size_t n=0; n<nElements; n++)
+		{
+			FilterLanes &samp = samps[forward ? n : nElements - 1 - n];
+			for (size_t ll=0; ll<FILTER_LANES; ll++)
+			{
+				const double x = samp.v[ll];
+				const double y = c.b0 * x + z1.v[ll];
+				z1.v[ll] = c.b1 * x - c.a1 * y + z2.v[ll];
+				z2.v[ll] = c.b2 * x - c.a2 * y;
+				samp.v[ll] = y;
+			}
+		}
+	}
+
+}
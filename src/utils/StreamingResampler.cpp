@@ -0,0 +1,217 @@
+#include "GoProOverlay/utils/StreamingResampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace utils
+{
+
+	ResamplerConfig
+	ResamplerConfig::makeLinear()
+	{
+		ResamplerConfig config = {};
+		config.mode = eRM_Linear;
+		return config;
+	}
+
+	ResamplerConfig
+	ResamplerConfig::makeWindowedSinc(
+		size_t zeroCrossings,
+		size_t nPhases)
+	{
+		ResamplerConfig config = {};
+		config.mode = eRM_WindowedSinc;
+		config.zeroCrossings = zeroCrossings;
+		config.nPhases = nPhases;
+		return config;
+	}
+
+	bool
+	ResamplerConfig::isValid() const
+	{
+		switch (mode)
+		{
+			case eRM_Linear:
+				return true;
+			case eRM_WindowedSinc:
+				if (zeroCrossings == 0 || nPhases == 0)
+				{
+					spdlog::error(
+						"windowed-sinc resampler needs at least one zero crossing and phase. zeroCrossings = {}; nPhases = {}",
+						zeroCrossings,
+						nPhases);
+					return false;
+				}
+				return true;
+		}
+		spdlog::error("unknown resample mode {}", static_cast<int>(mode));
+		return false;
+	}
+
+	// normalized sinc, sin(pi*x)/(pi*x)
+	static
+	double
+	sinc(
+		double x)
+	{
+		if (x == 0.0)
+		{
+			return 1.0;
+		}
+		const double px = M_PI * x;
+		return std::sin(px) / px;
+	}
+
+	// Blackman window over [-1,1]
+	static
+	double
+	blackman(
+		double u)
+	{
+		if (std::abs(u) >= 1.0)
+		{
+			return 0.0;
+		}
+		return 0.42 + 0.5 * std::cos(M_PI * u) + 0.08 * std::cos(2.0 * M_PI * u);
+	}
+
+	StreamingResampler::StreamingResampler(
+		double inRate_hz,
+		double outRate_hz,
+		const ResamplerConfig &config,
+		double startTime_sec)
+	 : mode_(eRM_Linear)
+	 , startTime_(startTime_sec)
+	 , outDt_(1.0 / outRate_hz)
+	 , halfTaps_(1)
+	 , nPhases_(0)
+	 , table_()
+	 , weights_()
+	 , ringMask_(0)
+	 , histT_()
+	 , histX_()
+	 , firstT_(0.0)
+	 , firstX_()
+	 , nIn_(0)
+	 , floorIdx_(0)
+	 , outIdx_(0)
+	{
+		if (config.isValid() && config.mode == eRM_WindowedSinc)
+		{
+			mode_ = eRM_WindowedSinc;
+			nPhases_ = config.nPhases;
+
+			// when downsampling, stretch the kernel so its cutoff lands on the
+			// output's Nyquist frequency (in units of the input's)
+			double cutoff = 1.0;
+			if (inRate_hz > 0.0 && outRate_hz < inRate_hz)
+			{
+				cutoff = outRate_hz / inRate_hz;
+			}
+			halfTaps_ = std::ceil(config.zeroCrossings / cutoff);
+
+			const size_t nTaps = halfTaps_ * 2;
+			table_.resize((nPhases_ + 1) * nTaps);
+			weights_.resize(nTaps);
+			for (size_t p=0; p<=nPhases_; p++)
+			{
+				const double frac = static_cast<double>(p) / nPhases_;
+				double *row = table_.data() + p * nTaps;
+				double sum = 0.0;
+				for (size_t tap=0; tap<nTaps; tap++)
+				{
+					// distance from the output to the tap's input sample
+					const double d = frac + halfTaps_ - 1.0 - tap;
+					row[tap] = sinc(d * cutoff) * blackman(d / halfTaps_);
+					sum += row[tap];
+				}
+				// unity gain at DC so constant inputs pass through unchanged
+				for (size_t tap=0; tap<nTaps; tap++)
+				{
+					row[tap] /= sum;
+				}
+			}
+		}
+
+		// taps reach back as far as halfTaps_ samples before the floor
+		// sample, which trails the newest sample by up to halfTaps_
+		size_t ringSize = 1;
+		while (ringSize < (halfTaps_ * 2 + 2))
+		{
+			ringSize <<= 1;
+		}
+		ringMask_ = ringSize - 1;
+		histT_.resize(ringSize);
+		histX_.resize(ringSize);
+	}
+
+	size_t
+	StreamingResampler::halfTaps() const
+	{
+		return halfTaps_;
+	}
+
+	size_t
+	StreamingResampler::outputCount() const
+	{
+		return outIdx_;
+	}
+
+	void
+	StreamingResampler::interpolate(
+		double frac,
+		size_t lastIdx,
+		FilterLanes &y)
+	{
+		if (mode_ == eRM_Linear)
+		{
+			const FilterLanes &a = valueAt(floorIdx_);
+			const FilterLanes &b = valueAt(floorIdx_ + 1);
+			for (size_t ll=0; ll<FILTER_LANES; ll++)
+			{
+				y.v[ll] = a.v[ll] + (b.v[ll] - a.v[ll]) * frac;
+			}
+			return;
+		}
+
+		// blend the two nearest tabulated phases
+		const size_t nTaps = halfTaps_ * 2;
+		const double phasePos = frac * nPhases_;
+		const size_t phase = std::min(static_cast<size_t>(phasePos), nPhases_ - 1);
+		const double blend = phasePos - phase;
+		const double *rowA = table_.data() + phase * nTaps;
+		const double *rowB = rowA + nTaps;
+		for (size_t tap=0; tap<nTaps; tap++)
+		{
+			weights_[tap] = rowA[tap] + (rowB[tap] - rowA[tap]) * blend;
+		}
+
+		y = {};
+		for (size_t tap=0; tap<nTaps; tap++)
+		{
+			// tap 0 is 'halfTaps_ - 1' samples before the floor sample
+			const size_t idx = floorIdx_ + 1 + tap;
+			const FilterLanes *x = nullptr;
+			if (idx < halfTaps_)
+			{
+				x = &firstX_;
+			}
+			else if ((idx - halfTaps_) > lastIdx)
+			{
+				x = &valueAt(lastIdx);
+			}
+			else
+			{
+				x = &valueAt(idx - halfTaps_);
+			}
+
+			const double w = weights_[tap];
+			for (size_t ll=0; ll<FILTER_LANES; ll++)
+			{
+				y.v[ll] += w * x->v[ll];
+			}
+		}
+	}
+
+}
@@ -0,0 +1,204 @@
+#include "GoProOverlay/utils/TimeWarping.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <spdlog/spdlog.h>
+
+namespace utils
+{
+
+	// how a cell of the cost matrix was reached
+	enum WarpStep_E : uint8_t
+	{
+		eWS_Diagonal = 0,
+		// from (i-1,j). b[j] is held for another sample of 'a'
+		eWS_Hold = 1,
+		// from (i,j-1). b[j-1] is skipped over
+		eWS_Skip = 2
+	};
+
+	bool
+	warpPaths(
+		const cv::Vec2d *a,
+		size_t nA,
+		const cv::Vec2d *b,
+		size_t nB,
+		size_t bandRadius,
+		std::vector<size_t> &bIdxForA)
+	{
+		bIdxForA.clear();
+		if (nA == 0 || nB == 0)
+		{
+			return false;
+		}
+
+		// each row's band is centered on the straight line from (0,0) to
+		// (nA-1,nB-1). it has to be at least as wide as that line's slope or
+		// neighboring rows wouldn't overlap.
+		const double slope = (nA > 1 ? static_cast<double>(nB - 1) / (nA - 1) : 0.0);
+		bandRadius = std::max(bandRadius, static_cast<size_t>(std::ceil(slope)) + 1);
+		if (nA == 1)
+		{
+			// there's no line to follow. the only row has to span all of 'b'
+			// for the path to reach (0,nB-1).
+			bandRadius = std::max(bandRadius, nB - 1);
+		}
+		const size_t bandWidth = bandRadius * 2 + 1;
+		auto bandLo = [&](size_t i) -> size_t {
+			const size_t center = std::lround(i * slope);
+			return (center > bandRadius ? center - bandRadius : 0);
+		};
+		auto bandHi = [&](size_t i) -> size_t {
+			const size_t center = std::lround(i * slope);
+			return std::min(center + bandRadius, nB - 1);
+		};
+
+		// only two rows of cost are kept, but every cell's step is kept
+		// so the path can be traced back afterwards
+		const double INF = std::numeric_limits<double>::infinity();
+		std::vector<double> prevCost(bandWidth, INF);
+		std::vector<double> currCost(bandWidth, INF);
+		std::vector<uint8_t> steps(nA * bandWidth, eWS_Diagonal);
+		size_t prevLo = 0;
+		size_t prevHi = 0;
+		for (size_t i=0; i<nA; i++)
+		{
+			const size_t lo = bandLo(i);
+			const size_t hi = bandHi(i);
+			uint8_t *rowSteps = steps.data() + i * bandWidth;
+			for (size_t j=lo; j<=hi; j++)
+			{
+				const double dx = a[i][0] - b[j][0];
+				const double dy = a[i][1] - b[j][1];
+				const double cost = std::sqrt(dx * dx + dy * dy);
+				if (i == 0 && j == 0)
+				{
+					currCost[0] = cost;
+					continue;
+				}
+
+				double best = INF;
+				uint8_t step = eWS_Diagonal;
+				if (i > 0 && j > 0 && prevLo <= (j - 1) && (j - 1) <= prevHi)
+				{
+					best = prevCost[j - 1 - prevLo];
+				}
+				if (i > 0 && prevLo <= j && j <= prevHi && prevCost[j - prevLo] < best)
+				{
+					best = prevCost[j - prevLo];
+					step = eWS_Hold;
+				}
+				if (j > lo && currCost[j - 1 - lo] < best)
+				{
+					best = currCost[j - 1 - lo];
+					step = eWS_Skip;
+				}
+				currCost[j - lo] = best + cost;
+				rowSteps[j - lo] = step;
+			}
+
+			std::swap(prevCost, currCost);
+			std::fill(currCost.begin(), currCost.end(), INF);
+			prevLo = lo;
+			prevHi = hi;
+		}
+
+		// trace the path back from the end. the first sample of 'b' each row
+		// reaches is the last one visited while going backwards.
+		bIdxForA.resize(nA);
+		size_t i = nA - 1;
+		size_t j = nB - 1;
+		while (true)
+		{
+			bIdxForA[i] = j;
+			if (i == 0 && j == 0)
+			{
+				break;
+			}
+
+			switch (steps[i * bandWidth + (j - bandLo(i))])
+			{
+				case eWS_Diagonal:
+					i--;
+					j--;
+					break;
+				case eWS_Hold:
+					i--;
+					break;
+				case eWS_Skip:
+					j--;
+					break;
+			}
+		}
+		return true;
+	}
+
+	static
+	bool
+	loadOnTrackPath(
+		const gpo::TelemetrySource &tSrc,
+		std::pair<size_t, size_t> range,
+		std::vector<cv::Vec2d> &path)
+	{
+		if (range.first > range.second || range.second >= tSrc.size())
+		{
+			spdlog::error(
+				"invalid range [{},{}] for '{}' with {} samples",
+				range.first,
+				range.second,
+				tSrc.getDataSourceName(),
+				tSrc.size());
+			return false;
+		}
+
+		const auto lat = tSrc.channel<double>(gpo::eTC_CALC_ON_TRACK_LAT);
+		const auto lon = tSrc.channel<double>(gpo::eTC_CALC_ON_TRACK_LON);
+		path.resize(range.second - range.first + 1);
+		for (size_t i=0; i<path.size(); i++)
+		{
+			path[i] = cv::Vec2d(lat[range.first + i], lon[range.first + i]);
+		}
+		return true;
+	}
+
+	bool
+	warpTelemetry(
+		const gpo::TelemetrySource &srcA,
+		std::pair<size_t, size_t> rangeA,
+		const gpo::TelemetrySource &srcB,
+		std::pair<size_t, size_t> rangeB,
+		double bandRadius_sec,
+		std::vector<size_t> &bIdxForA)
+	{
+		std::vector<cv::Vec2d> pathA;
+		std::vector<cv::Vec2d> pathB;
+		if ( ! loadOnTrackPath(srcA, rangeA, pathA) || ! loadOnTrackPath(srcB, rangeB, pathB))
+		{
+			return false;
+		}
+
+		// a degree of longitude shrinks away from the equator. scale it so
+		// distances come out the same in every direction.
+		const double lonScale = std::cos(pathA.front()[0] * M_PI / 180.0);
+		for (auto *path : {&pathA, &pathB})
+		{
+			for (auto &pt : *path)
+			{
+				pt[1] *= lonScale;
+			}
+		}
+
+		const size_t bandRadius = std::ceil(bandRadius_sec * srcB.getTelemetryRate_hz());
+		if ( ! warpPaths(pathA.data(), pathA.size(), pathB.data(), pathB.size(), bandRadius, bIdxForA))
+		{
+			return false;
+		}
+		for (auto &idx : bIdxForA)
+		{
+			idx += rangeB.first;
+		}
+		return true;
+	}
+
+}
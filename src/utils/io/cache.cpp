@@ -0,0 +1,287 @@
+#include "GoProOverlay/utils/io/cache.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+#include "GoProOverlay/utils/io/gpot.h"
+
+namespace utils
+{
+namespace io
+{
+
+	static constexpr char CACHE_MAGIC[8] = {'G','P','O','C','A','C','H','E'};
+	// bump this whenever the on-disk layout or the derived calc channels change
+	static constexpr uint32_t CACHE_VERSION = 3;
+	// number of bytes hashed from the head and tail of the source file
+	static constexpr uint64_t CACHE_HASH_BLOCK_SIZE = 1024 * 1024;
+	// telemetry archive is stored at this alignment after the header
+	static constexpr uint32_t CACHE_PAYLOAD_ALIGNMENT = 64;
+	// sub directory of the user's cache dir that caches are stored in
+	static constexpr const char *CACHE_DIR_NAME = "gopro-overlay";
+
+	struct CacheHeader
+	{
+		char magic[8];
+		uint32_t version;
+
+		// offset of the telemetry archive (see utils/io/gpot.h) from the
+		// start of the file
+		uint32_t payloadOffset;
+
+		CacheKey key;
+
+		uint32_t hasVideoMeta;
+		gpo::VideoMetadata vMeta;
+	};
+
+	static
+	void
+	fnv1a(
+		uint64_t &hash,
+		const char *data,
+		size_t len)
+	{
+		for (size_t i=0; i<len; i++)
+		{
+			hash ^= static_cast<uint8_t>(data[i]);
+			hash *= 0x100000001b3ULL;
+		}
+	}
+
+	bool
+	makeCacheKey(
+		const std::filesystem::path &sourceFile,
+		CacheKey &keyOut)
+	{
+		std::error_code ec;
+		keyOut.fileSize = std::filesystem::file_size(sourceFile, ec);
+		if (ec)
+		{
+			return false;
+		}
+		auto mtime = std::filesystem::last_write_time(sourceFile, ec);
+		if (ec)
+		{
+			return false;
+		}
+		keyOut.mtime = mtime.time_since_epoch().count();
+
+		std::ifstream ifs(sourceFile, std::ios::binary);
+		if ( ! ifs.good())
+		{
+			return false;
+		}
+
+		std::vector<char> block(CACHE_HASH_BLOCK_SIZE);
+		keyOut.contentHash = 0xcbf29ce484222325ULL;
+		// head block
+		ifs.read(block.data(), block.size());
+		fnv1a(keyOut.contentHash, block.data(), ifs.gcount());
+		// tail block (skipped if it overlaps the head block)
+		if (keyOut.fileSize > CACHE_HASH_BLOCK_SIZE * 2)
+		{
+			ifs.clear();
+			ifs.seekg(keyOut.fileSize - CACHE_HASH_BLOCK_SIZE);
+			ifs.read(block.data(), block.size());
+			fnv1a(keyOut.contentHash, block.data(), ifs.gcount());
+		}
+		return true;
+	}
+
+	std::filesystem::path
+	getCacheDir()
+	{
+		const char *xdgCache = std::getenv("XDG_CACHE_HOME");
+		if (xdgCache && xdgCache[0] != '\0')
+		{
+			return std::filesystem::path(xdgCache) / CACHE_DIR_NAME;
+		}
+		const char *home = std::getenv("HOME");
+		if (home && home[0] != '\0')
+		{
+			return std::filesystem::path(home) / ".cache" / CACHE_DIR_NAME;
+		}
+		return {};
+	}
+
+	std::filesystem::path
+	getCachePath(
+		const CacheKey &key)
+	{
+		const auto cacheDir = getCacheDir();
+		if (cacheDir.empty())
+		{
+			return {};
+		}
+		return cacheDir / fmt::format("{:x}-{:x}-{:016x}.gpocache",
+			key.fileSize,
+			static_cast<uint64_t>(key.mtime),
+			key.contentHash);
+	}
+
+	bool
+	writeCache(
+		const std::filesystem::path &sourceFile,
+		const gpo::TelemetrySamplesPtr &tSamps,
+		const gpo::DataAvailableBitSet &avail,
+		const gpo::VideoMetadata *vMeta)
+	{
+		gpo::TelemetryColumns columns(*tSamps);
+		return writeCache(sourceFile, columns, avail, vMeta);
+	}
+
+	bool
+	writeCache(
+		const std::filesystem::path &sourceFile,
+		const gpo::TelemetryColumns &columns,
+		const gpo::DataAvailableBitSet &avail,
+		const gpo::VideoMetadata *vMeta)
+	{
+		CacheHeader header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+		header.version = CACHE_VERSION;
+		header.payloadOffset = (sizeof(CacheHeader) + CACHE_PAYLOAD_ALIGNMENT - 1) / CACHE_PAYLOAD_ALIGNMENT * CACHE_PAYLOAD_ALIGNMENT;
+		if ( ! makeCacheKey(sourceFile, header.key))
+		{
+			spdlog::warn("failed to build cache key for '{}'", sourceFile.c_str());
+			return false;
+		}
+		if (vMeta)
+		{
+			header.hasVideoMeta = 1;
+			header.vMeta = *vMeta;
+		}
+
+		const auto cachePath = getCachePath(header.key);
+		if (cachePath.empty())
+		{
+			return false;
+		}
+		std::error_code dirEc;
+		std::filesystem::create_directories(cachePath.parent_path(), dirEc);
+		if (dirEc)
+		{
+			// not fatal. source just won't be cached.
+			spdlog::debug("unable to create cache dir '{}'. {}",
+				cachePath.parent_path().c_str(),
+				dirEc.message());
+			return false;
+		}
+
+		// write to a temporary file first so that a crash mid-write can't
+		// leave behind a truncated cache that looks valid.
+		auto tmpPath = cachePath;
+		tmpPath += ".tmp";
+		{
+			std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+			if ( ! ofs.good())
+			{
+				// not fatal. source just won't be cached.
+				spdlog::debug("unable to open '{}' for writing", tmpPath.c_str());
+				return false;
+			}
+			const char PADDING[CACHE_PAYLOAD_ALIGNMENT] = {};
+			ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+			ofs.write(PADDING, header.payloadOffset - sizeof(header));
+			if ( ! writeTelemetryToArchive(columns, avail, ofs))
+			{
+				spdlog::warn("failed to write cache '{}'", tmpPath.c_str());
+				ofs.close();
+				std::error_code ec;
+				std::filesystem::remove(tmpPath, ec);
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(tmpPath, cachePath, ec);
+		if (ec)
+		{
+			spdlog::warn("failed to move cache into place. {}", ec.message());
+			std::filesystem::remove(tmpPath, ec);
+			return false;
+		}
+		return true;
+	}
+
+	bool
+	readCache(
+		const std::filesystem::path &sourceFile,
+		gpo::TelemetrySamplesPtr tSamps,
+		gpo::DataAvailableBitSet &avail,
+		gpo::VideoMetadata *vMeta)
+	{
+		gpo::TelemetryColumns columns;
+		if ( ! readCache(sourceFile, columns, avail, vMeta))
+		{
+			return false;
+		}
+		columns.toSamples(*tSamps);
+		return true;
+	}
+
+	bool
+	readCache(
+		const std::filesystem::path &sourceFile,
+		gpo::TelemetryColumns &columns,
+		gpo::DataAvailableBitSet &avail,
+		gpo::VideoMetadata *vMeta)
+	{
+		CacheKey currKey;
+		if ( ! makeCacheKey(sourceFile, currKey))
+		{
+			return false;
+		}
+		const auto cachePath = getCachePath(currKey);
+		if (cachePath.empty())
+		{
+			return false;
+		}
+		std::ifstream ifs(cachePath, std::ios::binary);
+		if ( ! ifs.good())
+		{
+			return false;
+		}
+
+		CacheHeader header;
+		ifs.read(reinterpret_cast<char *>(&header), sizeof(header));
+		if ( ! ifs.good() ||
+			std::memcmp(header.magic, CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+			header.version != CACHE_VERSION)
+		{
+			spdlog::debug("ignoring incompatible cache '{}'", cachePath.c_str());
+			return false;
+		}
+		else if (vMeta && ! header.hasVideoMeta)
+		{
+			// caller needs video metadata but cache was built without it
+			return false;
+		}
+
+		if (currKey.fileSize != header.key.fileSize ||
+			currKey.mtime != header.key.mtime ||
+			currKey.contentHash != header.key.contentHash)
+		{
+			spdlog::debug("cache '{}' is stale", cachePath.c_str());
+			return false;
+		}
+
+		// telemetry gets paged in from the archive as it's read
+		if ( ! readTelemetryFromBinary(cachePath, columns, avail, header.payloadOffset))
+		{
+			spdlog::warn("cache '{}' is corrupt", cachePath.c_str());
+			return false;
+		}
+		if (vMeta)
+		{
+			*vMeta = header.vMeta;
+		}
+		return true;
+	}
+
+}
+}
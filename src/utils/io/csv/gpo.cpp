@@ -44,6 +44,7 @@ namespace io
 	static constexpr CSV_ColumnParser CSVPARSER_CALC_SMOOTH_ACCL_Z = MAKE_PARSER(gpo::TelemetrySample, calcSamp.smoothAccl.z, "smoothAccl_z");
 	static constexpr CSV_ColumnParser CSVPARSER_CALC_VEHI_ACCL_LAT = MAKE_PARSER(gpo::TelemetrySample, calcSamp.vehiAccl.lat_g, "vehiAcclLat");
 	static constexpr CSV_ColumnParser CSVPARSER_CALC_VEHI_ACCL_LON = MAKE_PARSER(gpo::TelemetrySample, calcSamp.vehiAccl.lon_g, "vehiAcclLon");
+	static constexpr CSV_ColumnParser CSVPARSER_CALC_TRACK_DISTANCE = MAKE_PARSER(gpo::TelemetrySample, calcSamp.trackDistance_m, "trackDistance");
 
 	bool
     writeTelemetryToCSV(
@@ -155,6 +156,10 @@ namespace io
 			columns.push_back(CSVPARSER_CALC_VEHI_ACCL_LAT);
 			columns.push_back(CSVPARSER_CALC_VEHI_ACCL_LON);
 		}
+		if (avail.test(gpo::eDA_CALC_TRACK_DISTANCE))
+		{
+			columns.push_back(CSVPARSER_CALC_TRACK_DISTANCE);
+		}
 
 		std::vector<std::string> headings;
 		headings.reserve(columns.size());
@@ -379,6 +384,11 @@ namespace io
 				columns.push_back(CSVPARSER_CALC_VEHI_ACCL_LON);
 				avail.set(gpo::eDA_CALC_VEHI_ACCL);
 			}
+			else if (colName == CSVPARSER_CALC_TRACK_DISTANCE.columnTitle)
+			{
+				columns.push_back(CSVPARSER_CALC_TRACK_DISTANCE);
+				avail.set(gpo::eDA_CALC_TRACK_DISTANCE);
+			}
 			else
 			{
 				throw std::runtime_error("unexpected CSV column name '" + colName + "'");
@@ -0,0 +1,740 @@
+#include "GoProOverlay/utils/io/gpot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <spdlog/spdlog.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "GoProOverlay/utils/io/csv.h"
+
+namespace utils
+{
+namespace io
+{
+
+	static constexpr char GPOT_MAGIC[8] = {'G','P','O','T','E','L','E','M'};
+	static constexpr char GPOZ_MAGIC[8] = {'G','P','O','Z','E','L','E','M'};
+	// bump this whenever the on-disk layout or set of channels changes
+	static constexpr uint32_t GPOT_VERSION = 2;
+	static constexpr uint32_t GPOZ_VERSION = 2;
+	// oldest versions that can still be read. channels are looked up by
+	// name, so older files just load without the channels added since.
+	//  v2 - added the 'trackDistance' channel
+	static constexpr uint32_t GPOT_MIN_VERSION = 1;
+	static constexpr uint32_t GPOZ_MIN_VERSION = 1;
+	// channel payloads are aligned to this many bytes within the file
+	static constexpr uint64_t GPOT_PAYLOAD_ALIGNMENT = 64;
+	static constexpr uint32_t GPOT_FLAG_COMPACT = 0x1;
+	static constexpr size_t AVAIL_WORDS = gpo::DataAvailableBitSet().size() / 64;
+
+	struct GpotHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t flags;
+		uint64_t nSamples;
+		uint64_t avail[AVAIL_WORDS];
+
+		// number of GpotChannelEntry that directly follow the header
+		uint32_t nChannels;
+		uint32_t reserved;
+	};
+
+	struct GpotChannelEntry
+	{
+		// matches ChannelDescriptor::name. channels are looked up by name so
+		// that reordering/adding channels doesn't break older files.
+		char name[32];
+		uint32_t type;
+		uint32_t encoding;
+		double scale;
+
+		// location of the channel's values relative to the start of file
+		uint64_t offset;
+		uint64_t nBytes;
+	};
+
+	// transform applied to a block's values before it's compressed
+	enum BlockTransform_E : uint32_t
+	{
+		eBT_DELTA = 0,
+		eBT_XOR = 1
+	};
+
+	struct GpozChannelEntry
+	{
+		char name[32];
+		uint32_t type;
+		uint32_t encoding;
+		double scale;
+		uint32_t transform;
+		uint32_t reserved;
+
+		// location of the channel's GpozBlockEntry table
+		uint64_t blockTableOffset;
+	};
+
+	struct GpozBlockEntry
+	{
+		uint64_t offset;
+		uint32_t compressedBytes;
+		uint32_t rawBytes;
+	};
+
+	static
+	uint64_t
+	alignUp(
+		uint64_t value,
+		uint64_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	static
+	std::string
+	lowerExtension(
+		const std::filesystem::path &filepath)
+	{
+		std::string fileExt = filepath.extension();
+		std::transform(
+			fileExt.begin(),
+			fileExt.end(),
+			fileExt.begin(),
+			[](unsigned char c){ return std::tolower(c); });
+		return fileExt;
+	}
+
+	static
+	GpotHeader
+	makeHeader(
+		const char magic[8],
+		uint32_t version,
+		const gpo::TelemetryColumns &columns,
+		const gpo::DataAvailableBitSet &avail)
+	{
+		GpotHeader header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, magic, sizeof(header.magic));
+		header.version = version;
+		header.flags = (columns.isCompact() ? GPOT_FLAG_COMPACT : 0);
+		header.nSamples = columns.size();
+		for (size_t i=0; i<avail.size(); i++)
+		{
+			if (avail.test(i))
+			{
+				header.avail[i / 64] |= (1ULL << (i % 64));
+			}
+		}
+		return header;
+	}
+
+	static
+	size_t
+	chunkCountFor(
+		uint64_t nSamples)
+	{
+		return (nSamples + gpo::TELEM_CHUNK_SIZE - 1) >> gpo::TELEM_CHUNK_SHIFT;
+	}
+
+	/**
+	 * @return
+	 * descriptor for the channel with the given CSV name, or nullptr if
+	 * no such channel exists
+	 */
+	static
+	const gpo::ChannelDescriptor *
+	findChannel(
+		const char *name)
+	{
+		for (const auto &desc : gpo::getChannelDescriptors())
+		{
+			if (std::strcmp(desc.name, name) == 0)
+			{
+				return &desc;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Delta/XOR encodes each value against the previous one, then byte
+	 * shuffles the result so that byte 'b' of value 'i' lands at
+	 * dst[b * nValues + i]. Slowly changing channels end up with long runs
+	 * of zero bytes, which deflate handles very well.
+	 */
+	template <typename U>
+	static
+	void
+	encodeBlock(
+		const uint8_t *src,
+		uint8_t *dst,
+		size_t nValues,
+		BlockTransform_E transform)
+	{
+		U prev = 0;
+		for (size_t i=0; i<nValues; i++)
+		{
+			U value;
+			std::memcpy(&value, src + i * sizeof(U), sizeof(U));
+			const U coded = (transform == eBT_XOR ? U(value ^ prev) : U(value - prev));
+			prev = value;
+			for (size_t b=0; b<sizeof(U); b++)
+			{
+				dst[b * nValues + i] = static_cast<uint8_t>(coded >> (8 * b));
+			}
+		}
+	}
+
+	// inverse of encodeBlock()
+	template <typename U>
+	static
+	void
+	decodeBlock(
+		const uint8_t *src,
+		uint8_t *dst,
+		size_t nValues,
+		BlockTransform_E transform)
+	{
+		U prev = 0;
+		for (size_t i=0; i<nValues; i++)
+		{
+			U coded = 0;
+			for (size_t b=0; b<sizeof(U); b++)
+			{
+				coded |= static_cast<U>(static_cast<U>(src[b * nValues + i]) << (8 * b));
+			}
+			const U value = (transform == eBT_XOR ? U(coded ^ prev) : U(coded + prev));
+			prev = value;
+			std::memcpy(dst + i * sizeof(U), &value, sizeof(U));
+		}
+	}
+
+	/**
+	 * Applies encodeBlock() or decodeBlock() based on the value size.
+	 *
+	 * @return
+	 * false if values of 'elemSize' bytes aren't supported
+	 */
+	static
+	bool
+	transformBlock(
+		bool encode,
+		const uint8_t *src,
+		uint8_t *dst,
+		size_t nBytes,
+		size_t elemSize,
+		BlockTransform_E transform)
+	{
+		const size_t nValues = nBytes / elemSize;
+		switch (elemSize)
+		{
+			case sizeof(uint16_t):
+				encode ?
+					encodeBlock<uint16_t>(src, dst, nValues, transform) :
+					decodeBlock<uint16_t>(src, dst, nValues, transform);
+				return true;
+			case sizeof(uint32_t):
+				encode ?
+					encodeBlock<uint32_t>(src, dst, nValues, transform) :
+					decodeBlock<uint32_t>(src, dst, nValues, transform);
+				return true;
+			case sizeof(uint64_t):
+				encode ?
+					encodeBlock<uint64_t>(src, dst, nValues, transform) :
+					decodeBlock<uint64_t>(src, dst, nValues, transform);
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	static
+	BlockTransform_E
+	blockTransformFor(
+		const gpo::ChannelDescriptor &desc,
+		gpo::ChannelEncoding_E encoding)
+	{
+		// quantized values are integers regardless of the field's type
+		if (desc.type == gpo::eCT_INT || encoding == gpo::eCE_FIXED16)
+		{
+			return eBT_DELTA;
+		}
+		return eBT_XOR;
+	}
+
+	bool
+	writeTelemetryToBinary(
+		const gpo::TelemetryColumns &columns,
+		const gpo::DataAvailableBitSet &avail,
+		const std::filesystem::path &binFilepath)
+	{
+		GpotHeader header = makeHeader(GPOT_MAGIC, GPOT_VERSION, columns, avail);
+
+		// build the channel directory
+		std::vector<GpotChannelEntry> directory;
+		for (const auto &desc : gpo::getChannelDescriptors())
+		{
+			const auto encoding = columns.getEncoding(desc.channel);
+			if (encoding == gpo::eCE_ABSENT)
+			{
+				continue;
+			}
+
+			GpotChannelEntry entry;
+			std::memset(&entry, 0, sizeof(entry));
+			std::strncpy(entry.name, desc.name, sizeof(entry.name) - 1);
+			entry.type = desc.type;
+			entry.encoding = encoding;
+			entry.scale = desc.compactScale;
+			entry.nBytes = columns.size() * gpo::getEncodedSize(desc, encoding);
+			directory.push_back(entry);
+		}
+		header.nChannels = directory.size();
+
+		uint64_t offset = sizeof(GpotHeader) + directory.size() * sizeof(GpotChannelEntry);
+		for (auto &entry : directory)
+		{
+			offset = alignUp(offset, GPOT_PAYLOAD_ALIGNMENT);
+			entry.offset = offset;
+			offset += entry.nBytes;
+		}
+
+		std::ofstream ofs(binFilepath, std::ios::binary | std::ios::trunc);
+		if ( ! ofs.good())
+		{
+			spdlog::error("unable to open '{}' for writing", binFilepath.c_str());
+			return false;
+		}
+		ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		ofs.write(
+			reinterpret_cast<const char *>(directory.data()),
+			directory.size() * sizeof(GpotChannelEntry));
+
+		const size_t nChunks = chunkCountFor(columns.size());
+		const char PADDING[GPOT_PAYLOAD_ALIGNMENT] = {};
+		uint64_t filePos = sizeof(GpotHeader) + directory.size() * sizeof(GpotChannelEntry);
+		size_t entryIdx = 0;
+		for (const auto &desc : gpo::getChannelDescriptors())
+		{
+			if (columns.getEncoding(desc.channel) == gpo::eCE_ABSENT)
+			{
+				continue;
+			}
+
+			const auto &entry = directory.at(entryIdx++);
+			ofs.write(PADDING, entry.offset - filePos);
+			for (size_t c=0; c<nChunks; c++)
+			{
+				const auto &chunk = columns.getChunk(desc.channel, c);
+				gpo::TelemetryChunkPin pin;
+				ofs.write(reinterpret_cast<const char *>(chunk->data(pin)), chunk->size());
+			}
+			filePos = entry.offset + entry.nBytes;
+		}
+
+		if ( ! ofs.good())
+		{
+			spdlog::error("failed to write '{}'", binFilepath.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	bool
+	writeTelemetryToArchive(
+		const gpo::TelemetryColumns &columns,
+		const gpo::DataAvailableBitSet &avail,
+		const std::filesystem::path &archiveFilepath)
+	{
+		std::ofstream ofs(archiveFilepath, std::ios::binary | std::ios::trunc);
+		if ( ! ofs.good())
+		{
+			spdlog::error("unable to open '{}' for writing", archiveFilepath.c_str());
+			return false;
+		}
+		else if ( ! writeTelemetryToArchive(columns, avail, ofs))
+		{
+			spdlog::error("failed to write '{}'", archiveFilepath.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	bool
+	writeTelemetryToArchive(
+		const gpo::TelemetryColumns &columns,
+		const gpo::DataAvailableBitSet &avail,
+		std::ostream &out)
+	{
+		GpotHeader header = makeHeader(GPOZ_MAGIC, GPOZ_VERSION, columns, avail);
+		const size_t nBlocks = chunkCountFor(columns.size());
+
+		// compress every block up front so that we know the file's layout
+		std::vector<GpozChannelEntry> directory;
+		std::vector<gpo::TelemetryChannel_E> channels;
+		std::vector<std::vector<std::vector<uint8_t>>> blocks;
+		std::vector<uint8_t> shuffled;
+		for (const auto &desc : gpo::getChannelDescriptors())
+		{
+			const auto encoding = columns.getEncoding(desc.channel);
+			if (encoding == gpo::eCE_ABSENT)
+			{
+				continue;
+			}
+
+			GpozChannelEntry entry;
+			std::memset(&entry, 0, sizeof(entry));
+			std::strncpy(entry.name, desc.name, sizeof(entry.name) - 1);
+			entry.type = desc.type;
+			entry.encoding = encoding;
+			entry.scale = desc.compactScale;
+			entry.transform = blockTransformFor(desc, encoding);
+			directory.push_back(entry);
+			channels.push_back(desc.channel);
+
+			const size_t elemSize = gpo::getEncodedSize(desc, encoding);
+			auto &channelBlocks = blocks.emplace_back(nBlocks);
+			for (size_t c=0; c<nBlocks; c++)
+			{
+				const auto &chunk = columns.getChunk(desc.channel, c);
+				gpo::TelemetryChunkPin pin;
+				shuffled.resize(chunk->size());
+				if ( ! transformBlock(
+					true,
+					chunk->data(pin),
+					shuffled.data(),
+					chunk->size(),
+					elemSize,
+					static_cast<BlockTransform_E>(entry.transform)))
+				{
+					spdlog::error("unsupported value size ({}) for channel '{}'", elemSize, desc.name);
+					return false;
+				}
+
+				auto &compressed = channelBlocks[c];
+				uLongf compressedSize = compressBound(shuffled.size());
+				compressed.resize(compressedSize);
+				if (compress2(
+						compressed.data(),
+						&compressedSize,
+						shuffled.data(),
+						shuffled.size(),
+						Z_BEST_COMPRESSION) != Z_OK)
+				{
+					spdlog::error("failed to compress channel '{}'", desc.name);
+					return false;
+				}
+				compressed.resize(compressedSize);
+			}
+		}
+		header.nChannels = directory.size();
+
+		// layout is header, directory, then each channel's block table and blocks
+		std::vector<std::vector<GpozBlockEntry>> blockTables(directory.size());
+		uint64_t offset = sizeof(GpotHeader) + directory.size() * sizeof(GpozChannelEntry);
+		for (size_t e=0; e<directory.size(); e++)
+		{
+			directory[e].blockTableOffset = offset;
+			offset += nBlocks * sizeof(GpozBlockEntry);
+			for (size_t c=0; c<nBlocks; c++)
+			{
+				const uint32_t rawBytes = columns.getChunk(channels[e], c)->size();
+				const uint32_t compressedBytes = blocks[e][c].size();
+				blockTables[e].push_back({offset, compressedBytes, rawBytes});
+				offset += compressedBytes;
+			}
+		}
+
+		out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		out.write(
+			reinterpret_cast<const char *>(directory.data()),
+			directory.size() * sizeof(GpozChannelEntry));
+		for (size_t e=0; e<directory.size(); e++)
+		{
+			out.write(
+				reinterpret_cast<const char *>(blockTables[e].data()),
+				blockTables[e].size() * sizeof(GpozBlockEntry));
+			for (const auto &compressed : blocks[e])
+			{
+				out.write(reinterpret_cast<const char *>(compressed.data()), compressed.size());
+			}
+		}
+		return out.good();
+	}
+
+	static
+	bool
+	readMappedBinary(
+		const std::filesystem::path &binFilepath,
+		const std::shared_ptr<const void> &mapping,
+		size_t fileSize,
+		const GpotHeader &header,
+		gpo::TelemetryColumns &columns)
+	{
+		const auto *fileBytes = static_cast<const uint8_t *>(mapping.get());
+		const auto *directory = reinterpret_cast<const GpotChannelEntry *>(fileBytes + sizeof(GpotHeader));
+		for (size_t e=0; e<header.nChannels; e++)
+		{
+			GpotChannelEntry entry;
+			std::memcpy(&entry, &directory[e], sizeof(entry));
+			entry.name[sizeof(entry.name) - 1] = '\0';
+
+			const auto *desc = findChannel(entry.name);
+			if ( ! desc)
+			{
+				spdlog::warn("ignoring unknown channel '{}' in '{}'", entry.name, binFilepath.c_str());
+				continue;
+			}
+
+			const auto encoding = static_cast<gpo::ChannelEncoding_E>(entry.encoding);
+			const size_t elemSize = gpo::getEncodedSize(*desc, encoding);
+			if (entry.type != static_cast<uint32_t>(desc->type) ||
+				entry.scale != desc->compactScale ||
+				entry.nBytes != header.nSamples * elemSize ||
+				entry.offset % GPOT_PAYLOAD_ALIGNMENT != 0 ||
+				entry.offset + entry.nBytes > fileSize)
+			{
+				spdlog::error("channel '{}' in '{}' is incompatible or corrupt", entry.name, binFilepath.c_str());
+				return false;
+			}
+
+			// point chunks directly into the mapped file
+			std::vector<gpo::TelemetryChunkPtr> chunks;
+			for (uint64_t sampIdx=0; sampIdx<header.nSamples; sampIdx+=gpo::TELEM_CHUNK_SIZE)
+			{
+				const size_t nInChunk = std::min<uint64_t>(gpo::TELEM_CHUNK_SIZE, header.nSamples - sampIdx);
+				chunks.push_back(std::make_shared<gpo::TelemetryChunk>(
+					fileBytes + entry.offset + sampIdx * elemSize,
+					nInChunk * elemSize,
+					mapping));
+			}
+			columns.setChannelChunks(desc->channel, encoding, std::move(chunks));
+		}
+		return true;
+	}
+
+	static
+	bool
+	readMappedArchive(
+		const std::filesystem::path &archiveFilepath,
+		const std::shared_ptr<const void> &mapping,
+		size_t fileSize,
+		const GpotHeader &header,
+		gpo::TelemetryColumns &columns)
+	{
+		const auto *fileBytes = static_cast<const uint8_t *>(mapping.get());
+		const auto *directory = reinterpret_cast<const GpozChannelEntry *>(fileBytes + sizeof(GpotHeader));
+		const size_t nBlocks = chunkCountFor(header.nSamples);
+		for (size_t e=0; e<header.nChannels; e++)
+		{
+			GpozChannelEntry entry;
+			std::memcpy(&entry, &directory[e], sizeof(entry));
+			entry.name[sizeof(entry.name) - 1] = '\0';
+
+			const auto *desc = findChannel(entry.name);
+			if ( ! desc)
+			{
+				spdlog::warn("ignoring unknown channel '{}' in '{}'", entry.name, archiveFilepath.c_str());
+				continue;
+			}
+
+			const auto encoding = static_cast<gpo::ChannelEncoding_E>(entry.encoding);
+			const auto transform = static_cast<BlockTransform_E>(entry.transform);
+			const size_t elemSize = gpo::getEncodedSize(*desc, encoding);
+			if (entry.type != static_cast<uint32_t>(desc->type) ||
+				entry.scale != desc->compactScale ||
+				(transform != eBT_DELTA && transform != eBT_XOR) ||
+				entry.blockTableOffset + nBlocks * sizeof(GpozBlockEntry) > fileSize)
+			{
+				spdlog::error("channel '{}' in '{}' is incompatible or corrupt", entry.name, archiveFilepath.c_str());
+				return false;
+			}
+
+			const auto *blockTable = reinterpret_cast<const GpozBlockEntry *>(fileBytes + entry.blockTableOffset);
+			std::vector<gpo::TelemetryChunkPtr> chunks;
+			for (size_t c=0; c<nBlocks; c++)
+			{
+				GpozBlockEntry block;
+				std::memcpy(&block, &blockTable[c], sizeof(block));
+				const size_t nInChunk = std::min<uint64_t>(gpo::TELEM_CHUNK_SIZE, header.nSamples - c * gpo::TELEM_CHUNK_SIZE);
+				if (block.rawBytes != nInChunk * elemSize ||
+					block.offset + block.compressedBytes > fileSize)
+				{
+					spdlog::error("block {} of channel '{}' in '{}' is corrupt", c, entry.name, archiveFilepath.c_str());
+					return false;
+				}
+
+				// blocks get decompressed the first time they're read
+				const uint8_t *compressed = fileBytes + block.offset;
+				const size_t compressedBytes = block.compressedBytes;
+				chunks.push_back(std::make_shared<gpo::TelemetryChunk>(
+					block.rawBytes,
+					[mapping, compressed, compressedBytes, elemSize, transform](uint8_t *dst, size_t nBytes){
+						std::vector<uint8_t> shuffled(nBytes);
+						uLongf rawSize = nBytes;
+						if (uncompress(shuffled.data(), &rawSize, compressed, compressedBytes) != Z_OK ||
+							rawSize != nBytes)
+						{
+							return false;
+						}
+						return transformBlock(false, shuffled.data(), dst, nBytes, elemSize, transform);
+					}));
+			}
+			columns.setChannelChunks(desc->channel, encoding, std::move(chunks));
+		}
+		return true;
+	}
+
+	bool
+	readTelemetryFromBinary(
+		const std::filesystem::path &binFilepath,
+		gpo::TelemetryColumns &columns,
+		gpo::DataAvailableBitSet &avail,
+		uint64_t payloadOffset)
+	{
+		if (payloadOffset % GPOT_PAYLOAD_ALIGNMENT != 0)
+		{
+			spdlog::error("telemetry payload offset ({}) must be {} byte aligned", payloadOffset, GPOT_PAYLOAD_ALIGNMENT);
+			return false;
+		}
+
+		int fd = open(binFilepath.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			spdlog::error("unable to open '{}'", binFilepath.c_str());
+			return false;
+		}
+		struct stat st;
+		if (fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < payloadOffset + sizeof(GpotHeader))
+		{
+			spdlog::error("'{}' is too small to be a telemetry file", binFilepath.c_str());
+			close(fd);
+			return false;
+		}
+
+		const size_t mappedSize = st.st_size;
+		void *mapped = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		// the mapping holds its own reference to the file
+		close(fd);
+		if (mapped == MAP_FAILED)
+		{
+			spdlog::error("failed to mmap '{}'. {}", binFilepath.c_str(), std::strerror(errno));
+			return false;
+		}
+		// unmapped once the last chunk referencing it is released
+		std::shared_ptr<const void> fileMapping(mapped, [mappedSize](const void *addr){
+			munmap(const_cast<void *>(addr), mappedSize);
+		});
+		// from here on, all offsets are relative to the telemetry payload
+		std::shared_ptr<const void> mapping(
+			fileMapping,
+			static_cast<const uint8_t *>(mapped) + payloadOffset);
+		const size_t fileSize = mappedSize - payloadOffset;
+		const auto *fileBytes = static_cast<const uint8_t *>(mapping.get());
+
+		GpotHeader header;
+		std::memcpy(&header, fileBytes, sizeof(header));
+		const bool isBinary = std::memcmp(header.magic, GPOT_MAGIC, sizeof(header.magic)) == 0;
+		const bool isArchive = std::memcmp(header.magic, GPOZ_MAGIC, sizeof(header.magic)) == 0;
+		const bool binaryVersionOkay = GPOT_MIN_VERSION <= header.version && header.version <= GPOT_VERSION;
+		const bool archiveVersionOkay = GPOZ_MIN_VERSION <= header.version && header.version <= GPOZ_VERSION;
+		if ( ! (isBinary && binaryVersionOkay) &&
+			! (isArchive && archiveVersionOkay))
+		{
+			spdlog::error("'{}' isn't a supported telemetry file", binFilepath.c_str());
+			return false;
+		}
+		const size_t entrySize = (isBinary ? sizeof(GpotChannelEntry) : sizeof(GpozChannelEntry));
+		const uint64_t directoryEnd = sizeof(GpotHeader) + header.nChannels * entrySize;
+		if (directoryEnd > fileSize)
+		{
+			spdlog::error("'{}' has a truncated channel directory", binFilepath.c_str());
+			return false;
+		}
+
+		avail.reset();
+		for (size_t i=0; i<avail.size(); i++)
+		{
+			avail.set(i, (header.avail[i / 64] >> (i % 64)) & 0x1);
+		}
+		if (header.version < 2)
+		{
+			// track distance is left out and stays unavailable until it's
+			// computed along with the track times (ie. setting a datum track)
+			avail.reset(gpo::eDA_CALC_TRACK_DISTANCE);
+		}
+		columns.resetLayout(header.nSamples, header.flags & GPOT_FLAG_COMPACT, avail);
+
+		if (isBinary)
+		{
+			return readMappedBinary(binFilepath, mapping, fileSize, header, columns);
+		}
+		return readMappedArchive(binFilepath, mapping, fileSize, header, columns);
+	}
+
+	bool
+	convertTelemetryFile(
+		const std::filesystem::path &inFilepath,
+		const std::filesystem::path &outFilepath)
+	{
+		const auto inExt = lowerExtension(inFilepath);
+		const auto outExt = lowerExtension(outFilepath);
+
+		gpo::TelemetryColumns columns;
+		gpo::DataAvailableBitSet avail;
+		if (inExt == ".csv")
+		{
+			auto samples = std::make_shared<gpo::TelemetrySamples>();
+			if ( ! readTelemetryFromCSV(inFilepath, samples, avail))
+			{
+				return false;
+			}
+			columns.assign(*samples);
+		}
+		else if (inExt == GPOT_FILE_EXTENSION || inExt == GPOZ_FILE_EXTENSION)
+		{
+			if ( ! readTelemetryFromBinary(inFilepath, columns, avail))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			spdlog::error(
+				"unsupported input extension '{}'. expected .csv, {}, or {}",
+				inExt,
+				GPOT_FILE_EXTENSION,
+				GPOZ_FILE_EXTENSION);
+			return false;
+		}
+
+		if (outExt == ".csv")
+		{
+			auto samples = std::make_shared<gpo::TelemetrySamples>();
+			columns.toSamples(*samples);
+			return writeTelemetryToCSV(samples, outFilepath, avail);
+		}
+		else if (outExt == GPOT_FILE_EXTENSION)
+		{
+			return writeTelemetryToBinary(columns, avail, outFilepath);
+		}
+		else if (outExt == GPOZ_FILE_EXTENSION)
+		{
+			return writeTelemetryToArchive(columns, avail, outFilepath);
+		}
+
+		spdlog::error(
+			"unsupported output extension '{}'. expected .csv, {}, or {}",
+			outExt,
+			GPOT_FILE_EXTENSION,
+			GPOZ_FILE_EXTENSION);
+		return false;
+	}
+
+}
+}
@@ -1,6 +1,10 @@
 #include "DataProcessingUtilsTest.h"
 
 #include "GoProOverlay/utils/DataProcessingUtils.h"
+#include "GoProOverlay/utils/SignalAlignment.h"
+#include "GoProOverlay/utils/TimeWarping.h"
+#include "GoProOverlay/utils/SignalFilters.h"
+#include "GoProOverlay/utils/StreamingResampler.h"
 
 DataProcessingUtilsTest::DataProcessingUtilsTest()
 {
@@ -101,6 +105,227 @@ DataProcessingUtilsTest::trackTimes()
 	}
 }
 
+void
+DataProcessingUtilsTest::trackTimesIncremental()
+{
+	// a few laps around a circle. the path follows every lap like it
+	// would for a track made from telemetry.
+	const size_t SAMPS_PER_LAP = 200;
+	const size_t N_LAPS = 5;
+	const size_t N_SAMPS = SAMPS_PER_LAP * N_LAPS;
+	std::vector<cv::Vec2d> path;
+	gpo::TelemetrySamples tSamps(N_SAMPS);
+	for (size_t i=0; i<N_SAMPS; i++)
+	{
+		const double theta = 2.0 * M_PI * i / SAMPS_PER_LAP;
+		path.push_back(cv::Vec2d(0.001 * std::cos(theta), 0.001 * std::sin(theta)));
+
+		auto &samp = tSamps.at(i);
+		samp.t_offset = 0.1 * i;
+		samp.gpSamp.gps.coord.lat = path.back()[0];
+		samp.gpSamp.gps.coord.lon = path.back()[1];
+		samp.gpSamp.gps.speed2D = 10.0;
+	}
+
+	auto track = std::make_shared<gpo::Track>(path);
+	track->setStart(5);
+	track->setFinish(195);
+	track->addSector("Sector1",20,60);
+	track->addSector("Sector2",100,150);
+	track->applyModifications();
+
+	gpo::DataAvailableBitSet avail;
+	avail.set(gpo::eDA_GOPRO_GPS_LATLON);
+	avail.set(gpo::eDA_GOPRO_GPS_SPEED2D);
+	gpo::TelemetryColumns columns(tSamps);
+	gpo::DataAvailableBitSet columnsAvail = avail;
+	utils::TrackTimesCache cache;
+
+	// compares the incremental results against a run from scratch
+	auto checkAgainstFullRun = [&]()
+	{
+		track->applyModifications(true);
+		CPPUNIT_ASSERT_EQUAL(true, utils::computeTrackTimes(track,columns,columnsAvail,cache));
+
+		gpo::TelemetryColumns fullColumns(tSamps);
+		gpo::DataAvailableBitSet fullAvail = avail;
+		utils::TrackTimesCache fullCache;
+		CPPUNIT_ASSERT_EQUAL(true, utils::computeTrackTimes(track,fullColumns,fullAvail,fullCache));
+
+		CPPUNIT_ASSERT(fullAvail == columnsAvail);
+		const auto laps = columns.channel<int>(gpo::eTC_CALC_LAP);
+		const auto fullLaps = fullColumns.channel<int>(gpo::eTC_CALC_LAP);
+		const auto lapTimes = columns.channel<double>(gpo::eTC_CALC_LAP_TIME_OFFSET);
+		const auto fullLapTimes = fullColumns.channel<double>(gpo::eTC_CALC_LAP_TIME_OFFSET);
+		const auto sectors = columns.channel<int>(gpo::eTC_CALC_SECTOR);
+		const auto fullSectors = fullColumns.channel<int>(gpo::eTC_CALC_SECTOR);
+		const auto sectorTimes = columns.channel<double>(gpo::eTC_CALC_SECTOR_TIME_OFFSET);
+		const auto fullSectorTimes = fullColumns.channel<double>(gpo::eTC_CALC_SECTOR_TIME_OFFSET);
+		const auto distances = columns.channel<double>(gpo::eTC_CALC_TRACK_DISTANCE);
+		const auto fullDistances = fullColumns.channel<double>(gpo::eTC_CALC_TRACK_DISTANCE);
+		for (size_t i=0; i<N_SAMPS; i++)
+		{
+			CPPUNIT_ASSERT_EQUAL(fullDistances[i], distances[i]);
+			CPPUNIT_ASSERT_EQUAL(fullLaps[i], laps[i]);
+			CPPUNIT_ASSERT_EQUAL(fullSectors[i], sectors[i]);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(fullLapTimes[i], lapTimes[i], 0.000001);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(fullSectorTimes[i], sectorTimes[i], 0.000001);
+		}
+	};
+
+	CPPUNIT_ASSERT_EQUAL(true, utils::computeTrackTimes(track,columns,columnsAvail,cache));
+	CPPUNIT_ASSERT_EQUAL(N_SAMPS, cache.onTrackIdx.size());
+	CPPUNIT_ASSERT_EQUAL(1, columns.channel<int>(gpo::eTC_CALC_LAP)[10]);
+	CPPUNIT_ASSERT_EQUAL(-1, columns.channel<int>(gpo::eTC_CALC_LAP)[SAMPS_PER_LAP - 2]);// after finish
+
+	// edits late in the lap resume from a checkpoint in the first lap
+	track->setFinish(190);
+	checkAgainstFullRun();
+	CPPUNIT_ASSERT(cache.checkpoints.size() > 1);
+
+	track->removeSector(1);
+	checkAgainstFullRun();
+
+	track->addSector("Sector2b",120,170);
+	checkAgainstFullRun();
+
+	// edits ahead of everything start over
+	track->setStart(2);
+	checkAgainstFullRun();
+
+	// no edits at all
+	checkAgainstFullRun();
+
+	// the on-track projections are recomputed if the path might have changed
+	track->markObjectModified();
+	checkAgainstFullRun();
+}
+
+void
+DataProcessingUtilsTest::trackDistance()
+{
+	// laps around a circle ~111m in radius, with a stop partway through.
+	// the path follows every lap like it would for a track made from
+	// telemetry.
+	const size_t SAMPS_PER_LAP = 200;
+	const size_t N_LAPS = 3;
+	const size_t STOP_IDX = 250;
+	const size_t STOP_LENGTH = 20;
+	const size_t N_SAMPS = SAMPS_PER_LAP * N_LAPS + STOP_LENGTH;
+	const double RADIUS_DEG = 0.001;
+	const double LAP_LENGTH_M = 2.0 * M_PI * RADIUS_DEG * (M_PI / 180.0) * 6371000.0;
+	std::vector<cv::Vec2d> path;
+	for (size_t i=0; i<(SAMPS_PER_LAP * N_LAPS); i++)
+	{
+		const double theta = 2.0 * M_PI * i / SAMPS_PER_LAP;
+		path.push_back(cv::Vec2d(RADIUS_DEG * std::cos(theta), RADIUS_DEG * std::sin(theta)));
+	}
+	auto tSamps = gpo::TelemetrySamplesPtr(new gpo::TelemetrySamples(N_SAMPS));
+	size_t pathIdx = 0;
+	for (size_t i=0; i<N_SAMPS; i++)
+	{
+		auto &samp = tSamps->at(i);
+		samp.t_offset = 0.1 * i;
+		samp.gpSamp.gps.coord.lat = path[pathIdx][0];
+		samp.gpSamp.gps.coord.lon = path[pathIdx][1];
+		if (i < STOP_IDX || i >= (STOP_IDX + STOP_LENGTH))
+		{
+			samp.gpSamp.gps.speed2D = 10.0;
+			pathIdx++;
+		}
+	}
+
+	auto track = std::make_shared<gpo::Track>(path);
+	track->setStart(5);
+	track->setFinish(195);
+	gpo::DataAvailableBitSet avail;
+	gpo::TelemetryColumns columns(*tSamps);
+	utils::TrackTimesCache cache;
+	CPPUNIT_ASSERT_EQUAL(true, utils::computeTrackTimes(track,tSamps,avail));
+	CPPUNIT_ASSERT(avail.test(gpo::eDA_CALC_TRACK_DISTANCE));
+	gpo::DataAvailableBitSet columnsAvail;
+	CPPUNIT_ASSERT_EQUAL(true, utils::computeTrackTimes(track,columns,columnsAvail,cache));
+	CPPUNIT_ASSERT(columnsAvail.test(gpo::eDA_CALC_TRACK_DISTANCE));
+
+	// distance accumulates the whole way round, and holds while stopped
+	const auto distances = columns.channel<double>(gpo::eTC_CALC_TRACK_DISTANCE);
+	CPPUNIT_ASSERT_EQUAL(0.0, distances[0]);
+	for (size_t i=1; i<N_SAMPS; i++)
+	{
+		CPPUNIT_ASSERT_EQUAL(tSamps->at(i).calcSamp.trackDistance_m, distances[i]);
+		if (i > STOP_IDX && i <= (STOP_IDX + STOP_LENGTH))
+		{
+			CPPUNIT_ASSERT_EQUAL(distances[i-1], distances[i]);
+		}
+		else
+		{
+			CPPUNIT_ASSERT(distances[i] > distances[i-1]);
+		}
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(
+		LAP_LENGTH_M * (N_SAMPS - STOP_LENGTH - 1) / SAMPS_PER_LAP,
+		distances[N_SAMPS - 1],
+		LAP_LENGTH_M * 0.001);
+
+	// distances never decrease, so they can be searched like time offsets
+	auto index = gpo::makeTimeIndex(distances.size(), [&distances](size_t idx){
+		return distances[idx];
+	});
+	const double segLength_m = distances[1];
+	CPPUNIT_ASSERT_EQUAL((size_t)0, index.floorIndex(-1.0));
+	CPPUNIT_ASSERT_EQUAL((size_t)100, index.floorIndex(segLength_m * 100.5));
+	CPPUNIT_ASSERT_EQUAL(STOP_IDX + STOP_LENGTH, index.floorIndex(distances[STOP_IDX]));
+	CPPUNIT_ASSERT_EQUAL(N_SAMPS - 1, index.floorIndex(distances[N_SAMPS - 1] + 1.0));
+	size_t lerpIdx = 0;
+	CPPUNIT_ASSERT(index.findLerpIndex(lerpIdx, distances[400] + segLength_m * 0.25));
+	CPPUNIT_ASSERT_EQUAL((size_t)400, lerpIdx);
+
+	// sitting still with the GPS jittering back and forth around a point
+	// shouldn't add any distance
+	const size_t LINE_LENGTH = 100;
+	const size_t JITTER_IDX = 50;
+	const size_t JITTER_LENGTH = 40;
+	std::vector<cv::Vec2d> line;
+	for (size_t i=0; i<LINE_LENGTH; i++)
+	{
+		line.push_back(cv::Vec2d(0.00001 * i, 0.0));
+	}
+	auto jitterSamps = gpo::TelemetrySamplesPtr(new gpo::TelemetrySamples(LINE_LENGTH + JITTER_LENGTH));
+	for (size_t i=0; i<jitterSamps->size(); i++)
+	{
+		size_t lineIdx = i;
+		double speed = 10.0;
+		if (i >= JITTER_IDX && i < (JITTER_IDX + JITTER_LENGTH))
+		{
+			lineIdx = (i % 2 == 0 ? JITTER_IDX + 1 : JITTER_IDX - 1);
+			speed = 0.0;
+		}
+		else if (i >= JITTER_IDX)
+		{
+			lineIdx = i - JITTER_LENGTH;
+		}
+		auto &samp = jitterSamps->at(i);
+		samp.t_offset = 0.1 * i;
+		samp.gpSamp.gps.coord.lat = line[lineIdx][0];
+		samp.gpSamp.gps.coord.lon = line[lineIdx][1];
+		samp.gpSamp.gps.speed2D = speed;
+	}
+	auto lineTrack = std::make_shared<gpo::Track>(line);
+	lineTrack->setStart(5);
+	lineTrack->setFinish(95);
+	gpo::DataAvailableBitSet jitterAvail;
+	CPPUNIT_ASSERT_EQUAL(true, utils::computeTrackTimes(lineTrack,jitterSamps,jitterAvail));
+	const double pointSpacing_m = 0.00001 * (M_PI / 180.0) * 6371000.0;
+	for (size_t i=JITTER_IDX; i<(JITTER_IDX + JITTER_LENGTH); i++)
+	{
+		CPPUNIT_ASSERT(jitterSamps->at(i).calcSamp.trackDistance_m <= pointSpacing_m * (JITTER_IDX + 1) + 1e-6);
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(
+		pointSpacing_m * (LINE_LENGTH - 1),
+		jitterSamps->back().calcSamp.trackDistance_m,
+		1e-6);
+}
+
 void
 DataProcessingUtilsTest::smoothMovingAvg()
 {
@@ -276,9 +501,491 @@ DataProcessingUtilsTest::vectorMath()
 	CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0/2.0, proj[2], 0.001);
 }
 
+void
+DataProcessingUtilsTest::timeIndex()
+{
+	// uniformly sampled at 10Hz
+	std::vector<gpo::ECU_TimedSample> samps(100);
+	for (size_t i=0; i<samps.size(); i++)
+	{
+		samps[i].t_offset = 0.1 * i;
+	}
+
+	size_t idx = 0;
+	CPPUNIT_ASSERT(utils::findLerpIndex(idx, samps, 0.0));
+	CPPUNIT_ASSERT_EQUAL(0UL, idx);
+	CPPUNIT_ASSERT(utils::findLerpIndex(idx, samps, 4.25));
+	CPPUNIT_ASSERT_EQUAL(42UL, idx);
+	// search shouldn't depend on where the last one left off
+	CPPUNIT_ASSERT(utils::findLerpIndex(idx, samps, 1.05));
+	CPPUNIT_ASSERT_EQUAL(10UL, idx);
+	// final sample is inclusive, but still needs a sample after 'idx'
+	CPPUNIT_ASSERT(utils::findLerpIndex(idx, samps, samps.back().t_offset));
+	CPPUNIT_ASSERT_EQUAL(98UL, idx);
+	// out of range snaps to the nearest end
+	CPPUNIT_ASSERT( ! utils::findLerpIndex(idx, samps, -1.0));
+	CPPUNIT_ASSERT_EQUAL(0UL, idx);
+	CPPUNIT_ASSERT( ! utils::findLerpIndex(idx, samps, 100.0));
+	CPPUNIT_ASSERT_EQUAL(99UL, idx);
+
+	// a large gap in the middle throws off the rate estimate, forcing the
+	// binary search fallback. repeated timestamps are allowed too.
+	for (size_t i=50; i<samps.size(); i++)
+	{
+		samps[i].t_offset = 100.0 + 0.1 * i;
+	}
+	samps[20].t_offset = samps[21].t_offset;
+	auto index = gpo::makeTimeIndex(samps.size(), [&samps](size_t i){
+		return samps[i].t_offset;
+	});
+	for (size_t i=0; i<samps.size(); i++)
+	{
+		// should always land on the last of any repeated timestamps
+		const size_t expected = (i == 20 ? 21 : i);
+		CPPUNIT_ASSERT_EQUAL(expected, index.floorIndex(samps[i].t_offset));
+		CPPUNIT_ASSERT_EQUAL(expected, index.floorIndex(samps[i].t_offset + 0.01));
+	}
+	CPPUNIT_ASSERT_EQUAL(49UL, index.floorIndex(75.0));
+	CPPUNIT_ASSERT_EQUAL(0UL, index.floorIndex(-1.0));
+	CPPUNIT_ASSERT_EQUAL(99UL, index.floorIndex(1000.0));
+}
+
+void
+DataProcessingUtilsTest::signalFilters()
+{
+	struct TestStruct
+	{
+		float in[5];
+		char pad[13];
+		float out[5];
+	};
+	const size_t N = 1000;
+	std::vector<TestStruct> data(N);
+	for (size_t i=0; i<N; i++)
+	{
+		for (size_t ff=0; ff<5; ff++)
+		{
+			// mix of a slow trend and alternating noise
+			data[i].in[ff] = (ff + 1) * 0.01f * i + ((i % 2) ? 1.0f : -1.0f);
+		}
+	}
+	std::array<size_t, 5> inOffsets;
+	std::array<size_t, 5> outOffsets;
+	for (size_t ff=0; ff<5; ff++)
+	{
+		inOffsets[ff] = offsetof(TestStruct, in) + ff * sizeof(float);
+		outOffsets[ff] = offsetof(TestStruct, out) + ff * sizeof(float);
+	}
+
+	// moving average should match the single channel implementation. five
+	// fields also exercises a partially filled second pass of lanes.
+	auto expected = data;
+	utils::smoothMovingAvgStructured<TestStruct,float,5>(
+		data.data(), expected.data(), inOffsets, outOffsets, N, 9);
+	utils::filterStructured<TestStruct,float,5>(
+		data.data(), data.data(), inOffsets, outOffsets, N, utils::FilterConfig::makeMovingAvg(9));
+	for (size_t i=0; i<N; i++)
+	{
+		for (size_t ff=0; ff<5; ff++)
+		{
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[i].out[ff], data[i].out[ff], 0.0001);
+		}
+	}
+
+	// filtering in place where outputs overwrite their inputs
+	auto inPlace = data;
+	utils::filterStructured<TestStruct,float,5>(
+		inPlace.data(), inPlace.data(), inOffsets, inOffsets, N, utils::FilterConfig::makeMovingAvg(9));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[500].out[2], inPlace[500].in[2], 0.0001);
+
+	// zero phase low-pass should remove the noise without delaying the trend
+	utils::filterStructured<TestStruct,float,5>(
+		data.data(), data.data(), inOffsets, outOffsets, N, utils::FilterConfig::makeButterworth(5.0, 200.0));
+	for (size_t i=100; i<(N-100); i++)
+	{
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.03 * i, data[i].out[2], 0.01);
+	}
+
+	// exponential smoothing settles on a constant input
+	std::vector<utils::FilterLanes> lanes(N, utils::FilterLanes{{1.0, 2.0, 3.0, 4.0}});
+	lanes[0] = utils::FilterLanes{{0.0, 0.0, 0.0, 0.0}};
+	utils::filterChannels(
+		N,
+		utils::FilterConfig::makeExponential(0.1),
+		[&lanes](size_t idx, utils::FilterLanes &out){ out = lanes[idx]; },
+		[&lanes](size_t idx, const utils::FilterLanes &in){ lanes[idx] = in; });
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.1, lanes[1].v[0], 0.0001);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, lanes[N-1].v[3], 0.0001);
+}
+
+void
+DataProcessingUtilsTest::resample()
+{
+	// every channel ramps linearly at its own slope
+	const size_t N_SAMPS = 10000;
+	const double IN_RATE_HZ = 10.0;
+	auto channelValue = [](const gpo::ChannelDescriptor &desc, double i){
+		return desc.channel + 0.25 * i;
+	};
+	gpo::TelemetrySamples samps(N_SAMPS);
+	for (size_t i=0; i<N_SAMPS; i++)
+	{
+		auto *sampBytes = reinterpret_cast<char *>(&samps[i]);
+		for (const auto &desc : gpo::getChannelDescriptors())
+		{
+			const double value = channelValue(desc, i);
+			switch (desc.type)
+			{
+				case gpo::eCT_FLOAT:
+					*reinterpret_cast<float *>(sampBytes + desc.sampleOffset) = value;
+					break;
+				case gpo::eCT_DOUBLE:
+					*reinterpret_cast<double *>(sampBytes + desc.sampleOffset) = value;
+					break;
+				case gpo::eCT_INT:
+					*reinterpret_cast<int *>(sampBytes + desc.sampleOffset) = i;
+					break;
+			}
+		}
+		samps[i].t_offset = i / IN_RATE_HZ;
+	}
+
+	// lerp should cover every field, including GPS and on track location
+	gpo::TelemetrySample mid;
+	utils::lerp(mid, samps[10], samps[11], 0.75);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.075, mid.t_offset, 0.0001);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(channelValue(gpo::getChannelDescriptor(gpo::eTC_GOPRO_ACCL_X), 10.75), mid.gpSamp.accl.x, 0.0001);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(channelValue(gpo::getChannelDescriptor(gpo::eTC_GOPRO_GPS_LAT), 10.75), mid.gpSamp.gps.coord.lat, 0.0001);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(channelValue(gpo::getChannelDescriptor(gpo::eTC_CALC_ON_TRACK_LON), 10.75), mid.calcSamp.onTrackLL.lon, 0.0001);
+	CPPUNIT_ASSERT_EQUAL(11, mid.calcSamp.lap);
+
+	// upsample by 2x. output spans several chunks.
+	gpo::DataAvailableBitSet avail;
+	avail.set();
+	gpo::TelemetryColumns in(samps);
+	gpo::TelemetryColumns out;
+	utils::resample(out, in, avail, IN_RATE_HZ * 2);
+	CPPUNIT_ASSERT_EQUAL((size_t)((N_SAMPS - 1) * 2), out.size());
+	for (size_t i=0; i<out.size(); i++)
+	{
+		const auto samp = out.sampleAt(i);
+		const auto *sampBytes = reinterpret_cast<const char *>(&samp);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(i / (IN_RATE_HZ * 2), samp.t_offset, 0.0001);
+		// halfway between laps rounds up, give or take time accumulation error
+		const int lap = samp.calcSamp.lap;
+		CPPUNIT_ASSERT(lap == (int)(i / 2) || lap == (int)((i + 1) / 2));
+		for (const auto &desc : gpo::getChannelDescriptors())
+		{
+			if (desc.type == gpo::eCT_FLOAT)
+			{
+				CPPUNIT_ASSERT_DOUBLES_EQUAL(
+					channelValue(desc, i / 2.0),
+					*reinterpret_cast<const float *>(sampBytes + desc.sampleOffset),
+					0.01);
+			}
+			else if (desc.type == gpo::eCT_DOUBLE && desc.channel != gpo::eTC_T_OFFSET)
+			{
+				CPPUNIT_ASSERT_DOUBLES_EQUAL(
+					channelValue(desc, i / 2.0),
+					*reinterpret_cast<const double *>(sampBytes + desc.sampleOffset),
+					0.0001);
+			}
+		}
+	}
+	// input is left alone
+	CPPUNIT_ASSERT_EQUAL(N_SAMPS, in.size());
+	CPPUNIT_ASSERT_EQUAL(samps[N_SAMPS - 1].gpSamp.accl.x, in.sampleAt(N_SAMPS - 1).gpSamp.accl.x);
+
+	// compact storage carries over, dropping the same channels
+	gpo::DataAvailableBitSet compactAvail;
+	compactAvail.set(gpo::eDA_GOPRO_GPS_LATLON);
+	in.setCompact(true, compactAvail);
+	utils::resample(out, in, compactAvail, IN_RATE_HZ / 2);
+	CPPUNIT_ASSERT(out.isCompact());
+	CPPUNIT_ASSERT_EQUAL(gpo::eCE_ABSENT, out.getEncoding(gpo::eTC_GOPRO_ACCL_X));
+	CPPUNIT_ASSERT_EQUAL(gpo::eCE_NATIVE, out.getEncoding(gpo::eTC_GOPRO_GPS_LAT));
+	const auto lats = out.channel<double>(gpo::eTC_GOPRO_GPS_LAT);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(
+		channelValue(gpo::getChannelDescriptor(gpo::eTC_GOPRO_GPS_LAT), 200.0),
+		lats[100],
+		0.0001);
+
+	// band-limited mode reproduces smooth channels, and leaves laps stepping
+	utils::resample(out, gpo::TelemetryColumns(samps), avail, IN_RATE_HZ * 2, utils::ResamplerConfig::makeWindowedSinc());
+	CPPUNIT_ASSERT_EQUAL((size_t)((N_SAMPS - 1) * 2), out.size());
+	const auto acclX = out.channel<float>(gpo::eTC_GOPRO_ACCL_X);
+	const auto laps = out.channel<int>(gpo::eTC_CALC_LAP);
+	for (size_t i=100; i<out.size()-100; i++)
+	{
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(
+			channelValue(gpo::getChannelDescriptor(gpo::eTC_GOPRO_ACCL_X), i / 2.0),
+			acclX[i],
+			0.01);
+		CPPUNIT_ASSERT(laps[i] == (int)(i / 2) || laps[i] == (int)((i + 1) / 2));
+	}
+
+	// lap timers reset every lap. they must be interpolated linearly rather
+	// than ringing around each reset.
+	const size_t SAMPS_PER_LAP = 100;
+	for (size_t i=0; i<N_SAMPS; i++)
+	{
+		samps[i].calcSamp.lapTimeOffset = (i % SAMPS_PER_LAP) / IN_RATE_HZ;
+	}
+	utils::resample(out, gpo::TelemetryColumns(samps), avail, IN_RATE_HZ * 2, utils::ResamplerConfig::makeWindowedSinc());
+	const auto lapTimes = out.channel<double>(gpo::eTC_CALC_LAP_TIME_OFFSET);
+	const double maxLapTime = (SAMPS_PER_LAP - 1) / IN_RATE_HZ;
+	for (size_t i=0; i<out.size(); i++)
+	{
+		CPPUNIT_ASSERT(lapTimes[i] >= 0.0 && lapTimes[i] <= maxLapTime + 0.0001);
+		if (i % 2 == 0)
+		{
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(samps[i / 2].calcSamp.lapTimeOffset, lapTimes[i], 0.001);
+		}
+	}
+
+	// a log that ends on a repeated timestamp shouldn't produce NaNs
+	gpo::TelemetrySamples dupSamps(samps.begin(), samps.begin() + 20);
+	dupSamps.back().t_offset = dupSamps[dupSamps.size() - 2].t_offset;
+	for (const double outRate_hz : {IN_RATE_HZ, IN_RATE_HZ * 2, IN_RATE_HZ * 3.3})
+	{
+		utils::resample(out, gpo::TelemetryColumns(dupSamps), avail, outRate_hz);
+		CPPUNIT_ASSERT(out.size() > 0);
+		const auto dupAcclX = out.channel<float>(gpo::eTC_GOPRO_ACCL_X);
+		const auto dupLats = out.channel<double>(gpo::eTC_GOPRO_GPS_LAT);
+		for (size_t i=0; i<out.size(); i++)
+		{
+			CPPUNIT_ASSERT(std::isfinite(dupAcclX[i]));
+			CPPUNIT_ASSERT(std::isfinite(dupLats[i]));
+		}
+	}
+}
+
+void
+DataProcessingUtilsTest::streamingResampler()
+{
+	// slow ECU-like log of a 1Hz sine with jittery timestamps
+	const double IN_RATE_HZ = 10.0;
+	const double OUT_RATE_HZ = 59.94;
+	const size_t N_IN = 600;
+	std::vector<double> tIn(N_IN);
+	std::vector<utils::FilterLanes> xIn(N_IN);
+	for (size_t i=0; i<N_IN; i++)
+	{
+		tIn[i] = (i + ((int)(i % 3) - 1) * 0.05) / IN_RATE_HZ;
+		const double v = std::sin(2.0 * M_PI * tIn[i]);
+		xIn[i] = utils::FilterLanes{{v, -v, 1.0, 0.0}};
+	}
+	// run a second past the end to check that the last sample is held
+	const size_t N_OUT = (tIn.back() + 1.0) * OUT_RATE_HZ;
+
+	// linear mode matches a lerp between the bounding samples
+	std::vector<utils::FilterLanes> outs;
+	std::vector<double> tOuts;
+	auto collect = [&](size_t outIdx, double t_sec, const utils::FilterLanes &y){
+		CPPUNIT_ASSERT_EQUAL(outs.size(), outIdx);
+		outs.push_back(y);
+		tOuts.push_back(t_sec);
+	};
+	utils::StreamingResampler linear(IN_RATE_HZ, OUT_RATE_HZ, utils::ResamplerConfig::makeLinear());
+	linear.pushBlock(tIn.data(), xIn.data(), N_IN, collect);
+	linear.finish(N_OUT, collect);
+	CPPUNIT_ASSERT_EQUAL(N_OUT, outs.size());
+	size_t idxA = 0;
+	for (size_t i=0; i<N_OUT; i++)
+	{
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(i / OUT_RATE_HZ, tOuts[i], 1e-9);
+		if (tOuts[i] < tIn[0])
+		{
+			CPPUNIT_ASSERT_EQUAL(xIn[0].v[0], outs[i].v[0]);
+			continue;
+		}
+		else if (tOuts[i] >= tIn[N_IN - 1])
+		{
+			CPPUNIT_ASSERT_EQUAL(xIn[N_IN - 1].v[0], outs[i].v[0]);
+			continue;
+		}
+		while ((idxA + 2) < N_IN && tIn[idxA + 1] <= tOuts[i])
+		{
+			idxA++;
+		}
+		const double ratio = (tOuts[i] - tIn[idxA]) / (tIn[idxA + 1] - tIn[idxA]);
+		const double expected = xIn[idxA].v[0] + (xIn[idxA + 1].v[0] - xIn[idxA].v[0]) * ratio;
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, outs[i].v[0], 1e-9);
+	}
+
+	// windowed-sinc tracks the sine much more closely between samples
+	outs.clear();
+	tOuts.clear();
+	utils::StreamingResampler sinc(IN_RATE_HZ, OUT_RATE_HZ, utils::ResamplerConfig::makeWindowedSinc());
+	for (size_t i=0; i<N_IN; i++)
+	{
+		sinc.push(tIn[i], xIn[i], collect);
+		// outputs trail the input by at most the kernel's half width
+		if (i > sinc.halfTaps() + 1)
+		{
+			CPPUNIT_ASSERT(tOuts.back() >= tIn[i - sinc.halfTaps() - 1]);
+		}
+	}
+	sinc.finish(N_OUT, collect);
+	CPPUNIT_ASSERT_EQUAL(N_OUT, outs.size());
+	for (size_t i=0; i<N_OUT; i++)
+	{
+		const double t = tOuts[i];
+		if (t < 2.0 || t > (tIn.back() - 2.0))
+		{
+			continue;
+		}
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sin(2.0 * M_PI * t), outs[i].v[0], 0.02);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(-outs[i].v[0], outs[i].v[1], 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, outs[i].v[2], 1e-9);
+	}
+
+	// downsampling filters out tones above the output's Nyquist frequency
+	const double FAST_RATE_HZ = 100.0;
+	const double SLOW_RATE_HZ = 10.0;
+	outs.clear();
+	tOuts.clear();
+	utils::StreamingResampler down(FAST_RATE_HZ, SLOW_RATE_HZ, utils::ResamplerConfig::makeWindowedSinc());
+	for (size_t i=0; i<1000; i++)
+	{
+		const double t = i / FAST_RATE_HZ;
+		const double tone = std::sin(2.0 * M_PI * 8.0 * t);
+		down.push(t, utils::FilterLanes{{tone, 0.0, 0.0, 0.0}}, collect);
+	}
+	down.finish(100, collect);
+	CPPUNIT_ASSERT_EQUAL((size_t)100, outs.size());
+	for (size_t i=20; i<80; i++)
+	{
+		CPPUNIT_ASSERT(std::abs(outs[i].v[0]) < 0.05);
+	}
+}
+
+void
+DataProcessingUtilsTest::signalAlignment()
+{
+	// a wandering "speed" trace, and a shorter log that starts partway in
+	const size_t N_A = 20000;
+	const size_t TAIL_OVERLAP = 3217;
+	const size_t B_START = 5000;
+	const size_t N_B = 9000;
+	std::vector<double> speed(N_A);
+	for (size_t i=0; i<N_A; i++)
+	{
+		const double t = i / 60.0;
+		speed[i] = 20.0 + 8.0 * std::sin(0.31 * t) + 5.0 * std::sin(0.83 * t + 1.0) + 2.0 * std::sin(2.9 * t);
+	}
+	// 'b' is offset, scaled, and slightly noisy (ie. engine speed in gear)
+	std::vector<double> rpm(N_B);
+	for (size_t i=0; i<N_B; i++)
+	{
+		const size_t srcIdx = B_START + i;
+		rpm[i] = 150.0 * speed[srcIdx] + 800.0 + ((i * 7919) % 13) * 5.0;
+	}
+
+	// a[i] shows up at b[i + lag]. b[0] is a[B_START].
+	utils::SignalAlignment result;
+	CPPUNIT_ASSERT(utils::findSignalAlignment(speed.data(), N_A, rpm.data(), N_B, N_B / 4, result));
+	CPPUNIT_ASSERT_EQUAL(-(int64_t)B_START, result.lag);
+	CPPUNIT_ASSERT(result.confidence > 0.99);
+	CPPUNIT_ASSERT_EQUAL(N_B, result.overlap);
+
+	// same thing the other way around
+	CPPUNIT_ASSERT(utils::findSignalAlignment(rpm.data(), N_B, speed.data(), N_A, N_B / 4, result));
+	CPPUNIT_ASSERT_EQUAL((int64_t)B_START, result.lag);
+
+	// 'b' only overlaps the end of 'a', then carries on with something else
+	std::vector<double> tail(speed.end() - TAIL_OVERLAP, speed.end());
+	for (size_t i=0; i<4000; i++)
+	{
+		tail.push_back(3.0 * std::cos(1.7 * i / 60.0));
+	}
+	CPPUNIT_ASSERT(utils::findSignalAlignment(speed.data(), N_A, tail.data(), tail.size(), 1000, result));
+	CPPUNIT_ASSERT_EQUAL(-(int64_t)(N_A - TAIL_OVERLAP), result.lag);
+	CPPUNIT_ASSERT_EQUAL(TAIL_OVERLAP, result.overlap);
+
+	// flat signals can't be aligned
+	std::vector<double> flat(1000, 3.0);
+	CPPUNIT_ASSERT( ! utils::findSignalAlignment(speed.data(), N_A, flat.data(), flat.size(), 10, result));
+}
+
 int main()
 {
 	CppUnit::TextUi::TestRunner runner;
 	runner.addTest(DataProcessingUtilsTest::suite());
 	return runner.run() ? 0 : EXIT_FAILURE;
 }
+
+static
+cv::Vec2d
+ovalTrackAt(
+	double s)
+{
+	return cv::Vec2d(400.0 * std::cos(2.0 * M_PI * s), 250.0 * std::sin(2.0 * M_PI * s));
+}
+
+void
+DataProcessingUtilsTest::timeWarping()
+{
+	// run 'a' laps an oval at a constant speed. run 'b' is slower overall,
+	// gains ground in the first half of the lap and loses it again after.
+	const size_t N_A = 5400;
+	const size_t N_B = 5700;
+	const double STEP_B = 2.0 * M_PI * 400.0 * 1.2 / N_B;// longest step 'b' takes
+	std::vector<cv::Vec2d> a(N_A);
+	std::vector<cv::Vec2d> b(N_B);
+	for (size_t i=0; i<N_A; i++)
+	{
+		a[i] = ovalTrackAt(static_cast<double>(i) / (N_A - 1));
+	}
+	for (size_t i=0; i<N_B; i++)
+	{
+		const double u = static_cast<double>(i) / (N_B - 1);
+		b[i] = ovalTrackAt(u + 0.03 * std::sin(2.0 * M_PI * u));
+	}
+
+	std::vector<size_t> bIdxForA;
+	CPPUNIT_ASSERT(utils::warpPaths(a.data(), N_A, b.data(), N_B, 300, bIdxForA));
+	CPPUNIT_ASSERT_EQUAL(N_A, bIdxForA.size());
+	CPPUNIT_ASSERT_EQUAL((size_t)0, bIdxForA.front());
+	for (size_t i=0; i<N_A; i++)
+	{
+		if (i > 0)
+		{
+			CPPUNIT_ASSERT(bIdxForA[i - 1] <= bIdxForA[i]);
+		}
+		// every sample lines up with where 'b' was at that spot on the track
+		CPPUNIT_ASSERT(bIdxForA[i] < N_B);
+		CPPUNIT_ASSERT(cv::norm(a[i] - b[bIdxForA[i]]) < STEP_B);
+	}
+
+	// 'b' is ten times longer than 'a'. the band is widened to keep it
+	// connected, so a valid schedule still comes out.
+	const size_t N_SHORT = 100;
+	std::vector<cv::Vec2d> shortA(N_SHORT);
+	for (size_t i=0; i<N_SHORT; i++)
+	{
+		shortA[i] = b[i * (N_B - 1) / (N_SHORT - 1)];
+	}
+	CPPUNIT_ASSERT(utils::warpPaths(shortA.data(), N_SHORT, b.data(), N_B, 0, bIdxForA));
+	CPPUNIT_ASSERT_EQUAL(N_SHORT, bIdxForA.size());
+	for (size_t i=1; i<N_SHORT; i++)
+	{
+		// the samples of 'b' in between are skipped somewhere along the way
+		CPPUNIT_ASSERT(bIdxForA[i] > (i - 1) * (N_B - 1) / (N_SHORT - 1));
+		CPPUNIT_ASSERT(bIdxForA[i] <= i * (N_B - 1) / (N_SHORT - 1));
+	}
+
+	// a single sample range has to reach every sample of the other range,
+	// however narrow the band is
+	CPPUNIT_ASSERT(utils::warpPaths(a.data(), 1, b.data(), N_B, 2, bIdxForA));
+	CPPUNIT_ASSERT_EQUAL((size_t)1, bIdxForA.size());
+	CPPUNIT_ASSERT_EQUAL((size_t)0, bIdxForA[0]);
+	CPPUNIT_ASSERT(utils::warpPaths(a.data(), N_A, b.data(), 1, 2, bIdxForA));
+	CPPUNIT_ASSERT_EQUAL(N_A, bIdxForA.size());
+	for (size_t i=0; i<N_A; i++)
+	{
+		CPPUNIT_ASSERT_EQUAL((size_t)0, bIdxForA[i]);
+	}
+
+	CPPUNIT_ASSERT( ! utils::warpPaths(a.data(), N_A, b.data(), 0, 10, bIdxForA));
+}
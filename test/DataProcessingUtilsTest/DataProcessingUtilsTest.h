@@ -8,9 +8,17 @@ class DataProcessingUtilsTest : public CppUnit::TestFixture
 {
 	CPPUNIT_TEST_SUITE(DataProcessingUtilsTest);
 	CPPUNIT_TEST(trackTimes);
+	CPPUNIT_TEST(trackTimesIncremental);
+	CPPUNIT_TEST(trackDistance);
 	CPPUNIT_TEST(smoothMovingAvg);
 	CPPUNIT_TEST(smoothMovingAvgStructured);
 	CPPUNIT_TEST(vectorMath);
+	CPPUNIT_TEST(timeIndex);
+	CPPUNIT_TEST(signalFilters);
+	CPPUNIT_TEST(resample);
+	CPPUNIT_TEST(streamingResampler);
+	CPPUNIT_TEST(signalAlignment);
+	CPPUNIT_TEST(timeWarping);
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -20,9 +28,17 @@ public:
 
 protected:
 	void trackTimes();
+	void trackTimesIncremental();
+	void trackDistance();
 	void smoothMovingAvg();
 	void smoothMovingAvgStructured();
 	void vectorMath();
+	void timeIndex();
+	void signalFilters();
+	void resample();
+	void streamingResampler();
+	void signalAlignment();
+	void timeWarping();
 
 private:
 
@@ -1,6 +1,14 @@
 #include "DataSourceTest.h"
 
 #include "GoProOverlay/data/DataSource.h"
+#include "GoProOverlay/utils/io/cache.h"
+#include "GoProOverlay/utils/io/gpot.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
 #include "test_data.h"
 
 DataSourceTest::DataSourceTest()
@@ -201,9 +209,445 @@ DataSourceTest::testTelemetryMerge()
 	CPPUNIT_ASSERT((expectedAvail == srcFromTelem->dataAvailable()));
 }
 
+void
+DataSourceTest::testCache()
+{
+	// work on a copy so we can modify the source file
+	const std::filesystem::path srcFile = std::filesystem::path(test_data::TMP_ROOT) / "cache_source.msl";
+	std::filesystem::copy_file(
+		test_data::ecu::MS2E_AUTOCROSS,
+		srcFile,
+		std::filesystem::copy_options::overwrite_existing);
+	utils::io::CacheKey srcKey;
+	CPPUNIT_ASSERT(utils::io::makeCacheKey(srcFile,srcKey));
+	const auto cachePath = utils::io::getCachePath(srcKey);
+	CPPUNIT_ASSERT( ! cachePath.empty());
+	std::filesystem::remove(cachePath);
+
+	auto srcFromMsq = gpo::DataSource::loadDataFromMegaSquirtLog(srcFile);
+	CPPUNIT_ASSERT(srcFromMsq != nullptr);
+	gpo::TelemetrySamplesPtr origSamps = std::make_shared<gpo::TelemetrySamples>();
+	for (size_t i=0; i<srcFromMsq->telemSrc->size(); i++)
+	{
+		origSamps->push_back(srcFromMsq->telemSrc->at(i));
+	}
+
+	// no cache exists yet
+	gpo::TelemetrySamplesPtr cachedSamps = std::make_shared<gpo::TelemetrySamples>();
+	gpo::DataAvailableBitSet cachedAvail;
+	CPPUNIT_ASSERT_EQUAL(false, utils::io::readCache(srcFile,cachedSamps,cachedAvail,nullptr));
+
+	gpo::VideoMetadata vMeta = {59.94, 1234, 1920, 1080};
+	CPPUNIT_ASSERT(utils::io::writeCache(srcFile,origSamps,srcFromMsq->dataAvailable(),&vMeta));
+	// cache lives in the per-user cache dir, not next to the source
+	CPPUNIT_ASSERT(std::filesystem::exists(cachePath));
+	CPPUNIT_ASSERT(cachePath.parent_path() == utils::io::getCacheDir());
+
+	// cache hit should restore everything exactly
+	gpo::VideoMetadata cachedMeta = {};
+	CPPUNIT_ASSERT(utils::io::readCache(srcFile,cachedSamps,cachedAvail,&cachedMeta));
+	CPPUNIT_ASSERT((srcFromMsq->dataAvailable() == cachedAvail));
+	CPPUNIT_ASSERT_EQUAL(origSamps->size(), cachedSamps->size());
+	CPPUNIT_ASSERT_EQUAL(0, std::memcmp(
+		origSamps->data(),
+		cachedSamps->data(),
+		origSamps->size() * sizeof(gpo::TelemetrySample)));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(vMeta.fps, cachedMeta.fps, 0.0001);
+	CPPUNIT_ASSERT_EQUAL(vMeta.frameCount, cachedMeta.frameCount);
+	CPPUNIT_ASSERT_EQUAL(vMeta.frameWidth, cachedMeta.frameWidth);
+	CPPUNIT_ASSERT_EQUAL(vMeta.frameHeight, cachedMeta.frameHeight);
+
+	// modifying the source file should invalidate the cache
+	{
+		std::ofstream ofs(srcFile, std::ios::app);
+		ofs << "\n";
+	}
+	CPPUNIT_ASSERT_EQUAL(false, utils::io::readCache(srcFile,cachedSamps,cachedAvail,nullptr));
+	std::filesystem::remove(cachePath);
+}
+
 int main()
 {
 	CppUnit::TextUi::TestRunner runner;
 	runner.addTest(DataSourceTest::suite());
 	return runner.run() ? 0 : EXIT_FAILURE;
 }
+
+void
+DataSourceTest::testTelemetryColumns()
+{
+	const size_t N_SAMPS = 50;
+	gpo::TelemetrySamples tSamps(N_SAMPS);
+	for (size_t i=0; i<N_SAMPS; i++)
+	{
+		auto &samp = tSamps.at(i);
+		std::memset(&samp, 0, sizeof(samp));
+		samp.t_offset = i * 0.01;
+		samp.gpSamp.accl.x = i * 1.5f;
+		samp.gpSamp.gps.coord.lat = 42.0 + i * 1e-6;
+		samp.ecuSamp.engineSpeed_rpm = 1000.0f + i;
+		samp.calcSamp.lap = (i < N_SAMPS / 2 ? 1 : 2);
+		samp.calcSamp.vehiAccl.lon_g = -0.5f * i;
+	}
+
+	gpo::TelemetryColumns columns(tSamps);
+	CPPUNIT_ASSERT_EQUAL(N_SAMPS, columns.size());
+
+	// channel views should see the same values as the samples
+	const auto tOffsets = columns.channel<double>(gpo::eTC_T_OFFSET);
+	const auto acclX = columns.channel<float>(gpo::eTC_GOPRO_ACCL_X);
+	const auto laps = columns.channel<int>(gpo::eTC_CALC_LAP);
+	CPPUNIT_ASSERT_EQUAL(N_SAMPS, tOffsets.size());
+	for (size_t i=0; i<N_SAMPS; i++)
+	{
+		CPPUNIT_ASSERT_EQUAL(tSamps[i].t_offset, tOffsets[i]);
+		CPPUNIT_ASSERT_EQUAL(tSamps[i].gpSamp.accl.x, acclX[i]);
+		CPPUNIT_ASSERT_EQUAL(tSamps[i].calcSamp.lap, laps[i]);
+	}
+
+	// accessing a channel with the wrong type should throw
+	CPPUNIT_ASSERT_THROW(columns.channel<float>(gpo::eTC_T_OFFSET), std::runtime_error);
+	CPPUNIT_ASSERT_THROW(columns.sampleAt(N_SAMPS), std::out_of_range);
+
+	// round trip back to samples should be lossless
+	gpo::TelemetrySamples outSamps;
+	columns.toSamples(outSamps);
+	CPPUNIT_ASSERT_EQUAL(N_SAMPS, outSamps.size());
+	for (size_t i=0; i<N_SAMPS; i++)
+	{
+		const auto sampAt = columns.sampleAt(i);
+		CPPUNIT_ASSERT_EQUAL(tSamps[i].gpSamp.gps.coord.lat, outSamps[i].gpSamp.gps.coord.lat);
+		CPPUNIT_ASSERT_EQUAL(tSamps[i].ecuSamp.engineSpeed_rpm, outSamps[i].ecuSamp.engineSpeed_rpm);
+		CPPUNIT_ASSERT_EQUAL(tSamps[i].calcSamp.vehiAccl.lon_g, outSamps[i].calcSamp.vehiAccl.lon_g);
+		CPPUNIT_ASSERT_EQUAL(tSamps[i].calcSamp.vehiAccl.lon_g, sampAt.calcSamp.vehiAccl.lon_g);
+		CPPUNIT_ASSERT_EQUAL(tSamps[i].calcSamp.lap, sampAt.calcSamp.lap);
+	}
+
+	// TelemetrySource should expose the same columns
+	auto dSrc = gpo::DataSource::makeDataFromTelemetry(tSamps);
+	const auto srcLaps = dSrc->telemSrc->channel<int>(gpo::eTC_CALC_LAP);
+	CPPUNIT_ASSERT_EQUAL(N_SAMPS, srcLaps.size());
+	CPPUNIT_ASSERT_EQUAL(2, srcLaps[N_SAMPS - 1]);
+	CPPUNIT_ASSERT_EQUAL(columns.size_bytes(), dSrc->telemSrc->size_bytes());
+
+	// as should its non-owning accessor, which also follows the seeker
+	const auto telem = dSrc->telemSrc->accessor();
+	const auto lonAccls = telem.channel<float>(gpo::eTC_CALC_VEHI_ACCL_LON);
+	CPPUNIT_ASSERT_EQUAL(N_SAMPS, telem.size());
+	dSrc->seeker->seekToIdx(7);
+	CPPUNIT_ASSERT_EQUAL((size_t)7, telem.seekedIdx());
+	CPPUNIT_ASSERT_EQUAL(tSamps[7].calcSamp.vehiAccl.lon_g, lonAccls[telem.seekedIdx()]);
+	CPPUNIT_ASSERT_EQUAL(tSamps[7].t_offset, telem.at(7).t_offset);
+}
+
+void
+DataSourceTest::testCompactTelemetry()
+{
+	auto srcFromMsq = gpo::DataSource::loadDataFromMegaSquirtLog(
+		test_data::ecu::MS2E_AUTOCROSS);
+	CPPUNIT_ASSERT(srcFromMsq != nullptr);
+	auto tSrc = srcFromMsq->telemSrc;
+	gpo::TelemetrySamples origSamps;
+	for (size_t i=0; i<tSrc->size(); i++)
+	{
+		origSamps.push_back(tSrc->at(i));
+	}
+
+	const size_t bytesBefore = tSrc->size_bytes();
+	srcFromMsq->setCompactTelemetry(true);
+	CPPUNIT_ASSERT(srcFromMsq->isTelemetryCompact());
+	const size_t bytesAfter = tSrc->size_bytes();
+	// ECU-only source should only be storing time + 3 quantized channels
+	CPPUNIT_ASSERT_EQUAL(tSrc->size() * (sizeof(double) + 3 * sizeof(int16_t)), bytesAfter);
+	CPPUNIT_ASSERT(bytesAfter * 10 < bytesBefore);
+
+	// values should be within the quantization step of the originals
+	CPPUNIT_ASSERT_EQUAL(origSamps.size(), tSrc->size());
+	for (size_t i=0; i<tSrc->size(); i++)
+	{
+		const auto tSamp = tSrc->at(i);
+		const auto &origSamp = origSamps.at(i);
+		CPPUNIT_ASSERT_EQUAL(origSamp.t_offset, tSamp.t_offset);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(origSamp.ecuSamp.engineSpeed_rpm, tSamp.ecuSamp.engineSpeed_rpm, 0.5);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(origSamp.ecuSamp.tps, tSamp.ecuSamp.tps, 0.006);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(origSamp.ecuSamp.boost_psi, tSamp.ecuSamp.boost_psi, 0.006);
+	}
+
+	// seeker should still work off compacted channels
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(14.8, srcFromMsq->getTelemetryRate_hz(), 0.1);
+
+	srcFromMsq->setCompactTelemetry(false);
+	CPPUNIT_ASSERT_EQUAL(bytesBefore, tSrc->size_bytes());
+}
+
+void
+DataSourceTest::testCopyOnWriteTelemetry()
+{
+	const double SAMP_RATE_HZ = 100.0;
+	const size_t N_SAMPS = gpo::TELEM_CHUNK_SIZE * 2 + 100;
+	gpo::TelemetrySamples tSamps(N_SAMPS);
+	for (size_t i=0; i<N_SAMPS; i++)
+	{
+		auto &samp = tSamps.at(i);
+		std::memset(&samp, 0, sizeof(samp));
+		samp.t_offset = (1.0 / SAMP_RATE_HZ) * i;
+		samp.gpSamp.accl.x = i;
+	}
+	auto dSrc = gpo::DataSource::makeDataFromTelemetry(tSamps);
+	const auto &columns = dSrc->telemSrc->columns();
+	const size_t N_CHUNKS = gpo::eTC_COUNT * 3;
+	CPPUNIT_ASSERT_EQUAL((size_t)0, columns.sharedChunkCount());
+
+	// duplicates and backups should share every chunk
+	auto dup = dSrc->duplicate();
+	CPPUNIT_ASSERT(dSrc->backupTelemetry());
+	CPPUNIT_ASSERT_EQUAL(N_CHUNKS, columns.sharedChunkCount());
+	CPPUNIT_ASSERT_EQUAL(N_CHUNKS, dup->telemSrc->columns().sharedChunkCount());
+
+	// resampling produces new chunks, leaving the backup & duplicate intact
+	dSrc->resampleTelemetry(SAMP_RATE_HZ / 2);
+	CPPUNIT_ASSERT(dSrc->telemSrc->size() < N_SAMPS);
+	CPPUNIT_ASSERT_EQUAL(N_SAMPS, dup->telemSrc->size());
+	CPPUNIT_ASSERT_EQUAL(1000.0f, dup->telemSrc->at(1000).gpSamp.accl.x);
+
+	CPPUNIT_ASSERT(dSrc->restoreTelemetry());
+	CPPUNIT_ASSERT_EQUAL(N_SAMPS, dSrc->telemSrc->size());
+	CPPUNIT_ASSERT_EQUAL(1000.0f, dSrc->telemSrc->at(1000).gpSamp.accl.x);
+	dSrc->deleteTelemetryBackup();
+	CPPUNIT_ASSERT_EQUAL(N_CHUNKS, columns.sharedChunkCount());
+}
+
+void
+DataSourceTest::testBinaryTelemetry()
+{
+	auto srcFromCSV = gpo::DataSource::loadDataFromSoloStormCSV(
+		test_data::solostorm::AUTOCROSS);
+	CPPUNIT_ASSERT(srcFromCSV != nullptr);
+	const auto &origColumns = srcFromCSV->telemSrc->columns();
+
+	// writing then mapping back in should restore every channel exactly
+	const std::filesystem::path binFile = std::filesystem::path(test_data::TMP_ROOT) / "binary_telem.gpot";
+	CPPUNIT_ASSERT(srcFromCSV->writeTelemetryToBinary(binFile));
+	auto srcFromBin = gpo::DataSource::loadDataFromFile(binFile);
+	CPPUNIT_ASSERT(srcFromBin != nullptr);
+	CPPUNIT_ASSERT((srcFromCSV->dataAvailable() == srcFromBin->dataAvailable()));
+	const auto &binColumns = srcFromBin->telemSrc->columns();
+	CPPUNIT_ASSERT_EQUAL(origColumns.size(), binColumns.size());
+	for (const auto &desc : gpo::getChannelDescriptors())
+	{
+		CPPUNIT_ASSERT_EQUAL(origColumns.getEncoding(desc.channel), binColumns.getEncoding(desc.channel));
+	}
+	for (size_t i=0; i<origColumns.size(); i++)
+	{
+		const auto origSamp = srcFromCSV->telemSrc->at(i);
+		const auto binSamp = srcFromBin->telemSrc->at(i);
+		CPPUNIT_ASSERT_EQUAL(origSamp.t_offset, binSamp.t_offset);
+		CPPUNIT_ASSERT_EQUAL(origSamp.gpSamp.gps.coord.lat, binSamp.gpSamp.gps.coord.lat);
+		CPPUNIT_ASSERT_EQUAL(origSamp.gpSamp.gps.coord.lon, binSamp.gpSamp.gps.coord.lon);
+		CPPUNIT_ASSERT_EQUAL(origSamp.gpSamp.gps.speed2D, binSamp.gpSamp.gps.speed2D);
+		CPPUNIT_ASSERT_EQUAL(origSamp.gpSamp.accl.x, binSamp.gpSamp.accl.x);
+	}
+
+	// modifying mapped telemetry shouldn't touch the file
+	CPPUNIT_ASSERT(srcFromBin->backupTelemetry());
+	srcFromBin->resampleTelemetry(srcFromBin->getTelemetryRate_hz() * 2);
+	CPPUNIT_ASSERT(srcFromBin->restoreTelemetry());
+	CPPUNIT_ASSERT_EQUAL(origColumns.size(), srcFromBin->telemSrc->size());
+	auto reloaded = gpo::DataSource::loadTelemetryFromBinary(binFile);
+	CPPUNIT_ASSERT(reloaded != nullptr);
+	CPPUNIT_ASSERT_EQUAL(origColumns.size(), reloaded->telemSrc->size());
+
+	// compact telemetry should stay compact on disk
+	srcFromCSV->setCompactTelemetry(true);
+	CPPUNIT_ASSERT(srcFromCSV->writeTelemetryToBinary(binFile));
+	auto compactFromBin = gpo::DataSource::loadTelemetryFromBinary(binFile);
+	CPPUNIT_ASSERT(compactFromBin != nullptr);
+	CPPUNIT_ASSERT(compactFromBin->isTelemetryCompact());
+	CPPUNIT_ASSERT_EQUAL(srcFromCSV->telemSrc->size_bytes(), compactFromBin->telemSrc->size_bytes());
+
+	// round trip through the converter
+	const std::filesystem::path csvFile = std::filesystem::path(test_data::TMP_ROOT) / "binary_telem.csv";
+	const std::filesystem::path binFile2 = std::filesystem::path(test_data::TMP_ROOT) / "binary_telem2.gpot";
+	CPPUNIT_ASSERT(utils::io::convertTelemetryFile(binFile, csvFile));
+	CPPUNIT_ASSERT(utils::io::convertTelemetryFile(csvFile, binFile2));
+	auto srcFromCSV2 = gpo::DataSource::loadTelemetryFromBinary(binFile2);
+	CPPUNIT_ASSERT(srcFromCSV2 != nullptr);
+	CPPUNIT_ASSERT_EQUAL(origColumns.size(), srcFromCSV2->telemSrc->size());
+	CPPUNIT_ASSERT_EQUAL(false, utils::io::convertTelemetryFile(csvFile, csvFile));
+}
+
+void
+DataSourceTest::testArchivedTelemetry()
+{
+	auto srcFromCSV = gpo::DataSource::loadDataFromSoloStormCSV(
+		test_data::solostorm::AUTOCROSS);
+	CPPUNIT_ASSERT(srcFromCSV != nullptr);
+	const std::filesystem::path binFile = std::filesystem::path(test_data::TMP_ROOT) / "archived_telem.gpot";
+	const std::filesystem::path archiveFile = std::filesystem::path(test_data::TMP_ROOT) / "archived_telem.gpoz";
+	CPPUNIT_ASSERT(srcFromCSV->writeTelemetryToBinary(binFile));
+	CPPUNIT_ASSERT(srcFromCSV->writeTelemetryToArchive(archiveFile));
+	CPPUNIT_ASSERT(std::filesystem::file_size(archiveFile) < std::filesystem::file_size(binFile));
+
+	// blocks should only be decompressed once they're read
+	auto srcFromArchive = gpo::DataSource::loadDataFromFile(archiveFile);
+	CPPUNIT_ASSERT(srcFromArchive != nullptr);
+	CPPUNIT_ASSERT((srcFromCSV->dataAvailable() == srcFromArchive->dataAvailable()));
+	const auto &archiveColumns = srcFromArchive->telemSrc->columns();
+	CPPUNIT_ASSERT(archiveColumns.unloadedChunkCount() > 0);
+
+	// decompressed values should be bit exact
+	CPPUNIT_ASSERT_EQUAL(srcFromCSV->telemSrc->size(), srcFromArchive->telemSrc->size());
+	for (size_t i=0; i<srcFromCSV->telemSrc->size(); i++)
+	{
+		const auto origSamp = srcFromCSV->telemSrc->at(i);
+		const auto archiveSamp = srcFromArchive->telemSrc->at(i);
+		CPPUNIT_ASSERT_EQUAL(origSamp.t_offset, archiveSamp.t_offset);
+		CPPUNIT_ASSERT_EQUAL(origSamp.gpSamp.gps.coord.lat, archiveSamp.gpSamp.gps.coord.lat);
+		CPPUNIT_ASSERT_EQUAL(origSamp.gpSamp.gps.coord.lon, archiveSamp.gpSamp.gps.coord.lon);
+		CPPUNIT_ASSERT_EQUAL(origSamp.gpSamp.gps.speed2D, archiveSamp.gpSamp.gps.speed2D);
+		CPPUNIT_ASSERT_EQUAL(origSamp.gpSamp.accl.x, archiveSamp.gpSamp.accl.x);
+	}
+	CPPUNIT_ASSERT_EQUAL((size_t)0, archiveColumns.unloadedChunkCount());
+
+	// compact telemetry can be archived too
+	srcFromCSV->setCompactTelemetry(true);
+	CPPUNIT_ASSERT(srcFromCSV->writeTelemetryToArchive(archiveFile));
+	auto compactFromArchive = gpo::DataSource::loadTelemetryFromBinary(archiveFile);
+	CPPUNIT_ASSERT(compactFromArchive != nullptr);
+	CPPUNIT_ASSERT(compactFromArchive->isTelemetryCompact());
+	CPPUNIT_ASSERT_EQUAL(srcFromCSV->telemSrc->size_bytes(), compactFromArchive->telemSrc->size_bytes());
+}
+
+void
+DataSourceTest::testPagedTelemetry()
+{
+	const double SAMP_RATE_HZ = 200.0;
+	const size_t N_CHUNKS = 8;
+	const size_t N_SAMPS = gpo::TELEM_CHUNK_SIZE * N_CHUNKS;
+	gpo::TelemetrySamples tSamps(N_SAMPS);
+	for (size_t i=0; i<N_SAMPS; i++)
+	{
+		auto &samp = tSamps.at(i);
+		std::memset(&samp, 0, sizeof(samp));
+		samp.t_offset = (1.0 / SAMP_RATE_HZ) * i;
+		samp.gpSamp.accl.x = i % 100;
+	}
+	const std::filesystem::path archiveFile = std::filesystem::path(test_data::TMP_ROOT) / "paged_telem.gpoz";
+	CPPUNIT_ASSERT(gpo::DataSource::makeDataFromTelemetry(tSamps)->writeTelemetryToArchive(archiveFile));
+
+	auto dSrc = gpo::DataSource::loadTelemetryFromBinary(archiveFile);
+	CPPUNIT_ASSERT(dSrc != nullptr);
+	CPPUNIT_ASSERT_EQUAL(gpo::DEFAULT_TELEMETRY_MEMORY_LIMIT, dSrc->getTelemetryMemoryLimit());
+	const auto &columns = dSrc->telemSrc->columns();
+	size_t chunkRowBytes = 0;
+	for (const auto &desc : gpo::getChannelDescriptors())
+	{
+		chunkRowBytes += gpo::getEncodedSize(desc, columns.getEncoding(desc.channel)) * gpo::TELEM_CHUNK_SIZE;
+	}
+
+	// resident memory should stay bounded as the seeker sweeps the recording
+	const size_t LIMIT = chunkRowBytes * 2;
+	dSrc->setTelemetryMemoryLimit(LIMIT);
+	CPPUNIT_ASSERT(columns.pagedResidentBytes() <= LIMIT);
+	for (size_t i=0; i<N_SAMPS; i+=gpo::TELEM_CHUNK_SIZE / 2)
+	{
+		dSrc->seeker->seekToIdx(i);
+		const auto samp = dSrc->telemSrc->at(i);
+		CPPUNIT_ASSERT_EQUAL(tSamps.at(i).t_offset, samp.t_offset);
+		CPPUNIT_ASSERT_EQUAL(tSamps.at(i).gpSamp.accl.x, samp.gpSamp.accl.x);
+		CPPUNIT_ASSERT(columns.pagedResidentBytes() <= LIMIT);
+	}
+	CPPUNIT_ASSERT(columns.unloadedChunkCount() > 0);
+
+	// evicted chunks should reload transparently
+	CPPUNIT_ASSERT_EQUAL(tSamps.at(0).t_offset, dSrc->telemSrc->at(0).t_offset);
+
+	// chunks that are being read can't be evicted out from under a reader
+	const auto tOffsets = columns.channel<double>(gpo::eTC_T_OFFSET);
+	CPPUNIT_ASSERT_EQUAL(tSamps.at(0).t_offset, tOffsets[0]);
+	auto pins = columns.pin(gpo::TELEM_CHUNK_SIZE, gpo::TELEM_CHUNK_SIZE + 1);
+	CPPUNIT_ASSERT( ! pins.empty());
+	dSrc->setTelemetryMemoryLimit(1);
+	CPPUNIT_ASSERT(columns.pagedResidentBytes() >= chunkRowBytes);
+	CPPUNIT_ASSERT_EQUAL(tSamps.at(1).t_offset, tOffsets[1]);
+	pins.clear();
+	dSrc->setTelemetryMemoryLimit(1);
+	CPPUNIT_ASSERT(columns.pagedResidentBytes() < chunkRowBytes);
+
+	// background streaming should load everything when unlimited
+	dSrc->setTelemetryMemoryLimit(0);
+	dSrc->streamTelemetryInBackground();
+	while (dSrc->isStreamingTelemetry())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	dSrc->stopStreamingTelemetry();
+	CPPUNIT_ASSERT_EQUAL((size_t)0, columns.unloadedChunkCount());
+	CPPUNIT_ASSERT_EQUAL(columns.size_bytes(), columns.pagedResidentBytes());
+}
+
+void
+DataSourceTest::testMissingBinaryChannel()
+{
+	const size_t PATH_LENGTH = 100;
+	std::vector<cv::Vec2d> path(PATH_LENGTH);
+	gpo::TelemetrySamples tSamps(PATH_LENGTH);
+	for (size_t i=0; i<PATH_LENGTH; i++)
+	{
+		path.at(i) = cv::Vec2d(i, 0);
+
+		auto &samp = tSamps.at(i);
+		std::memset(&samp, 0, sizeof(samp));
+		samp.t_offset = 0.010 * i;
+		samp.gpSamp.gps.coord.lat = i;
+		samp.gpSamp.gps.coord.lon = 0;
+	}
+	const std::filesystem::path binFile = std::filesystem::path(test_data::TMP_ROOT) / "missing_channel.gpot";
+	auto srcFromSamps = gpo::DataSource::makeDataFromTelemetry(tSamps);
+	CPPUNIT_ASSERT( ! srcFromSamps->isTelemetryCompact());
+	CPPUNIT_ASSERT(srcFromSamps->writeTelemetryToBinary(binFile));
+
+	// rename the lap and track distance channels' directory entries so the
+	// loader skips them, and mark the file as version 1 like one written
+	// before track distance existed
+	std::string fileBytes;
+	{
+		std::ifstream in(binFile, std::ios::binary);
+		fileBytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	for (const auto channel : {gpo::eTC_CALC_LAP, gpo::eTC_CALC_TRACK_DISTANCE})
+	{
+		const std::string name = std::string(gpo::getChannelDescriptor(channel).name) + '\0';
+		const size_t namePos = fileBytes.find(name);
+		CPPUNIT_ASSERT(namePos != std::string::npos);
+		fileBytes[namePos] = '~';
+	}
+	const uint32_t OLD_VERSION = 1;
+	std::memcpy(&fileBytes[8], &OLD_VERSION, sizeof(OLD_VERSION));
+	{
+		std::ofstream out(binFile, std::ios::binary | std::ios::trunc);
+		out.write(fileBytes.data(), fileBytes.size());
+	}
+
+	auto dSrc = gpo::DataSource::loadTelemetryFromBinary(binFile);
+	CPPUNIT_ASSERT(dSrc != nullptr);
+	CPPUNIT_ASSERT( ! dSrc->isTelemetryCompact());
+	const auto &columns = dSrc->telemSrc->columns();
+	CPPUNIT_ASSERT_EQUAL(gpo::eCE_ABSENT, columns.getEncoding(gpo::eTC_CALC_LAP));
+	CPPUNIT_ASSERT( ! dSrc->dataAvailable().test(gpo::eDA_CALC_TRACK_DISTANCE));
+	CPPUNIT_ASSERT_EQUAL(0, dSrc->telemSrc->at(50).calcSamp.lap);
+
+	// computing track times should give the missing channel storage rather
+	// than dropping the laps
+	auto track = std::make_shared<gpo::Track>(path);
+	track->setStart(5);
+	track->setFinish(95);
+	CPPUNIT_ASSERT(dSrc->setDatumTrack(track));
+	CPPUNIT_ASSERT_EQUAL(gpo::eCE_NATIVE, columns.getEncoding(gpo::eTC_CALC_LAP));
+	CPPUNIT_ASSERT_EQUAL(-1, dSrc->telemSrc->at(0).calcSamp.lap);
+	CPPUNIT_ASSERT_EQUAL(1, dSrc->telemSrc->at(50).calcSamp.lap);
+	CPPUNIT_ASSERT_EQUAL(1U, dSrc->seeker->lapCount());
+	CPPUNIT_ASSERT(dSrc->dataAvailable().test(gpo::eDA_CALC_TRACK_DISTANCE));
+	CPPUNIT_ASSERT_EQUAL(0.0, dSrc->telemSrc->at(0).calcSamp.trackDistance_m);
+	CPPUNIT_ASSERT(dSrc->telemSrc->at(50).calcSamp.trackDistance_m > dSrc->telemSrc->at(49).calcSamp.trackDistance_m);
+}
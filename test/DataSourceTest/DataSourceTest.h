@@ -11,6 +11,14 @@ class DataSourceTest : public CppUnit::TestFixture
 	CPPUNIT_TEST(testLoadFromMegaSquirtLog);
 	CPPUNIT_TEST(testLoadFromSoloStormCSV);
 	CPPUNIT_TEST(testTelemetryMerge);
+	CPPUNIT_TEST(testCache);
+	CPPUNIT_TEST(testTelemetryColumns);
+	CPPUNIT_TEST(testCompactTelemetry);
+	CPPUNIT_TEST(testCopyOnWriteTelemetry);
+	CPPUNIT_TEST(testBinaryTelemetry);
+	CPPUNIT_TEST(testArchivedTelemetry);
+	CPPUNIT_TEST(testPagedTelemetry);
+	CPPUNIT_TEST(testMissingBinaryChannel);
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -23,6 +31,14 @@ protected:
 	void testLoadFromMegaSquirtLog();
 	void testLoadFromSoloStormCSV();
 	void testTelemetryMerge();
+	void testCache();
+	void testTelemetryColumns();
+	void testCompactTelemetry();
+	void testCopyOnWriteTelemetry();
+	void testBinaryTelemetry();
+	void testArchivedTelemetry();
+	void testPagedTelemetry();
+	void testMissingBinaryChannel();
 
 private:
 
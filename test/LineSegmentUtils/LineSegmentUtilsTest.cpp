@@ -1,6 +1,8 @@
 #include "LineSegmentUtilsTest.h"
 
 #include "GoProOverlay/utils/LineSegmentUtils.h"
+#include <random>
+#include <vector>
 
 LineSegmentUtilsTest::LineSegmentUtilsTest()
 {
@@ -112,6 +114,67 @@ LineSegmentUtilsTest::tests()
 	}
 }
 
+void
+LineSegmentUtilsTest::findFirstIntersect()
+{
+	// random walk that wanders back and forth across a gate
+	const size_t N_POINTS = 1000;
+	std::vector<double> xs(N_POINTS);
+	std::vector<double> ys(N_POINTS);
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<double> step(-1.0, 1.0);
+	xs[0] = 0.0;
+	ys[0] = 0.0;
+	for (size_t i=1; i<N_POINTS; i++)
+	{
+		xs[i] = xs[i-1] + step(gen);
+		ys[i] = ys[i-1] + step(gen);
+	}
+	// make a few points land exactly on the gate
+	xs[100] = 1.0; ys[100] = 0.5;
+	xs[517] = 1.0; ys[517] = -0.5;
+
+	const cv::Vec2d gateA(1,-2);
+	const cv::Vec2d gateB(1,2);
+	auto bruteForce = [&](size_t begin, size_t end) -> size_t {
+		for (size_t i=begin; i<end; i++)
+		{
+			cv::Vec2d c1(xs[i-1],ys[i-1]);
+			cv::Vec2d c2(xs[i],ys[i]);
+			if (utils::doIntersect(gateA,gateB,c1,c2))
+			{
+				return i;
+			}
+		}
+		return end;
+	};
+
+	size_t nCrossings = 0;
+	size_t begin = 1;
+	while (begin < N_POINTS)
+	{
+		const size_t found = utils::findFirstIntersect(gateA,gateB,xs.data(),ys.data(),begin,N_POINTS);
+		CPPUNIT_ASSERT_EQUAL(bruteForce(begin,N_POINTS), found);
+		if (found < N_POINTS)
+		{
+			nCrossings++;
+		}
+		begin = found + 1;
+	}
+	CPPUNIT_ASSERT(nCrossings > 2);
+
+	// windows that don't line up with the blocks
+	for (size_t bb=90; bb<130; bb++)
+	{
+		for (size_t ee=bb; ee<bb+40; ee++)
+		{
+			const size_t found = utils::findFirstIntersect(gateA,gateB,xs.data(),ys.data(),bb,ee);
+			CPPUNIT_ASSERT_EQUAL(bruteForce(bb,ee), found);
+		}
+	}
+	CPPUNIT_ASSERT_EQUAL((size_t)100, utils::findFirstIntersect(gateA,gateB,xs.data(),ys.data(),100,101));
+}
+
 int main()
 {
 	CppUnit::TextUi::TestRunner runner;
@@ -8,6 +8,7 @@ class LineSegmentUtilsTest : public CppUnit::TestFixture
 {
 	CPPUNIT_TEST_SUITE(LineSegmentUtilsTest);
 	CPPUNIT_TEST(tests);
+	CPPUNIT_TEST(findFirstIntersect);
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -17,6 +18,7 @@ public:
 
 protected:
 	void tests();
+	void findFirstIntersect();
 
 private:
 
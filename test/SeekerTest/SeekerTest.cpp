@@ -1,6 +1,9 @@
 #include "SeekerTest.h"
 
+#include <cmath>
+
 #include "GoProOverlay/data/DataSource.h"
+#include "GoProOverlay/data/GroupedSeeker.h"
 #include "GoProOverlay/data/TelemetrySeeker.h"
 
 SeekerTest::SeekerTest()
@@ -155,6 +158,120 @@ SeekerTest::lapIndexLookup()
 	CPPUNIT_ASSERT_NO_THROW(entryExit = seeker->getLapEntryExit(3));
 	CPPUNIT_ASSERT_EQUAL(7UL, entryExit.first);
 	CPPUNIT_ASSERT_EQUAL(9UL, entryExit.second);
+
+	// ----------------------------------------------
+	// lap numbers with a gap only count the laps that were driven
+
+	tSamps.at(4).calcSamp.lap = -1;
+	tSamps.at(5).calcSamp.lap = -1;
+
+	dataSrc = gpo::DataSource::makeDataFromTelemetry(tSamps);
+	seeker = dataSrc->seeker;
+	seeker->analyze();
+
+	CPPUNIT_ASSERT_EQUAL(2U, seeker->lapCount());
+	CPPUNIT_ASSERT(seeker->hasLap(1));
+	CPPUNIT_ASSERT( ! seeker->hasLap(2));
+	CPPUNIT_ASSERT(seeker->hasLap(3));
+	CPPUNIT_ASSERT_THROW(seeker->getLapEntryExit(2), std::out_of_range);
+	CPPUNIT_ASSERT_NO_THROW(entryExit = seeker->getLapEntryExit(3));
+	CPPUNIT_ASSERT_EQUAL(7UL, entryExit.first);
+	CPPUNIT_ASSERT_EQUAL(9UL, entryExit.second);
+}
+
+void
+SeekerTest::sectorIndexLookup()
+{
+	const size_t PATH_LENGTH = 12;
+	auto makeSource = [&](const int *laps, const int *sectors){
+		gpo::TelemetrySamples tSamps;
+		tSamps.resize(PATH_LENGTH);
+		for (unsigned int i=0; i<PATH_LENGTH; i++)
+		{
+			auto &samp = tSamps.at(i);
+			samp.t_offset = 0.010 * i;
+			samp.calcSamp.lap = laps[i];
+			samp.calcSamp.sector = sectors[i];
+		}
+		auto dataSrc = gpo::DataSource::makeDataFromTelemetry(tSamps);
+		dataSrc->seeker->analyze();
+		return dataSrc;
+	};
+
+	// two laps with two sectors each. the last sector runs past the end
+	// of lap 2, but it's still counted as lap 2's since it started there.
+	const int LAPS_A[PATH_LENGTH]    = {-1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2,-1};
+	const int SECTORS_A[PATH_LENGTH] = {-1,-1, 1, 1,-1, 2,-1, 1,-1,-1, 2, 2};
+	auto srcA = makeSource(LAPS_A, SECTORS_A);
+	auto seekerA = srcA->seeker;
+
+	CPPUNIT_ASSERT_EQUAL(2U, seekerA->lapCount());
+	CPPUNIT_ASSERT_EQUAL(2U, seekerA->sectorCount());
+
+	std::pair<size_t,size_t> entryExit;
+	CPPUNIT_ASSERT_NO_THROW(entryExit = seekerA->getSectorEntryExit(1,1));
+	CPPUNIT_ASSERT_EQUAL(2UL, entryExit.first);
+	CPPUNIT_ASSERT_EQUAL(3UL, entryExit.second);
+	CPPUNIT_ASSERT_NO_THROW(entryExit = seekerA->getSectorEntryExit(1,2));
+	CPPUNIT_ASSERT_EQUAL(5UL, entryExit.first);
+	CPPUNIT_ASSERT_EQUAL(5UL, entryExit.second);
+	CPPUNIT_ASSERT_NO_THROW(entryExit = seekerA->getSectorEntryExit(2,1));
+	CPPUNIT_ASSERT_EQUAL(7UL, entryExit.first);
+	CPPUNIT_ASSERT_EQUAL(7UL, entryExit.second);
+	CPPUNIT_ASSERT_NO_THROW(entryExit = seekerA->getSectorEntryExit(2,2));
+	CPPUNIT_ASSERT_EQUAL(10UL, entryExit.first);
+	CPPUNIT_ASSERT_EQUAL(11UL, entryExit.second);
+
+	// sector tables shouldn't disturb the lap's
+	CPPUNIT_ASSERT_NO_THROW(entryExit = seekerA->getLapEntryExit(2));
+	CPPUNIT_ASSERT_EQUAL(6UL, entryExit.first);
+	CPPUNIT_ASSERT_EQUAL(10UL, entryExit.second);
+
+	// lookups outside the table
+	CPPUNIT_ASSERT( ! seekerA->hasSector(0,1));
+	CPPUNIT_ASSERT( ! seekerA->hasSector(1,0));
+	CPPUNIT_ASSERT( ! seekerA->hasSector(1,3));
+	CPPUNIT_ASSERT( ! seekerA->hasSector(3,1));
+	CPPUNIT_ASSERT_THROW(seekerA->getSectorEntryExit(3,1), std::out_of_range);
+	CPPUNIT_ASSERT_THROW(seekerA->seekToSectorEntry(1,3), std::out_of_range);
+
+	seekerA->seekToSectorEntry(2,2);
+	CPPUNIT_ASSERT_EQUAL(10UL, seekerA->seekedIdx());
+	seekerA->seekToSectorExit(1,1);
+	CPPUNIT_ASSERT_EQUAL(3UL, seekerA->seekedIdx());
+
+	// ----------------------------------------------
+	// a second run that missed lap 2's first sector
+
+	const int LAPS_B[PATH_LENGTH]    = { 1, 1, 1, 1, 2, 2, 2, 2, 2, 2,-1,-1};
+	const int SECTORS_B[PATH_LENGTH] = {-1, 1, 1, 2,-1,-1,-1, 2, 2,-1,-1,-1};
+	auto srcB = makeSource(LAPS_B, SECTORS_B);
+	auto seekerB = srcB->seeker;
+	CPPUNIT_ASSERT( ! seekerB->hasSector(2,1));
+	CPPUNIT_ASSERT(seekerB->hasSector(2,2));
+
+	gpo::GroupedSeeker gSeeker;
+	gSeeker.addSeeker(seekerA);
+	gSeeker.addSeeker(seekerB);
+
+	// nobody moves if anyone is missing the sector
+	seekerA->seekToIdx(0);
+	seekerB->seekToIdx(0);
+	CPPUNIT_ASSERT( ! gSeeker.seekAllToSectorEntry(2,1));
+	CPPUNIT_ASSERT_EQUAL(0UL, seekerA->seekedIdx());
+	CPPUNIT_ASSERT_EQUAL(0UL, seekerB->seekedIdx());
+
+	CPPUNIT_ASSERT(gSeeker.seekAllToSectorExit(1,2));
+	CPPUNIT_ASSERT_EQUAL(5UL, seekerA->seekedIdx());
+	CPPUNIT_ASSERT_EQUAL(3UL, seekerB->seekedIdx());
+
+	gpo::RenderAlignmentInfo rai;
+	rai.type = gpo::RenderAlignmentType_E::eRAT_None;
+	rai.initFrom(gpo::SectorAlignment{2, 2, gpo::ElementSide_E::eES_Entry});
+	gSeeker.seekToAlignmentInfo(rai);
+	CPPUNIT_ASSERT_EQUAL(10UL, seekerA->seekedIdx());
+	CPPUNIT_ASSERT_EQUAL(7UL, seekerB->seekedIdx());
+	rai.release();
 }
 
 void
@@ -203,9 +320,161 @@ SeekerTest::seekRelativeTime()
 	CPPUNIT_ASSERT_EQUAL(0UL, seeker->seekedIdx());
 }
 
+void
+SeekerTest::seekStates()
+{
+	auto makeSource = [](size_t nSamps){
+		gpo::TelemetrySamples tSamps(nSamps);
+		for (size_t i=0; i<nSamps; i++)
+		{
+			tSamps.at(i).t_offset = 0.010 * i;
+		}
+		return gpo::DataSource::makeDataFromTelemetry(tSamps);
+	};
+	auto srcA = makeSource(20);
+	auto srcB = makeSource(15);
+
+	gpo::GroupedSeeker gSeeker;
+	gSeeker.addSeeker(srcA->seeker);
+	gSeeker.addSeeker(srcB->seeker);
+	srcA->seeker->seekToIdx(2);
+	srcB->seeker->seekToIdx(5);
+
+	// states should land where stepping the seekers would, without moving them
+	const auto start = gSeeker.currentState();
+	for (size_t frame=0; frame<15; frame++)
+	{
+		const auto state = gSeeker.stateAt(start, frame);
+		CPPUNIT_ASSERT_EQUAL(2UL, srcA->seeker->seekedIdx());
+		CPPUNIT_ASSERT_EQUAL(5UL, srcB->seeker->seekedIdx());
+
+		// 'b' runs out of samples after 9 frames, at which point everyone stops
+		const size_t expectedFrame = std::min(frame, (size_t)9);
+		CPPUNIT_ASSERT_EQUAL(2 + expectedFrame, state.seekedIdx(srcA->seeker.get()));
+		CPPUNIT_ASSERT_EQUAL(5 + expectedFrame, state.seekedIdx(srcB->seeker.get()));
+	}
+
+	// matches the seekers after nextAll() too
+	const auto state = gSeeker.stateAt(start, 4);
+	for (size_t i=0; i<4; i++)
+	{
+		gSeeker.nextAll();
+	}
+	CPPUNIT_ASSERT_EQUAL(srcA->seeker->seekedIdx(), state.seekedIdx(srcA->seeker.get()));
+	CPPUNIT_ASSERT_EQUAL(srcB->seeker->seekedIdx(), state.seekedIdx(srcB->seeker.get()));
+
+	// an empty state defers to the seekers
+	const gpo::SeekState live;
+	CPPUNIT_ASSERT_EQUAL(6UL, live.seekedIdx(srcA->seeker.get()));
+
+	// a timeline keeps stepping the group the way it was when it was taken
+	const auto timeline = gSeeker.timeline();
+	const auto timelineStart = gSeeker.currentState();
+	gSeeker.removeSeeker(1);
+	const auto snapState = timeline.stateAt(timelineStart, 20);
+	CPPUNIT_ASSERT_EQUAL(11UL, snapState.seekedIdx(srcA->seeker.get()));
+	CPPUNIT_ASSERT_EQUAL(14UL, snapState.seekedIdx(srcB->seeker.get()));
+	CPPUNIT_ASSERT_EQUAL(19UL, gSeeker.stateAt(gSeeker.currentState(), 20).seekedIdx(srcA->seeker.get()));
+
+	// states that aren't empty never fall back on the live seekers
+	CPPUNIT_ASSERT_THROW(gSeeker.currentState().seekedIdx(srcB->seeker.get()), std::out_of_range);
+}
+
 int main()
 {
 	CppUnit::TextUi::TestRunner runner;
 	runner.addTest(SeekerTest::suite());
 	return runner.run() ? 0 : EXIT_FAILURE;
 }
+
+void
+SeekerTest::masterClock()
+{
+	auto makeSource = [](size_t nSamps, double rate_hz){
+		gpo::TelemetrySamples tSamps(nSamps);
+		for (size_t i=0; i<nSamps; i++)
+		{
+			tSamps.at(i).t_offset = i / rate_hz;
+		}
+		return gpo::DataSource::makeDataFromTelemetry(tSamps);
+	};
+	// both span 0.6s, but at very different rates
+	auto fast = makeSource(60, 100.0);
+	auto slow = makeSource(7, 10.0);
+
+	gpo::GroupedSeeker gSeeker;
+	gSeeker.addSeeker(fast->seeker);
+	gSeeker.addSeeker(slow->seeker);
+	gSeeker.setMasterClock(50.0);
+	CPPUNIT_ASSERT_EQUAL(50.0, gSeeker.masterClockRate());
+	CPPUNIT_ASSERT_EQUAL(50.0, slow->seeker->clockRate());
+	CPPUNIT_ASSERT_EQUAL(30UL, fast->seeker->clockTickCount());
+	CPPUNIT_ASSERT_EQUAL(31UL, slow->seeker->clockTickCount());
+
+	// both start 0.1s in
+	fast->seeker->seekToIdx(10);
+	slow->seeker->seekToIdx(1);
+
+	// each frame is 20ms. the fast source skips samples while the slow one
+	// holds each of its samples for several frames.
+	const auto start = gSeeker.currentState();
+	for (size_t frame=0; frame<30; frame++)
+	{
+		const auto state = gSeeker.stateAt(start, frame);
+
+		// the fast source runs out of ticks after 24 frames
+		const size_t expectedFrame = std::min(frame, (size_t)24);
+		const double t = 0.1 + expectedFrame * 0.02;
+		CPPUNIT_ASSERT_EQUAL(10 + expectedFrame * 2, state.seekedIdx(fast->seeker.get()));
+		CPPUNIT_ASSERT_EQUAL((size_t)std::lround(t * 10.0), state.seekedIdx(slow->seeker.get()));
+	}
+
+	// stepping live should follow the same schedule, and stepping back
+	// shouldn't let the slow source drift off the clock
+	for (size_t frame=1; frame<=3; frame++)
+	{
+		gSeeker.nextAll();
+		const auto expected = gSeeker.stateAt(start, frame);
+		CPPUNIT_ASSERT_EQUAL(expected.seekedIdx(fast->seeker.get()), fast->seeker->seekedIdx());
+		CPPUNIT_ASSERT_EQUAL(expected.seekedIdx(slow->seeker.get()), slow->seeker->seekedIdx());
+	}
+	CPPUNIT_ASSERT_EQUAL(16UL, fast->seeker->seekedIdx());
+	CPPUNIT_ASSERT_EQUAL(2UL, slow->seeker->seekedIdx());
+	for (size_t i=0; i<5; i++)
+	{
+		gSeeker.prevAll();
+	}
+	CPPUNIT_ASSERT_EQUAL(6UL, fast->seeker->seekedIdx());
+	CPPUNIT_ASSERT_EQUAL(1UL, slow->seeker->seekedIdx());
+	gSeeker.seekAllRelative(2, true);
+	CPPUNIT_ASSERT_EQUAL(10UL, fast->seeker->seekedIdx());
+	CPPUNIT_ASSERT_EQUAL(1UL, slow->seeker->seekedIdx());
+
+	// limits count ticks, and relative time seeks move by the clock
+	const auto limits = gSeeker.relativeSeekLimits();
+	CPPUNIT_ASSERT_EQUAL(5UL, limits.first);
+	CPPUNIT_ASSERT_EQUAL(24UL, limits.second);
+	gSeeker.seekAllRelativeTime(0.2);
+	CPPUNIT_ASSERT_EQUAL(30UL, fast->seeker->seekedIdx());
+	CPPUNIT_ASSERT_EQUAL(3UL, slow->seeker->seekedIdx());
+
+	// without a clock, everyone steps one sample at a time again
+	gSeeker.setMasterClock(0.0);
+	CPPUNIT_ASSERT_EQUAL(0UL, slow->seeker->clockTickCount());
+	gSeeker.nextAll();
+	CPPUNIT_ASSERT_EQUAL(31UL, fast->seeker->seekedIdx());
+	CPPUNIT_ASSERT_EQUAL(4UL, slow->seeker->seekedIdx());
+
+	// a timeline can step by its own clock without starting the group's
+	fast->seeker->seekToIdx(10);
+	slow->seeker->seekToIdx(1);
+	const auto timeline = gSeeker.timeline(50.0);
+	CPPUNIT_ASSERT_EQUAL(0.0, gSeeker.masterClockRate());
+	CPPUNIT_ASSERT_EQUAL(0UL, slow->seeker->clockTickCount());
+	const auto timelineStart = timeline.stateOf(gSeeker.currentState());
+	const auto timelineState = timeline.stateAt(timelineStart, 7);
+	CPPUNIT_ASSERT_EQUAL(24UL, timelineState.seekedIdx(fast->seeker.get()));
+	CPPUNIT_ASSERT_EQUAL(2UL, timelineState.seekedIdx(slow->seeker.get()));
+	CPPUNIT_ASSERT_EQUAL(10UL, fast->seeker->seekedIdx());
+	CPPUNIT_ASSERT_EQUAL(1UL, slow->seeker->seekedIdx());
+}
@@ -8,7 +8,10 @@ class SeekerTest : public CppUnit::TestFixture
 {
 	CPPUNIT_TEST_SUITE(SeekerTest);
 	CPPUNIT_TEST(lapIndexLookup);
+	CPPUNIT_TEST(sectorIndexLookup);
 	CPPUNIT_TEST(seekRelativeTime);
+	CPPUNIT_TEST(seekStates);
+	CPPUNIT_TEST(masterClock);
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -18,7 +21,10 @@ public:
 
 protected:
 	void lapIndexLookup();
+	void sectorIndexLookup();
 	void seekRelativeTime();
+	void seekStates();
+	void masterClock();
 
 private:
 
@@ -2,6 +2,8 @@
 
 #include "GoProOverlay/data/TrackDataObjects.h"
 
+#include <random>
+
 TrackDataObjectsTest::TrackDataObjectsTest()
 {
 }
@@ -254,6 +256,79 @@ TrackDataObjectsTest::sortedPathObjects()
 	CPPUNIT_ASSERT_EQUAL(gpo::GateType_E::eGT_Finish, pathObjs.at(4)->getGateType());
 }
 
+void
+TrackDataObjectsTest::spatialIndex()
+{
+	// a couple laps around a noisy loop, so windows of the path overlap spatially
+	const size_t PATH_LENGTH = 5000;
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<double> noise(-0.05, 0.05);
+	std::vector<cv::Vec2d> path;
+	for (size_t i=0; i<PATH_LENGTH; i++)
+	{
+		const double theta = i * 0.003;
+		path.push_back(cv::Vec2d(
+			std::cos(theta) + noise(gen),
+			std::sin(theta) + noise(gen)));
+	}
+	gpo::Track track(path);
+
+	// brute force search the same way findClosestPointWithIdx() used to
+	auto linearSearch = [&path](
+		const cv::Vec2d &p,
+		size_t startIdx,
+		size_t endIdx)
+	{
+		double closestDistSqr = -1;
+		size_t closestIdx = startIdx;
+		for (size_t i=startIdx; i<endIdx && i<path.size(); i++)
+		{
+			const double dx = path[i][0] - p[0];
+			const double dy = path[i][1] - p[1];
+			const double distSqr = (dx*dx) + (dy*dy);
+			if (closestDistSqr < 0 || distSqr < closestDistSqr)
+			{
+				closestDistSqr = distSqr;
+				closestIdx = i;
+			}
+		}
+		return closestIdx;
+	};
+
+	std::uniform_real_distribution<double> coord(-1.5, 1.5);
+	std::uniform_int_distribution<size_t> pathIdx(0, PATH_LENGTH - 1);
+	for (size_t q=0; q<1000; q++)
+	{
+		const cv::Vec2d p(coord(gen), coord(gen));
+
+		// whole path
+		auto findRes = track.findClosestPointWithIdx(p);
+		CPPUNIT_ASSERT_EQUAL(true, std::get<0>(findRes));
+		CPPUNIT_ASSERT_EQUAL(linearSearch(p, 0, PATH_LENGTH), std::get<2>(findRes));
+
+		// windows both smaller and larger than the linear scan threshold
+		const size_t initialIdx = pathIdx(gen);
+		const std::pair<size_t,size_t> window = {q % 700, (q * 7) % 1500};
+		const size_t startIdx = (window.first > initialIdx ? 0 : initialIdx - window.first);
+		findRes = track.findClosestPointWithIdx(p, initialIdx, window);
+		CPPUNIT_ASSERT_EQUAL(
+			linearSearch(p, startIdx, initialIdx + window.second),
+			std::get<2>(findRes));
+	}
+
+	// the index must follow the path when it's reloaded
+	std::vector<cv::Vec2d> shortPath;
+	shortPath.push_back(cv::Vec2d(10, 10));
+	shortPath.push_back(cv::Vec2d(20, 20));
+	gpo::Track shortTrack(shortPath);
+	CPPUNIT_ASSERT_EQUAL(true, track.decode(shortTrack.encode()));
+	CPPUNIT_ASSERT_EQUAL(2UL, track.pathCount());
+	auto findRes = track.findClosestPointWithIdx({0.0,0.0});
+	CPPUNIT_ASSERT_EQUAL(true, std::get<0>(findRes));
+	CPPUNIT_ASSERT_EQUAL(0UL, std::get<2>(findRes));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, std::get<1>(findRes)[0], 0.000001);
+}
+
 int main()
 {
 	CppUnit::TextUi::TestRunner runner;
@@ -10,6 +10,7 @@ class TrackDataObjectsTest : public CppUnit::TestFixture
 	CPPUNIT_TEST(closestPoint);
 	CPPUNIT_TEST(detectionGate);
 	CPPUNIT_TEST(sortedPathObjects);
+	CPPUNIT_TEST(spatialIndex);
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -21,6 +22,7 @@ protected:
 	void closestPoint();
 	void detectionGate();
 	void sortedPathObjects();
+	void spatialIndex();
 
 private:
 
@@ -0,0 +1,131 @@
+#include "VehicleAccelBenchmark.h"
+
+#include "GoProOverlay/data/DataSource.h"
+#include "GoProOverlay/utils/DataProcessingUtils.h"
+#include "GoProOverlay/utils/TickTockUtils.h"
+
+#include <cmath>
+#include "test_data.h"
+
+// number of times each implementation is run for timing
+static constexpr size_t N_ITERATIONS = 10;
+// GoPro accelerometers are sampled at ~200Hz
+static constexpr double BENCH_RATE_HZ = 200.0;
+static constexpr size_t SMOOTHING_WINDOW = 30;
+
+// the AoS implementation that DataSource::calcVehicleAcceleration() used
+// before the fused kernel. kept here as the reference.
+static
+void
+referenceVehicleAcceleration(
+	gpo::TelemetryColumns &columns,
+	gpo::DataAvailableBitSet &avail)
+{
+	auto samples = std::make_shared<gpo::TelemetrySamples>();
+	columns.toSamples(*samples);
+
+	const std::array<size_t, 3> inFieldOffsets = {
+		offsetof(gpo::TelemetrySample, gpSamp.accl.x),
+		offsetof(gpo::TelemetrySample, gpSamp.accl.y),
+		offsetof(gpo::TelemetrySample, gpSamp.accl.z)
+	};
+	const std::array<size_t, 3> outFieldOffsets = {
+		offsetof(gpo::TelemetrySample, calcSamp.smoothAccl.x),
+		offsetof(gpo::TelemetrySample, calcSamp.smoothAccl.y),
+		offsetof(gpo::TelemetrySample, calcSamp.smoothAccl.z)
+	};
+	utils::smoothMovingAvgStructured<gpo::TelemetrySample,float>(
+		samples->data(),
+		samples->data(),
+		inFieldOffsets,
+		outFieldOffsets,
+		samples->size(),
+		SMOOTHING_WINDOW);
+	avail.set(gpo::DataAvailable::eDA_CALC_SMOOTH_ACCL);
+
+	cv::Vec3f latDir = {};
+	cv::Vec3f lonDir = {};
+	utils::computeVehicleDirectionVectors(samples,avail,latDir,lonDir);
+	utils::computeVehicleAcceleration(samples,avail,latDir,lonDir);
+
+	columns.setDataAvailable(avail);
+	columns.assign(*samples);
+}
+
+VehicleAccelBenchmark::VehicleAccelBenchmark()
+{
+}
+
+void
+VehicleAccelBenchmark::setUp()
+{
+	// run before each test case
+}
+
+void
+VehicleAccelBenchmark::tearDown()
+{
+	// run after each test case
+}
+
+void
+VehicleAccelBenchmark::fusedVsReference()
+{
+	auto dataSrc = gpo::DataSource::loadDataFromSoloStormCSV(
+		test_data::solostorm::AUTOCROSS);
+	CPPUNIT_ASSERT(dataSrc);
+	dataSrc->resampleTelemetry(BENCH_RATE_HZ);
+	const auto &srcColumns = dataSrc->telemSrc->columns();
+	const auto &srcAvail = dataSrc->dataAvailable();
+	printf("benchmarking over %zu samples\n", srcColumns.size());
+
+	gpo::TelemetryColumns refColumns;
+	gpo::DataAvailableBitSet refAvail;
+	TICK();
+	for (size_t i=0; i<N_ITERATIONS; i++)
+	{
+		refColumns = srcColumns;
+		refAvail = srcAvail;
+		referenceVehicleAcceleration(refColumns, refAvail);
+	}
+	TOCK_AND_PRINT("reference (AoS)");
+
+	gpo::TelemetryColumns fusedColumns;
+	gpo::DataAvailableBitSet fusedAvail;
+	for (size_t i=0; i<N_ITERATIONS; i++)
+	{
+		fusedColumns = srcColumns;
+		fusedAvail = srcAvail;
+		cv::Vec3f latDir = {};
+		cv::Vec3f lonDir = {};
+		CPPUNIT_ASSERT(utils::computeVehicleDirectionVectors(fusedColumns,fusedAvail,latDir,lonDir));
+		CPPUNIT_ASSERT(utils::computeVehicleAcceleration(fusedColumns,fusedAvail,latDir,lonDir,SMOOTHING_WINDOW));
+	}
+	TOCK_AND_PRINT("fused (columns)");
+
+	CPPUNIT_ASSERT(refAvail == fusedAvail);
+	const gpo::TelemetryChannel_E OUT_CHANNELS[] = {
+		gpo::eTC_CALC_SMOOTH_ACCL_X,
+		gpo::eTC_CALC_SMOOTH_ACCL_Y,
+		gpo::eTC_CALC_SMOOTH_ACCL_Z,
+		gpo::eTC_CALC_VEHI_ACCL_LAT,
+		gpo::eTC_CALC_VEHI_ACCL_LON
+	};
+	for (const auto ch : OUT_CHANNELS)
+	{
+		const auto refValues = refColumns.channel<float>(ch);
+		const auto fusedValues = fusedColumns.channel<float>(ch);
+		for (size_t i=0; i<srcColumns.size(); i++)
+		{
+			// reference keeps its running sum in float, so allow for drift
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(refValues[i], fusedValues[i], 0.001);
+		}
+	}
+}
+
+int main()
+{
+	CppUnit::TextUi::TestRunner runner;
+	runner.addTest(VehicleAccelBenchmark::suite());
+	return runner.run() ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cppunit/ui/text/TestRunner.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class VehicleAccelBenchmark : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(VehicleAccelBenchmark);
+	CPPUNIT_TEST(fusedVsReference);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	VehicleAccelBenchmark();
+	void setUp();
+	void tearDown();
+
+protected:
+	void fusedVsReference();
+
+private:
+
+};